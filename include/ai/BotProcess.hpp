@@ -1,13 +1,43 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace amazons {
 
+// A bot program on the other end of a pair of pipes.
+//
+// Writing to a bot that has exited raises SIGPIPE, which kills the process by
+// default. BotProcess leaves the disposition to the program: the tools that
+// run bots ignore SIGPIPE once in main(), and writes to a dead bot then fail
+// with EPIPE and report false.
 class BotProcess {
 public:
+    // Caps applied when the bot starts; zero means no cap. Enforced on Linux only.
+    struct Limits {
+        double cpuSeconds = 0.0;        // total CPU time; the bot is killed beyond it
+        size_t memoryBytes = 0;         // address space
+    };
+    
+    // CPU time and peak resident memory of the bot process
+    struct Usage {
+        double userSeconds = 0.0;
+        double systemSeconds = 0.0;
+        size_t peakRssBytes = 0;
+    };
+    
+    // What one reply cost: wall time from our send to the bot's line, and the
+    // CPU the bot itself burned in between. Wall time far above CPU time means
+    // the delay is in the pipes or the harness, not in the bot's search.
+    struct MoveStats {
+        double wallSeconds = 0.0;
+        double userSeconds = 0.0;
+        double systemSeconds = 0.0;
+        size_t peakRssBytes = 0;
+    };
+    
     // Constructor
     BotProcess(const std::string& botPath);
     
@@ -23,24 +53,46 @@ public:
     // Check if process is running
     bool isRunning() const;
     
-    // Send first turn input with move history
+    // Send first turn input: the 2n - 1 request/response lines of the first n turns
     bool sendFirstTurn(const std::vector<std::string>& moveHistory);
     
     // Send subsequent turn input (opponent's last move)
     bool sendTurn(const std::string& opponentMove);
     
+    // Send raw input text, e.g. a JSON request; starts the clock for the next reply
+    bool sendInput(const std::string& input);
+    
     // Read move output with timeout
     std::string readMove(double timeoutSeconds = 5.0);
     
     // Read keep-running signal
     std::string readKeepRunning(double timeoutSeconds = 0.5);
     
+    // Non-blocking read for event loops: true if a whole line was available
+    bool readAvailableLine(std::string& line);
+    
+    // True once the bot closed its output and every buffered line was read
+    bool outputEnded() const;
+    
+    // Descriptor to watch for readable output; -1 when not running or not POSIX
+    int outputHandle() const;
+    
     // Get the bot path
     std::string getBotPath() const;
     
     // Check if in keep-running mode
     bool isKeepRunning() const;
     
+    // Limits for the next start()
+    void setLimits(const Limits& limits);
+    const Limits& getLimits() const;
+    
+    // Usage so far: live from /proc on Linux, final figures once the bot has exited
+    Usage getUsage() const;
+    
+    // Cost of the last line returned by readMove()
+    const MoveStats& getLastMoveStats() const;
+    
 private:
     // Read a line with timeout
     std::string readLine(double timeoutSeconds);
@@ -55,6 +107,9 @@ private:
     
     // Keep-running mode flag
     bool keepRunningMode;
+    
+    Limits limits;
+    MoveStats lastMoveStats;
 };
 
 } // namespace amazons
\ No newline at end of file
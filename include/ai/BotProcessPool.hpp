@@ -0,0 +1,51 @@
+#pragma once
+
+#include "ai/BotProcess.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace amazons {
+
+// Keeps a few bot processes started and idle so that a new game does not pay
+// the bot's startup cost (tables, networks) inside a timed turn. A background
+// thread tops the pool back up after every acquire(). Processes are used for
+// one game only: the caller destroys it afterwards, or as soon as it crashes
+// or times out, and a fresh one takes its place.
+class BotProcessPool {
+public:
+    explicit BotProcessPool(const std::string& botPath, size_t idleTarget = 2);
+    ~BotProcessPool();
+
+    BotProcessPool(const BotProcessPool&) = delete;
+    BotProcessPool& operator=(const BotProcessPool&) = delete;
+
+    // Hands out an idle process, skipping any that died while waiting. Starts
+    // one on the spot when none is ready. Throws if no process can be started.
+    std::unique_ptr<BotProcess> acquire();
+
+    const std::string& getBotPath() const { return botPath; }
+    size_t idleCount() const;
+    uint64_t processesStarted() const;
+    uint64_t processesDiscarded() const;
+
+private:
+    void replenishLoop();
+    std::unique_ptr<BotProcess> startProcess();
+
+    std::string botPath;
+    size_t idleTarget;
+    std::deque<std::unique_ptr<BotProcess>> idle;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    uint64_t started = 0;
+    uint64_t discarded = 0;
+    std::thread replenisher;
+};
+
+} // namespace amazons
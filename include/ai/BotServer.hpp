@@ -0,0 +1,60 @@
+#pragma once
+
+#include "ai/BotProcess.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Round-robin tournament between external Botzone-protocol bots, driven from a
+// single thread. Every bot process of every running game is watched by one
+// epoll set (poll where epoll is missing) and every turn deadline sits in one
+// timer wheel, so hundreds of bots cost no threads and nothing ever blocks on
+// a single bot. Bots that stay alive between turns (keep-running) get only the
+// opponent's move; others are restarted with the full history each turn.
+class BotServer {
+public:
+    struct Options {
+        std::vector<std::string> bots;      // executables
+        int gamesPerPair = 2;               // colours alternate between games
+        size_t maxConcurrentGames = 64;
+        double turnSeconds = 3.0;           // wall clock per move
+        double startupSeconds = 1.0;        // extra on the first turn of each process
+        BotProcess::Limits limits;
+        std::string resultsPath;            // CSV, one line per finished game; empty = none
+    };
+
+    enum class EndReason {
+        NO_MOVES,       // the loser had no legal move
+        ILLEGAL_MOVE,   // the loser sent an illegal or unreadable move
+        TIMEOUT,        // the loser missed its deadline
+        CRASH           // the loser exited or could not be started
+    };
+
+    struct GameResult {
+        int black = 0;                      // indices into Options::bots
+        int white = 0;
+        int winner = 0;
+        EndReason reason = EndReason::NO_MOVES;
+        int plies = 0;
+        double seconds = 0.0;
+        double blackCpuSeconds = 0.0;
+        double whiteCpuSeconds = 0.0;
+        std::string moves;                  // Botzone move lines separated by ';'
+    };
+
+    struct Result {
+        std::vector<GameResult> games;      // in the order they finished
+        std::vector<int> wins;              // per bot
+        std::vector<int> played;            // per bot
+        double elapsedSeconds = 0.0;
+    };
+
+    // Progress is called on the server thread after every finished game
+    static Result run(const Options& options, const std::function<void(const GameResult&)>& progress = {});
+
+    static const char* reasonName(EndReason reason);
+};
+
+} // namespace amazons
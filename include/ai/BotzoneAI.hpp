@@ -1,5 +1,6 @@
 #pragma once
 
+#include "ai/BotProcess.hpp"
 #include "core/GameState.hpp"
 #include "core/Move.hpp"
 #include <string>
@@ -8,13 +9,16 @@
 
 namespace amazons {
 
-class BotProcess; // Forward declaration
+class BotProcessPool; // Forward declaration
 
 class BotzoneAI {
 public:
     // Constructor with optional bot path
     BotzoneAI(const std::string& botPath = "");
     
+    // Constructor taking games' bot processes from a pre-started pool
+    explicit BotzoneAI(std::shared_ptr<BotProcessPool> pool);
+    
     // Destructor
     ~BotzoneAI();
     
@@ -27,6 +31,9 @@ public:
     // Get the bot executable path
     std::string getBotPath() const;
     
+    // Use processes from a pool instead of starting one per game; nullptr to stop
+    void setProcessPool(std::shared_ptr<BotProcessPool> pool);
+    
     // Set the AI color (needed for Botzone protocol)
     void setAIColor(Player color);
     
@@ -36,14 +43,20 @@ public:
     // Check if bot is available
     bool isBotAvailable() const;
     
+    // Wall and CPU time of the bot's last reply
+    BotProcess::MoveStats getLastMoveStats() const;
+    
 private:
-    // Convert game state to Botzone protocol input
+    // True if history is the game the running bot has seen plus one opponent move
+    bool extendsBotHistory(const std::vector<Move>& history) const;
+    
+    // Full simple-protocol input replaying the game for a freshly started bot
     std::string convertGameStateToBotzoneInput(const GameState& gameState) const;
     
     // Convert Botzone protocol output to Move
     Move convertBotzoneOutputToMove(const std::string& output) const;
     
-    // Get move history from game state
+    // The game's moves in Botzone notation
     std::vector<std::string> getMoveHistory(const GameState& gameState) const;
     
     // Bot executable path
@@ -52,11 +65,14 @@ private:
     // Bot process manager
     std::unique_ptr<BotProcess> botProcess;
     
+    // Source of ready processes, if any
+    std::shared_ptr<BotProcessPool> processPool;
+    
     // Flag to track if we're in keep-running mode
     bool keepRunningMode;
     
-    // Move history for Botzone protocol
-    std::vector<std::string> moveHistory;
+    // Moves the running bot has seen, its own replies included
+    std::vector<Move> botHistory;
     
     // AI color (needed for Botzone protocol)
     Player aiColor;
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "ai/MctsAI.hpp"
+#include "core/GameState.hpp"
+#include "core/Move.hpp"
+#include "utils/OpeningBook.hpp"
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace amazons {
+
+// Our own engine behind the Botzone protocols, for the amazons_bot executable.
+// The first turn brings the whole history (see BotzoneProtocol), after which we
+// answer with one move and, in keep-running mode, the KEEP_RUNNING marker.
+// Every later turn is a single request holding the opponent's move, so the
+// process, its game state and its search tree live for the whole game. Simple
+// and JSON input are told apart line by line and answered in kind.
+class BotzoneBot {
+public:
+    struct Options {
+        double turnSeconds = 3.0;           // wall-clock budget per turn, from reading the request
+        double safetyMarginSeconds = 0.2;   // kept back for process and I/O overhead
+        bool keepRunning = true;            // false: answer one turn and return, as Botzone expects
+        MctsAI::Config mcts;
+        std::string bookPath;               // opening book answered from without searching; empty = none
+    };
+
+    BotzoneBot();
+    explicit BotzoneBot(const Options& options);
+
+    // Serves turns until the input ends, or one turn without keep-running.
+    // Returns the number of moves answered.
+    int run(std::istream& in, std::ostream& out);
+
+    const GameState& getGameState() const { return gameState; }
+
+private:
+    void applyRequest(const std::optional<Move>& move);
+    std::optional<Move> think(double secondsLeft);
+
+    Options options;
+    MctsAI ai;
+    std::unique_ptr<OpeningBook> book;
+    GameState gameState;
+};
+
+} // namespace amazons
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "ai/BotProcess.hpp"
+#include "ai/BotServer.hpp"
+#include "core/Move.hpp"
+#include "core/Player.hpp"
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Plays one game between two Botzone bots the way Botzone's own Amazons judge
+// does, so bots can be regression-tested offline: each bot speaks either the
+// simple or the JSON protocol, bots that print the keep-running marker stay
+// alive and get only the opponent's move, all others are restarted with the
+// full history (and, in JSON, their data/globaldata) every turn. A move that
+// is late, malformed or illegal loses the game on the spot.
+class BotzoneJudge {
+public:
+    enum class Protocol { SIMPLE, JSON };
+
+    struct BotSpec {
+        std::string path;
+        Protocol protocol = Protocol::SIMPLE;
+    };
+
+    struct Options {
+        BotSpec black;
+        BotSpec white;
+        double turnSeconds = 3.0;           // wall clock per move
+        double startupSeconds = 1.0;        // extra whenever the bot had to be (re)started
+        BotProcess::Limits limits;
+        std::string transcriptPath;         // every input and output, flushed per turn; empty = none
+    };
+
+    struct TurnRecord {
+        Player player = Player::BLACK;
+        std::string input;                  // exactly what the bot was sent
+        std::string output;                 // its reply line, empty if none came
+        double wallSeconds = 0.0;
+        double cpuSeconds = 0.0;
+        bool restarted = false;             // a fresh process got the full history
+    };
+
+    struct Result {
+        Player winner = Player::BLACK;
+        BotServer::EndReason reason = BotServer::EndReason::NO_MOVES;
+        std::vector<Move> moves;
+        std::vector<TurnRecord> turns;
+        double seconds = 0.0;
+    };
+
+    static Result play(const Options& options);
+
+    static const char* protocolName(Protocol protocol);
+};
+
+} // namespace amazons
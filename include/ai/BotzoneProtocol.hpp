@@ -0,0 +1,61 @@
+#pragma once
+
+#include "core/Move.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Wire formats of Botzone's Amazons game, shared by our bot, the judges and
+// BotzoneAI. Coordinates are (x, y) = (column, row); Black moves first and its
+// first request is the all -1 placeholder, which also stands for "no move".
+//
+// Simple protocol, first turn n:    n, then 2n - 1 lines alternating request
+//                                   and response, one "x0 y0 x1 y1 x2 y2" each
+// JSON protocol, first turn:        {"requests":[...],"responses":[...],"data":...}
+//                                   with {"x0":..,"y0":..,...,"y2":..} moves
+// Keep-running, later turns:        only the new request, in either format
+class BotzoneProtocol {
+public:
+    static constexpr const char* KEEP_RUNNING = ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<";
+
+    // Simple protocol: "x0 y0 x1 y1 x2 y2"; an empty optional is "-1 -1 -1 -1 -1 -1"
+    static std::string formatMove(const std::optional<Move>& move);
+    static std::optional<Move> parseMove(const std::string& line);
+
+    // Full first-turn input for the side to move after the given moves from the start
+    static std::string simpleInput(const std::vector<Move>& moves);
+
+    // JSON protocol
+    static std::string jsonMove(const std::optional<Move>& move);
+    static std::optional<Move> parseJsonMove(const std::string& object);
+
+    // data and globalData are raw JSON values kept from the bot's previous output
+    static std::string jsonInput(const std::vector<Move>& moves, const std::string& data = "",
+                                 const std::string& globalData = "");
+
+    struct JsonInput {
+        std::vector<std::optional<Move>> requests;
+        std::vector<std::optional<Move>> responses;
+    };
+    static JsonInput parseJsonInput(const std::string& text);
+
+    static std::string jsonOutput(const std::optional<Move>& move);
+
+    struct JsonOutput {
+        std::optional<Move> move;
+        std::string data;           // raw JSON values, empty when absent
+        std::string globalData;
+    };
+    static JsonOutput parseJsonOutput(const std::string& text);
+
+    // Raw text of a top-level member of a JSON object; empty optional when absent.
+    // Throws std::invalid_argument on malformed JSON.
+    static std::optional<std::string> jsonField(const std::string& object, const std::string& key);
+
+    // Raw text of each element of a JSON array
+    static std::vector<std::string> jsonArray(const std::string& array);
+};
+
+} // namespace amazons
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Move.hpp"
+#include <memory>
+#include <optional>
+#include <string>
+
+namespace amazons {
+
+// Common face of the in-process engines so tools can pit any two against each
+// other. An Engine is used by one thread at a time; make one per worker.
+class Engine {
+public:
+    virtual ~Engine() = default;
+
+    virtual Move getBestMove(const GameState& gameState) = 0;
+
+    // Called before each game so engines can drop state from the previous one
+    virtual void newGame() {}
+
+    virtual std::string getName() const = 0;
+
+    // Win probability of the last returned move for the side that played it, if known
+    virtual std::optional<double> getLastWinRate() const { return std::nullopt; }
+};
+
+// Builds an engine from a spec "kind[:key=value,...]":
+//   basic                  greedy BasicAI
+//   random[:seed=N]        uniformly picks an amazon, destination and arrow
+//   mcts[:time=S,playouts=N,threads=N,rule=uct|puct,c=X,widening=X,reuse=0|1,seed=N]
+// Every kind also takes book=PATH, an OpeningBook played from before searching.
+// Throws std::invalid_argument for unknown kinds or keys.
+std::unique_ptr<Engine> createEngine(const std::string& spec);
+
+} // namespace amazons
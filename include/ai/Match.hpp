@@ -0,0 +1,63 @@
+#pragma once
+
+#include "core/Move.hpp"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Headless engine-vs-engine match: games run concurrently on a pool of worker
+// threads, each with its own pair of engines built from the spec strings.
+// Amazons has no draws, so every game is a win for one side and the score
+// model is binomial.
+class Match {
+public:
+    using Opening = std::vector<Move>;
+
+    struct Options {
+        std::string engineA;            // spec for createEngine()
+        std::string engineB;
+        int games = 100;
+        unsigned concurrency = 1;
+        std::vector<Opening> openings;  // each played twice, once per colour; empty = standard start
+        bool sprt = false;              // stop as soon as the test accepts a hypothesis
+        double elo0 = 0.0;
+        double elo1 = 5.0;
+        double alpha = 0.05;
+        double beta = 0.05;
+    };
+
+    enum class SprtOutcome { CONTINUE, ACCEPT_H0, ACCEPT_H1 };
+
+    struct Result {
+        int games = 0;
+        int winsA = 0;
+        int winsB = 0;
+        int illegalMoves = 0;           // games lost by playing an illegal move
+        double elo = 0.0;               // of A relative to B
+        double eloError = 0.0;          // 95% half-width
+        double llr = 0.0;
+        double lowerBound = 0.0;
+        double upperBound = 0.0;
+        SprtOutcome sprtOutcome = SprtOutcome::CONTINUE;
+        double elapsedSeconds = 0.0;
+    };
+
+    // Progress is called under a lock after every finished game
+    static Result run(const Options& options, const std::function<void(const Result&)>& progress = {});
+
+    // Elo difference implied by a score in (0, 1); infinite at 0 or 1
+    static double eloFromScore(double score);
+
+    // 95% error bar of the Elo estimate after the given wins and losses
+    static double eloError(int wins, int losses);
+
+    // Log-likelihood ratio of H1 (elo1) against H0 (elo0) for a binomial win/loss record
+    static double sprtLlr(int wins, int losses, double elo0, double elo1);
+
+    // One opening per line: moves as six numbers each, separated by ';'. '#' starts a comment.
+    static std::vector<Opening> loadOpenings(const std::string& path);
+};
+
+} // namespace amazons
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Move.hpp"
+#include "utils/StopToken.hpp"
+#include <cstdint>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace amazons {
+
+class FastBoard;
+
+class MctsAI {
+public:
+    enum class SelectionRule {
+        UCT,    // mean value + c * sqrt(ln N / n)
+        PUCT    // mean value + c * P * sqrt(N) / (1 + n), uniform prior P
+    };
+
+    enum class ParallelMode {
+        TREE,   // all threads share one tree, kept apart by virtual loss
+        ROOT    // each thread grows its own tree; root statistics are summed at the end
+    };
+
+    struct Config {
+        double timeLimitSeconds = 1.0;
+        uint64_t maxPlayouts = 0;           // 0 = limited by time only
+        SelectionRule rule = SelectionRule::UCT;
+        double exploration = 0.7;
+        // Progressive widening: a node may have 1 + base * visits^exponent children
+        double wideningBase = 2.0;
+        double wideningExponent = 0.5;
+        size_t arenaNodes = size_t(1) << 21;
+        bool reuseTree = true;              // keep the subtree of the actual position between moves
+        uint64_t seed = 0;                  // 0 = seed from the clock
+        unsigned threads = 1;
+        ParallelMode parallelMode = ParallelMode::TREE;
+        uint32_t virtualLoss = 1;           // losses added per worker below a node in tree mode
+    };
+
+    struct SearchStats {
+        uint64_t playouts = 0;
+        size_t nodes = 0;
+        unsigned threads = 0;
+        double elapsedSeconds = 0.0;
+        double playoutsPerSecond = 0.0;
+        double bestWinRate = 0.0;           // from the mover's point of view
+        size_t reusedNodes = 0;             // nodes carried over from the previous search
+        uint32_t reusedVisits = 0;          // root visits carried over from the previous search
+        uint64_t ponderPlayouts = 0;        // playouts run while pondering before this search
+    };
+
+    // Per-search budget; zero means no limit on that axis
+    struct SearchLimits {
+        double timeLimitSeconds = 0.0;
+        uint64_t maxPlayouts = 0;
+    };
+
+    struct Search;
+
+    // Anytime view of a search running in the background. Copies share the same search.
+    class SearchHandle {
+    public:
+        SearchHandle() = default;
+
+        bool valid() const { return search != nullptr; }
+
+        // Most visited root move so far; empty until the first child is explored
+        std::optional<Move> bestSoFar() const;
+
+        // Ends the search early ("move now"); the result becomes the best move so far
+        void stop();
+
+        bool isReady() const;
+        std::shared_future<Move> result() const;
+
+    private:
+        friend class MctsAI;
+        explicit SearchHandle(std::shared_ptr<Search> search) : search(std::move(search)) {}
+
+        std::shared_ptr<Search> search;
+    };
+
+    MctsAI();
+    explicit MctsAI(const Config& config);
+    ~MctsAI();
+
+    // Searches the given position on the calling thread within the configured limits.
+    // If it was reached from the previous search root (normally our move plus the
+    // opponent's reply), that subtree is kept and the rest of the arena is released,
+    // unless it fills more than half the arena; then the search starts afresh.
+    Move getBestMove(const GameState& gameState);
+
+    // Same search on a background thread. Any running search or ponder is stopped first.
+    // The search also ends when cancel is raised; the caller reads the result from the
+    // handle and applies it on its own thread.
+    SearchHandle startSearch(const GameState& gameState, const SearchLimits& limits, StopToken cancel = StopToken());
+    SearchHandle startSearch(const GameState& gameState) { return startSearch(gameState, defaultLimits()); }
+
+    // Stops any background search, pondering included, and waits for its threads
+    void stopSearch();
+    bool isSearching() const { return background.joinable(); }
+
+    SearchLimits defaultLimits() const { return {config.timeLimitSeconds, config.maxPlayouts}; }
+
+    // Drop the search tree, e.g. when a new game starts
+    void reset();
+
+    // Keeps searching the given position (the opponent to move) in the background
+    // until stopPondering() or the next search. When the opponent's actual move was
+    // explored, the next search starts from that subtree; otherwise it starts fresh.
+    // Does nothing when reuseTree is off.
+    //
+    // Starting and stopping searches and pondering is not thread-safe: it all
+    // happens on the thread that owns the AI, such as the UI thread. Only a
+    // SearchHandle may be used from other threads.
+    void startPondering(const GameState& gameState);
+    void stopPondering();
+    bool isPondering() const;
+
+    // Stats of the last completed search; read them after its result is ready
+    const SearchStats& getLastStats() const { return lastStats; }
+    const Config& getConfig() const { return config; }
+
+private:
+    struct Tree;
+
+    static void runWorker(Tree& tree, Search& search, uint64_t seed, bool reportsBest);
+    uint64_t nextSeed();
+    bool prepareTrees(const FastBoard& rootPosition, int rootMoveCount);
+    void runSearch(Search& search);
+    Move searchPosition(Search& search, const FastBoard& rootPosition);
+    SearchHandle launch(std::shared_ptr<Search> search, const FastBoard& rootPosition);
+
+    Config config;
+    std::vector<std::unique_ptr<Tree>> trees;   // one per thread in root mode, otherwise one
+    SearchStats lastStats;
+    uint64_t seed;
+    std::shared_ptr<Search> backgroundSearch;
+    std::thread background;
+    uint64_t lastPonderPlayouts = 0;
+};
+
+} // namespace amazons
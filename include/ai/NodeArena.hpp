@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace amazons {
+
+// Fixed-capacity pool of search nodes in one contiguous block. Nodes are
+// addressed by 32-bit index instead of pointer, which keeps them small and lets
+// a whole tree be dropped with reset() instead of thousands of deletes.
+//
+// allocate() and claim() may be called from several threads at once. Search
+// threads normally go through an Allocator, which claims a chunk at a time and
+// bumps through it locally so the shared counter is touched once per chunk.
+template <typename T>
+class NodeArena {
+    static_assert(std::is_trivially_destructible<T>::value,
+                  "NodeArena never runs destructors");
+
+public:
+    using Index = uint32_t;
+    static constexpr Index NONE = 0xFFFFFFFFu;
+
+    explicit NodeArena(size_t capacity = 0) {
+        reserve(capacity);
+    }
+
+    // Reallocates storage; invalidates every index handed out so far
+    void reserve(size_t newCapacity) {
+        if (newCapacity != capacityCount) {
+            slots.reset(newCapacity ? new Slot[newCapacity] : nullptr);
+            capacityCount = newCapacity;
+        }
+        reset();
+    }
+
+    // Returns NONE when the arena is exhausted; the caller decides how to stop
+    Index allocate() {
+        size_t index = used.fetch_add(1, std::memory_order_relaxed);
+        if (index >= capacityCount) {
+            return NONE;
+        }
+        return construct(static_cast<Index>(index));
+    }
+
+    // Reserves up to count consecutive slots without constructing them.
+    // Returns the first index and stores how many were granted in granted.
+    Index claim(size_t count, size_t& granted) {
+        size_t first = used.fetch_add(count, std::memory_order_relaxed);
+        if (first >= capacityCount) {
+            granted = 0;
+            return NONE;
+        }
+        granted = first + count > capacityCount ? capacityCount - first : count;
+        return static_cast<Index>(first);
+    }
+
+    Index construct(Index index) {
+        new (slots[index].bytes) T();
+        return index;
+    }
+
+    // Not safe while other threads allocate
+    void reset() { used.store(0, std::memory_order_relaxed); }
+
+    T& operator[](Index index) { return *std::launder(reinterpret_cast<T*>(slots[index].bytes)); }
+    const T& operator[](Index index) const {
+        return *std::launder(reinterpret_cast<const T*>(slots[index].bytes));
+    }
+
+    size_t size() const {
+        size_t count = used.load(std::memory_order_relaxed);
+        return count < capacityCount ? count : capacityCount;
+    }
+    size_t capacity() const { return capacityCount; }
+    bool full() const { return used.load(std::memory_order_relaxed) >= capacityCount; }
+
+    void swap(NodeArena& other) {
+        slots.swap(other.slots);
+        std::swap(capacityCount, other.capacityCount);
+        size_t mine = used.load(std::memory_order_relaxed);
+        used.store(other.used.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.used.store(mine, std::memory_order_relaxed);
+    }
+
+    // Per-thread bump allocator over chunks claimed from a shared arena
+    class Allocator {
+    public:
+        explicit Allocator(NodeArena& arena, size_t chunkSize = 256)
+            : arena(arena), chunkSize(chunkSize) {}
+
+        Index allocate() {
+            if (next == end) {
+                size_t granted = 0;
+                Index first = arena.claim(chunkSize, granted);
+                if (first == NONE) {
+                    return NONE;
+                }
+                next = first;
+                end = first + static_cast<Index>(granted);
+            }
+            return arena.construct(next++);
+        }
+
+        // Slots claimed from the arena that allocate() has not handed out
+        size_t unused() const { return end - next; }
+
+    private:
+        NodeArena& arena;
+        size_t chunkSize;
+        Index next = 0;
+        Index end = 0;
+    };
+
+private:
+    // Raw storage so reserve() does not touch every page up front
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    size_t capacityCount = 0;
+    std::atomic<size_t> used{0};
+};
+
+} // namespace amazons
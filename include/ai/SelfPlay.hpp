@@ -0,0 +1,36 @@
+#pragma once
+
+#include "utils/GameArchive.hpp"
+#include "utils/TrainingData.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace amazons {
+
+// Generates labelled positions by letting an engine play itself. Every worker
+// thread owns its engine, random generator and GameState; the only shared
+// object is the writer, which takes one finished game at a time.
+class SelfPlay {
+public:
+    struct Options {
+        std::string engine = "mcts:time=0,playouts=2000";   // spec for createEngine()
+        int games = 100;
+        unsigned threads = 1;
+        int randomPlies = 4;        // random opening moves, not recorded
+        uint64_t seed = 0;          // 0 = seed from the clock
+        GameArchive::Writer* archive = nullptr;     // if set, every finished game is added to it
+    };
+
+    struct Stats {
+        int games = 0;
+        uint64_t positions = 0;
+        double elapsedSeconds = 0.0;
+    };
+
+    // Progress is called under a lock after every finished game
+    static Stats run(const Options& options, TrainingDataWriter& writer,
+                     const std::function<void(const Stats&)>& progress = {});
+};
+
+} // namespace amazons
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "core/Board.hpp"
+#include "core/Move.hpp"
+#include "core/Player.hpp"
+#include <cstdint>
+
+namespace amazons {
+
+class GameState;
+
+// Move packed into three square indices (square = row * 8 + col)
+struct PackedMove {
+    uint8_t from{0};
+    uint8_t to{0};
+    uint8_t arrow{0};
+
+    PackedMove() = default;
+    constexpr PackedMove(uint8_t f, uint8_t t, uint8_t a) : from(f), to(t), arrow(a) {}
+
+    static PackedMove fromMove(const Move& move);
+    Move toMove() const;
+
+    // 18-bit code: from | to << 6 | arrow << 12
+    uint32_t code() const {
+        return static_cast<uint32_t>(from) | (static_cast<uint32_t>(to) << 6) |
+               (static_cast<uint32_t>(arrow) << 12);
+    }
+    static PackedMove fromCode(uint32_t code) {
+        return PackedMove(static_cast<uint8_t>(code & 63),
+                          static_cast<uint8_t>((code >> 6) & 63),
+                          static_cast<uint8_t>((code >> 12) & 63));
+    }
+
+    bool operator==(const PackedMove& other) const {
+        return from == other.from && to == other.to && arrow == other.arrow;
+    }
+    bool operator!=(const PackedMove& other) const {
+        return !(*this == other);
+    }
+    bool operator<(const PackedMove& other) const {
+        return code() < other.code();
+    }
+};
+
+// Small xorshift generator for playouts; not for anything that needs quality randomness
+class FastRandom {
+public:
+    explicit FastRandom(uint64_t seed = 0x9E3779B97F4A7C15ULL)
+        : state(seed ? seed : 0x9E3779B97F4A7C15ULL) {}
+
+    uint64_t next() {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 0x2545F4914F6CDD1DULL;
+    }
+
+    // Uniform-enough value in [0, bound)
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+private:
+    uint64_t state;
+};
+
+// Bitboard position used by search and perft. Board and GameState stay the
+// reference implementation; FastBoard trades readability for speed and is
+// converted to and from them at the engine boundary.
+class FastBoard {
+public:
+    static constexpr int SQUARES = Board::SIZE * Board::SIZE;
+
+    // 4 amazons * 27 destinations * 27 arrows is the most an 8x8 position allows
+    static constexpr int MAX_MOVES = 3072;
+
+    FastBoard();
+
+    static FastBoard standardPosition();
+    static FastBoard fromBoard(const Board& board, Player sideToMove);
+    static FastBoard fromGameState(const GameState& gameState);
+    // The three sets must not overlap; nothing is checked
+    static FastBoard fromBitboards(uint64_t arrows, uint64_t white, uint64_t black, Player sideToMove);
+    Board toBoard() const;
+
+    uint64_t arrows() const { return arrowBits; }
+    uint64_t amazons(Player player) const { return amazonBits[index(player)]; }
+    uint64_t occupied() const { return arrowBits | amazonBits[0] | amazonBits[1]; }
+    Player sideToMove() const { return side; }
+
+    // Zobrist key, maintained incrementally by makeMove/unmakeMove
+    uint64_t hash() const { return key; }
+
+    // No legality check; use isLegal() first for untrusted input
+    void makeMove(PackedMove move);
+    void unmakeMove(PackedMove move);
+    bool isLegal(PackedMove move) const;
+
+    // Writes every legal move into out (at least MAX_MOVES entries), returns the count
+    int generateMoves(PackedMove* out) const;
+
+    // Counts legal moves without materialising them
+    int countMoves() const;
+
+    bool hasMoves(Player player) const;
+    bool hasMoves() const { return hasMoves(side); }
+
+    // Samples a move by picking a mobile amazon, then a destination, then an arrow.
+    // Not uniform over the move list but much cheaper; returns false if side to move is stuck.
+    bool randomMove(FastRandom& rng, PackedMove& out) const;
+
+    // Empty squares reachable by a queen from square through the given occupancy
+    static uint64_t queenReach(int square, uint64_t occupancy);
+
+    static uint64_t squareBit(int square) { return 1ULL << square; }
+    static int squareOf(int row, int col) { return row * Board::SIZE + col; }
+
+    bool operator==(const FastBoard& other) const {
+        return arrowBits == other.arrowBits && amazonBits[0] == other.amazonBits[0] &&
+               amazonBits[1] == other.amazonBits[1] && side == other.side;
+    }
+    bool operator!=(const FastBoard& other) const {
+        return !(*this == other);
+    }
+
+private:
+    uint64_t arrowBits;
+    uint64_t amazonBits[2];
+    Player side;
+    uint64_t key;
+
+    static int index(Player player) { return player == Player::WHITE ? 0 : 1; }
+    uint64_t computeHash() const;
+};
+
+// Bit helpers shared by the bitboard code
+inline int popCount(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bits);
+#else
+    int count = 0;
+    while (bits) {
+        bits &= bits - 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline int lowestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bits);
+#else
+    int square = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++square;
+    }
+    return square;
+#endif
+}
+
+inline int highestBit(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+    return 63 - __builtin_clzll(bits);
+#else
+    int square = 63;
+    while (!(bits & (1ULL << square))) {
+        --square;
+    }
+    return square;
+#endif
+}
+
+} // namespace amazons
@@ -10,8 +10,20 @@ namespace amazons {
 
 class GameState {
 public:
+    // Told of every move made or undone on this state, after the fact, e.g. to
+    // journal the game. Copies of the state do not inherit the listener.
+    class Listener {
+    public:
+        virtual ~Listener() = default;
+        virtual void movePlayed(const GameState& state, const Move& move) = 0;
+        virtual void moveUndone(const GameState& state) = 0;
+    };
+    
     GameState();
     GameState(const Board& board, Player currentPlayer, int turnNumber);
+    // Restores a game whose moves are already known to lead to board, e.g. a
+    // replayed game record; undo then works as if they had been played here
+    GameState(const Board& board, Player currentPlayer, int turnNumber, std::vector<Move> moveHistory);
     
     void initializeStandardGame();
     
@@ -31,6 +43,10 @@ public:
     // For undo functionality (to be implemented later)
     bool canUndo() const { return !moveHistory.empty(); }
     void undoLastMove();
+    const std::vector<Move>& getMoveHistory() const { return moveHistory; }
+    
+    // Replaces any previous listener; nullptr detaches. Not owned
+    void setListener(Listener* newListener) { listener.current = newListener; }
     
     // For testing and debugging
     bool operator==(const GameState& other) const;
@@ -44,6 +60,14 @@ private:
     int turnNumber;
     std::vector<Move> moveHistory;
     
+    // Copying or assigning a state leaves the target's listener as it was
+    struct ListenerSlot {
+        Listener* current = nullptr;
+        ListenerSlot() = default;
+        ListenerSlot(const ListenerSlot&) {}
+        ListenerSlot& operator=(const ListenerSlot&) { return *this; }
+    } listener;
+    
     // Helper methods
     bool hasLegalMoves(Player player) const;
     void switchPlayer();
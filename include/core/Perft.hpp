@@ -0,0 +1,42 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace amazons {
+
+// Move-generation checker: counts the leaf positions of the game tree to a fixed
+// depth. Counts are compared against known values, so any movegen change that
+// alters them is a bug; the timing doubles as a movegen benchmark.
+class Perft {
+public:
+    struct Options {
+        int depth = 1;
+        unsigned threads = 1;       // root moves are shared out between threads
+        bool bulk = true;           // count the last ply with countMoves() instead of making each move
+        bool divide = false;        // keep per-root-move counts
+    };
+
+    struct DivideEntry {
+        PackedMove move;
+        uint64_t nodes = 0;
+    };
+
+    struct Result {
+        uint64_t nodes = 0;
+        double elapsedSeconds = 0.0;
+        double nodesPerSecond = 0.0;
+        std::vector<DivideEntry> divide;    // sorted by move, only with Options::divide
+    };
+
+    // Single-threaded count; board is restored before returning
+    static uint64_t count(FastBoard& board, int depth, bool bulk = true);
+
+    static Result run(const FastBoard& board, const Options& options);
+
+    // Known leaf counts from the standard position, indexed by depth; 0 = unknown
+    static uint64_t referenceCount(int depth);
+};
+
+} // namespace amazons
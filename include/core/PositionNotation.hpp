@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <string>
+#include <string_view>
+
+namespace amazons {
+
+// One-line position text in the manner of chess FEN. The standard start is
+//
+//   2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 1
+//
+// Rows 0 to 7 separated by '/', each cell B (black amazon), W (white amazon),
+// X (arrow) or a digit 1-8 for that many empty cells; then the side to move,
+// b or w, and the turn number, which may be left out and defaults to 1.
+// Exactly four amazons of each colour are required. Trailing whitespace is
+// ignored, so lines read from a CRLF file parse as they are.
+//
+// The parser is a table lookup per character with errors accumulated rather
+// than branched on, so suites of millions of positions load at disk speed.
+class PositionNotation {
+public:
+    static std::string format(const FastBoard& board, int turnNumber = 1);
+    static std::string format(const GameState& gameState);
+
+    // Throws std::invalid_argument saying what is wrong
+    static FastBoard parse(std::string_view text, int* turnNumber = nullptr);
+    static GameState parseGameState(std::string_view text);
+
+    // The same without exceptions, for bulk loading; board and turnNumber are
+    // only written on success
+    static bool tryParse(std::string_view text, FastBoard& board, int& turnNumber);
+};
+
+} // namespace amazons
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include <cstdint>
+
+namespace amazons {
+
+// The eight symmetries of the square board (rotations and reflections), used
+// to store one entry per class of equivalent positions in the opening book
+// and the game database index. The standard start is its own mirror image
+// top to bottom, and later positions have up to eight equivalent forms.
+//
+// Symmetry s applies, in order: a transpose (row and column swap) if bit 2
+// is set, a top-bottom flip if bit 1 is set, a left-right mirror if bit 0 is
+// set. 0 is the identity. Colours and the side to move are unchanged.
+//
+// Bitboards are transformed with byte swaps and delta swaps, a handful of
+// shifts and masks per plane with no loop over squares.
+class Symmetry {
+public:
+    static constexpr int COUNT = 8;
+
+    static uint64_t transform(uint64_t bits, int symmetry);
+    static int transformSquare(int square, int symmetry);
+    static PackedMove transform(PackedMove move, int symmetry);
+    static FastBoard transform(const FastBoard& board, int symmetry);
+
+    // The symmetry undoing the given one
+    static int inverse(int symmetry);
+
+    struct Canonical {
+        uint64_t key;       // smallest Zobrist key over the eight forms
+        int symmetry;       // takes the position to the form with that key
+    };
+
+    // Equivalent positions get the same key. Moves are stored as
+    // transform(move, symmetry) and read back through inverse(symmetry).
+    static Canonical canonical(const FastBoard& board);
+};
+
+} // namespace amazons
@@ -3,9 +3,12 @@
 #include "core/GameState.hpp"
 #include "core/Board.hpp"
 #include "core/Move.hpp"
-#include "ai/BasicAI.hpp"
+#include "ai/MctsAI.hpp"
+#include "utils/AsyncSaver.hpp"
+#include "utils/GameJournal.hpp"
 #include "utils/Serializer.hpp"
 #include <SFML/Graphics.hpp>
+#include <chrono>
 #include <memory>
 #include <vector>
 #include <string>
@@ -49,7 +52,9 @@ private:
     
     // Game objects
     std::unique_ptr<GameState> gameState;
-    std::unique_ptr<BasicAI> ai;
+    std::unique_ptr<MctsAI> ai;   // lives as long as the window so its tree survives between turns
+    MctsAI::SearchHandle aiSearch;    // valid while the AI is thinking about its move
+    std::chrono::steady_clock::time_point aiSearchStarted;
     
     // Saved game for "Continue" feature
     std::unique_ptr<GameState> savedGameState;
@@ -70,7 +75,9 @@ private:
     
     // Save/Load
     Serializer serializer;
-    std::vector<std::string> savedGamesList;
+    AsyncSaver saver;   // writes saves off the render thread
+    std::unique_ptr<GameJournal> journal;   // survives a crash of the game in play
+    std::vector<SaveInfo> savedGamesList;   // from the save index, no file opened
     int selectedSaveIndex;
     int scrollOffset;  // For scrolling through many saves
     
@@ -104,6 +111,9 @@ private:
     
     // Game logic
     void processAIMove();
+    void pollAISearch();
+    void cancelAISearch();
+    void scheduleAI();
     void resetSelection();
     void selectAmazon(const Position& pos);
     void selectMoveDestination(const Position& pos);
@@ -124,6 +134,10 @@ private:
     
     // Save/Load methods
     void saveCurrentGame();
+    void pollSaves();
+    GameMode serializedGameMode() const;
+    void startJournal();
+    void recoverUnfinishedGame();
     void loadSavedGamesList();
     void openLoadScreen();
     void handleLoadScreenClick(int x, int y);
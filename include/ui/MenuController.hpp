@@ -3,10 +3,14 @@
 #include "core/GameState.hpp"
 #include "core/Player.hpp" // For GameMode
 #include "ui/Display.hpp"
+#include "utils/AsyncSaver.hpp"
+#include "utils/GameJournal.hpp"
 #include <memory>
 
 namespace amazons {
 
+class MctsAI;
+
 class MenuController {
 public:
     MenuController();
@@ -20,6 +24,15 @@ private:
     std::unique_ptr<Display> display;
     GameMode currentGameMode;
     
+    // Kept for the whole session so the search tree carries over between turns
+    std::unique_ptr<MctsAI> ai;
+    
+    // In-game saves are written in the background and reported on the next turn
+    AsyncSaver saver;
+    
+    // Journals the game being played so it survives a crash
+    std::unique_ptr<GameJournal> journal;
+    
     // Factory method to create appropriate display
     static std::unique_ptr<Display> createDisplay(bool useGraphical = false);
     
@@ -39,6 +52,10 @@ private:
     void showGameStatus() const;
     bool confirmAction(const std::string& message) const;
     void saveCurrentGame();
+    void reportSaves();
+    void startJournal();
+    void recoverUnfinishedGame();
+    void runCurrentGame();
     
     // Game modes
     void simpleGameLoop(); // Simple human vs human game
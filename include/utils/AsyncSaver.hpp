@@ -0,0 +1,53 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Player.hpp"  // For GameMode
+#include "utils/Serializer.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Writes saves on a background thread so the caller never waits on the disk.
+// save() copies the game and returns at once; the worker writes it through
+// Serializer::writeSave, which replaces the file atomically. Saving a slot
+// again before the worker has reached it replaces the queued snapshot, so a
+// burst of saves of one slot costs a single write. The destructor finishes
+// every queued save.
+//
+// save(), isPending(), flush() and takeFinished() may be called from any thread.
+class AsyncSaver {
+public:
+    struct Outcome {
+        std::string name;
+        bool saved;
+        std::string error;      // why it was not, if it was not
+    };
+
+    AsyncSaver();
+    // Writes into the given directory instead of data/saves/, as Serializer does
+    explicit AsyncSaver(const std::string& saveDirectory);
+    ~AsyncSaver();
+
+    AsyncSaver(const AsyncSaver&) = delete;
+    AsyncSaver& operator=(const AsyncSaver&) = delete;
+
+    void save(const GameState& gameState, GameMode gameMode, const std::string& name,
+              Serializer::SaveFormat format = Serializer::SaveFormat::RECORD);
+
+    // Queued or being written; Serializer::saveExists does not see it yet
+    bool isPending(const std::string& name) const;
+
+    // Blocks until everything queued so far is on disk
+    void flush();
+
+    // Saves finished since the last call, oldest first
+    std::vector<Outcome> takeFinished();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace amazons
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Player.hpp"  // For GameMode
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace amazons {
+
+// Compressed container for large game collections such as self-play runs.
+// A move is written as its index among the legal moves of the position,
+// ordered by PackedMove code, and range coded against the number of legal
+// moves, so it costs log2(moves) bits: about 11 in the opening and a few near
+// the end, against 18 in a GameRecord. The game mode, start position and ply
+// count go through the same coder.
+//
+// Games are grouped into blocks of a fixed number of games, each coded on its
+// own, so reading game N decodes only the block holding it and blocks can be
+// decoded on as many threads as there are.
+//
+// File:  "AMZARC01", u32 games per block, u32 reserved
+// Block: u32 payload bytes, u32 games, u32 CRC-32 of the payload, payload
+// Index: u64 offset of every block, then u64 index offset, u64 game count,
+//        u32 CRC-32 of the block offsets, "AMZAIX01"
+//
+// All little endian. The index is written by close(); an archive whose
+// writer died is read by walking the blocks, up to the first damaged one.
+class GameArchive {
+public:
+    using Game = std::pair<std::unique_ptr<GameState>, GameMode>;
+
+    // Writes a new archive, replacing any file at the path. Not thread-safe.
+    class Writer {
+    public:
+        static constexpr uint32_t DEFAULT_GAMES_PER_BLOCK = 256;
+
+        // Throws std::runtime_error if the file cannot be created
+        explicit Writer(const std::string& path, uint32_t gamesPerBlock = DEFAULT_GAMES_PER_BLOCK);
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        // Returns the game's number; games are numbered from 0 in the order added
+        uint64_t add(const GameState& game, GameMode gameMode = GameMode::AI_VS_AI);
+        // A game in GameRecord form, as written by the binary save path
+        uint64_t addRecord(const void* data, size_t size);
+
+        // Writes the last block and the index; throws std::runtime_error on write errors
+        void close();
+
+        uint64_t gameCount() const { return games; }
+        uint64_t bytesWritten() const { return offset; }
+
+    private:
+        void writeBlock();
+
+        struct Coder;                   // the block being filled
+
+        std::string path;
+        std::FILE* file;
+        uint32_t gamesPerBlock;
+        std::unique_ptr<Coder> coder;
+        std::vector<uint64_t> blockOffsets;
+        uint64_t games = 0;
+        uint64_t offset = 0;
+    };
+
+    // Throws std::runtime_error if the file is missing or not an archive
+    explicit GameArchive(const std::string& path);
+    ~GameArchive();
+
+    GameArchive(const GameArchive&) = delete;
+    GameArchive& operator=(const GameArchive&) = delete;
+
+    uint64_t gameCount() const;
+    size_t blockCount() const;
+    uint32_t gamesPerBlock() const;
+
+    // Decodes the block holding the game; the last block decoded is kept, so
+    // reading games in order decodes each block once. Throws std::out_of_range
+    // for a game number past the end and std::runtime_error for a damaged block.
+    // Safe to call from several threads, though they then share one cached
+    // block; forEach() or block() suit parallel scans better.
+    Game game(uint64_t id) const;
+    // The game as a GameRecord, for code that takes the binary save format
+    std::string record(uint64_t id) const;
+
+    // Every game of one block, in order
+    std::vector<Game> block(size_t index) const;
+
+    // Decodes the whole archive on the given number of threads, a block at a
+    // time, and hands every game to visit with its number. Calls come from
+    // several threads at once and in no particular order. The first exception
+    // from a worker or from visit stops the run and is rethrown.
+    void forEach(unsigned threads,
+                 const std::function<void(uint64_t id, const GameState& game, GameMode gameMode)>& visit) const;
+
+    // True if the bytes start like an archive; cheap enough to sniff file formats
+    static bool isArchive(const void* data, size_t size);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace amazons
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include "core/Player.hpp"  // For GameMode
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace amazons {
+
+// Archive of whole games in one append-only file, read through mmap so that
+// looking a game up copies nothing but the record being decoded. Next to it,
+// <path>.idx holds every position of every game as (Zobrist key, game, ply)
+// sorted by key, so "which games reached this position" is a binary search.
+// The key is the symmetry-canonical one, so a search also finds the games that
+// reached a reflection or rotation of the position.
+//
+// Data file:  "AMZGDB01", then per game a u16 length and a GameRecord
+// Index file: "AMZIDX02", u64 data bytes covered, u64 entry count, entries
+//
+// Games appended since the index was last written are indexed in memory and
+// merged into the file by flush() (or the destructor). An index that is
+// missing, damaged or behind the data file is brought up to date on open, and
+// a game cut short by a crash mid-append is dropped. Not thread-safe.
+class GameDatabase {
+public:
+    struct Occurrence {
+        uint32_t game;
+        uint16_t ply;       // moves played before the position arose
+
+        bool operator==(const Occurrence& other) const {
+            return game == other.game && ply == other.ply;
+        }
+    };
+
+    // Opens the database, creating both files if needed; throws std::runtime_error on I/O errors
+    explicit GameDatabase(const std::string& path);
+    ~GameDatabase();
+
+    GameDatabase(const GameDatabase&) = delete;
+    GameDatabase& operator=(const GameDatabase&) = delete;
+
+    // Returns the new game's number; games are numbered from 0 in append order
+    uint32_t append(const GameState& game, GameMode gameMode = GameMode::HUMAN_VS_HUMAN);
+
+    size_t gameCount() const;
+
+    // Throws std::out_of_range for a game number past the end
+    std::pair<std::unique_ptr<GameState>, GameMode> game(uint32_t id) const;
+
+    // Every (game, ply) that reached the position or one of its symmetric
+    // forms, ordered by game then ply
+    std::vector<Occurrence> find(const FastBoard& position) const;
+    std::vector<Occurrence> find(const GameState& position) const;
+
+    // Writes the merged index next to the data file
+    void flush();
+
+    // Key the index is sorted by
+    static uint64_t positionKey(const FastBoard& position);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace amazons
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Player.hpp"  // For GameMode
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace amazons {
+
+// Write-ahead journal of one game in progress, so that a crash loses at most
+// the moves since the last fsync rather than everything since the last manual
+// save. Set as a GameState's listener, it appends one fixed-size record per
+// move made or undone. Every compactEvery records the game so far is folded
+// into a fresh journal that starts from a snapshot of it, replacing the old
+// file atomically.
+//
+// File layout, little-endian:
+//
+//   "AMZJ" magic, u8 version, u8 zero, u16 snapshot length
+//   the snapshot: a GameRecord of the game when the journal was (re)started
+//   8-byte records: u32 kind << 24 | PackedMove code, u32 CRC-32 of that word
+//       and the record's sequence number, counting from 0 after the snapshot
+//
+// Each record reaches the file with its own write() on an O_APPEND descriptor,
+// so a process crash loses nothing. fsync, the expensive part, is
+// group-committed: once syncEvery records are unsynced, when a record arrives
+// more than syncInterval after the oldest unsynced one, and on sync() or
+// destruction. A record torn by a power cut fails its checksum and ends replay.
+//
+// I/O errors are reported on std::cerr and stop the journal rather than the
+// game: it is a safety net, not the save.
+class GameJournal : public GameState::Listener {
+public:
+    struct Options {
+        size_t syncEvery = 8;
+        std::chrono::milliseconds syncInterval{100};
+        size_t compactEvery = 256;
+    };
+
+    // Starts a journal at path for game, replacing any journal there. Throws
+    // std::runtime_error if it cannot be written. The caller attaches it with
+    // game.setListener(&journal).
+    GameJournal(const std::string& path, const GameState& game, GameMode gameMode);
+    GameJournal(const std::string& path, const GameState& game, GameMode gameMode, const Options& options);
+    ~GameJournal() override;
+
+    GameJournal(const GameJournal&) = delete;
+    GameJournal& operator=(const GameJournal&) = delete;
+
+    void movePlayed(const GameState& state, const Move& move) override;
+    void moveUndone(const GameState& state) override;
+
+    // Forces unsynced records to the device
+    void sync();
+
+    // Folds the records into a new snapshot of game, which must be the state
+    // the journal has been following
+    void compact(const GameState& game);
+
+    // Deletes the file and stops journaling, e.g. once the game is saved for good
+    void discard();
+
+    size_t recordsSinceSnapshot() const { return records; }
+
+    static bool exists(const std::string& path);
+    static void remove(const std::string& path);
+
+    // Rebuilds the game from the snapshot and the intact records; {nullptr, ...}
+    // if there is no journal. Throws std::invalid_argument if the snapshot is
+    // damaged or a record does not apply.
+    static std::pair<std::unique_ptr<GameState>, GameMode> recover(const std::string& path);
+
+    static constexpr char MAGIC[4] = {'A', 'M', 'Z', 'J'};
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr size_t RECORD_SIZE = 8;
+
+private:
+    std::string path;
+    GameMode gameMode;
+    Options options;
+    int fd = -1;
+    size_t records = 0;         // since the snapshot, and the next record's sequence number
+    size_t unsynced = 0;
+    std::chrono::steady_clock::time_point oldestUnsynced;
+
+    void append(uint8_t kind, uint32_t code, const GameState& state);
+    void fail(const std::string& what);
+};
+
+} // namespace amazons
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "core/GameState.hpp"
+#include "core/Player.hpp"  // For GameMode
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace amazons {
+
+// Compact binary game record: the whole game rather than just its last board,
+// so undo still works after loading. Little-endian layout:
+//
+//   "AMZ" magic, u8 version, u8 flags, u8 game mode, u16 ply count
+//   with FLAG_CUSTOM_START: 16 bytes of board (2 bits per square), u8 side to
+//       move, u16 turn number; otherwise the game starts from the standard position
+//   ply count * 18 bits of PackedMove codes, zero-padded to a whole byte
+//   u32 CRC-32 of everything before it
+//
+// A 60-ply game takes 147 bytes, and the longest possible 8x8 game 219.
+class GameRecord {
+public:
+    static constexpr char MAGIC[3] = {'A', 'M', 'Z'};
+    static constexpr uint8_t VERSION = 1;
+    static constexpr uint8_t FLAG_CUSTOM_START = 1;
+    static constexpr size_t HEADER_SIZE = 8;
+
+    static std::string encode(const GameState& gameState, GameMode gameMode);
+
+    // Replays the moves on a bitboard, checking each for legality. Throws
+    // std::invalid_argument on a wrong magic or version, a checksum mismatch,
+    // truncation or an illegal move.
+    static std::pair<std::unique_ptr<GameState>, GameMode> decode(const void* data, size_t size);
+    static std::pair<std::unique_ptr<GameState>, GameMode> decode(const std::string& bytes) {
+        return decode(bytes.data(), bytes.size());
+    }
+
+    // True if the bytes start like a record; cheap enough to sniff file formats
+    static bool isRecord(const void* data, size_t size);
+
+    static uint32_t crc32(const void* data, size_t size);
+};
+
+} // namespace amazons
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace amazons {
+
+// Single-pass reader over JSON text that copies nothing: keys and string
+// values come back as views into the input, with escape sequences left as
+// written. Callers walk the document in order:
+//
+//   JsonReader reader(text);
+//   reader.beginObject();
+//   std::string_view key;
+//   while (reader.nextMember(key)) {
+//       if (key == "turn") turn = reader.readInteger(); else reader.skipValue();
+//   }
+//   reader.expectEnd();
+//
+// Throws std::invalid_argument, with the byte offset, on malformed input or a
+// value of the wrong type.
+class JsonReader {
+public:
+    explicit JsonReader(std::string_view text) : text(text) {}
+
+    void beginObject();
+    // Reads the next member's key up to its colon; false at the closing brace
+    bool nextMember(std::string_view& key);
+
+    void beginArray();
+    // True if another element follows; false at the closing bracket
+    bool nextElement();
+
+    std::string_view readString();
+    int64_t readInteger();
+    bool readBool();
+    // Skips any value, nested ones included
+    void skipValue();
+
+    // Only whitespace may follow the document
+    void expectEnd();
+
+    size_t position() const { return pos; }
+
+private:
+    std::string_view text;
+    size_t pos = 0;
+    bool first = true;      // no member or element read yet in the innermost container
+
+    char peek();
+    void expect(char c);
+    void skipValue(int depth);
+    [[noreturn]] void fail(const char* what) const;
+};
+
+} // namespace amazons
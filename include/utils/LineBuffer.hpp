@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace amazons {
+
+// Ring buffer between a byte stream and whole lines. The reader asks for free
+// space, lets read() fill it directly and commits the byte count; complete lines
+// come out of popLine() without the trailing "\n" or "\r\n". Bytes after the
+// last newline stay buffered until the rest of the line arrives. The buffer
+// grows when a single line does not fit.
+class LineBuffer {
+public:
+    explicit LineBuffer(size_t initialCapacity = 4096)
+        : data(new char[initialCapacity ? initialCapacity : 1]), capacity(initialCapacity ? initialCapacity : 1) {}
+
+    // Contiguous free space after the buffered bytes; never empty
+    std::pair<char*, size_t> writeSpace() {
+        if (count == capacity) {
+            grow();
+        }
+        size_t tail = (head + count) % capacity;
+        size_t contiguous = tail >= head ? capacity - tail : head - tail;
+        if (contiguous > capacity - count) {
+            contiguous = capacity - count;
+        }
+        return {data.get() + tail, contiguous};
+    }
+
+    void commit(size_t bytes) { count += bytes; }
+
+    void append(const char* bytes, size_t size) {
+        while (size > 0) {
+            auto space = writeSpace();
+            size_t chunk = size < space.second ? size : space.second;
+            std::memcpy(space.first, bytes, chunk);
+            commit(chunk);
+            bytes += chunk;
+            size -= chunk;
+        }
+    }
+
+    bool popLine(std::string& line) {
+        // Bytes before `scanned` are already known to hold no newline
+        for (; scanned < count; ++scanned) {
+            if (at(scanned) == '\n') {
+                take(line, scanned);
+                consume(scanned + 1);
+                if (!line.empty() && line.back() == '\r') {
+                    line.pop_back();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Everything buffered, complete line or not; used once the stream has ended
+    std::string takeAll() {
+        std::string rest;
+        take(rest, count);
+        consume(count);
+        return rest;
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    void clear() { head = count = scanned = 0; }
+
+private:
+    char at(size_t offset) const { return data[(head + offset) % capacity]; }
+
+    void take(std::string& out, size_t length) const {
+        size_t first = capacity - head < length ? capacity - head : length;
+        out.assign(data.get() + head, first);
+        out.append(data.get(), length - first);
+    }
+
+    void consume(size_t length) {
+        head = count == length ? 0 : (head + length) % capacity;
+        count -= length;
+        scanned = 0;
+    }
+
+    void grow() {
+        std::unique_ptr<char[]> bigger(new char[capacity * 2]);
+        size_t first = capacity - head < count ? capacity - head : count;
+        std::memcpy(bigger.get(), data.get() + head, first);
+        std::memcpy(bigger.get() + first, data.get(), count - first);
+        data = std::move(bigger);
+        capacity *= 2;
+        head = 0;
+    }
+
+    std::unique_ptr<char[]> data;
+    size_t capacity;
+    size_t head = 0;
+    size_t count = 0;
+    size_t scanned = 0;
+};
+
+} // namespace amazons
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// Read-only view of the first bytes of a file: mmap where there is one, a
+// plain copy elsewhere. Shared by the on-disk tables that are searched in
+// place rather than loaded.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { reset(); }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Maps size bytes from the start of the file; throws std::runtime_error
+    void map(const std::string& path, size_t size);
+    void reset();
+
+    const unsigned char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const unsigned char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    std::vector<unsigned char> copy;
+#endif
+};
+
+} // namespace amazons
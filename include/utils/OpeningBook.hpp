@@ -0,0 +1,83 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace amazons {
+
+// Moves for the first plies of the game, where there are over 2000 legal moves
+// and a search is at its most expensive, looked up instead of searched.
+//
+// File: "AMZBOOK2", u64 entry count, then 16-byte entries (Zobrist key, packed
+// move, weight, score) sorted by key and, within a key, best first. Positions
+// are stored once per symmetry class (see Symmetry), under the canonical key
+// and with moves turned to match, so reflections of a line share its entries.
+// Like the game database index it is in host byte order and read in place
+// through mmap, so opening a book costs nothing and a probe is a binary search
+// that touches a couple of dozen entries.
+class OpeningBook {
+public:
+    struct BookMove {
+        PackedMove move;
+        uint32_t weight;    // games that played the move
+        double score;       // mean result for the side playing it, 0 (lost) to 1 (won)
+    };
+
+    // Aggregates the moves of finished games into a book
+    class Builder {
+    public:
+        // Only the first maxPlies moves of each game are taken
+        explicit Builder(int maxPlies = 8) : maxPlies(maxPlies) {}
+
+        // Games that are not over are skipped; returns whether the game was taken
+        bool addGame(const GameState& game);
+        // One move from a position; result is 1 if the side to move went on to win
+        void add(const FastBoard& position, PackedMove move, double result);
+
+        // Moves played fewer than minWeight times are left out
+        void write(const std::string& path, uint32_t minWeight = 1) const;
+
+        size_t positionCount() const;
+        size_t moveCount() const { return moves.size(); }
+
+    private:
+        struct Tally {
+            uint32_t games = 0;
+            double results = 0.0;
+        };
+
+        int maxPlies;
+        std::map<std::pair<uint64_t, uint32_t>, Tally> moves;   // (key, move code)
+    };
+
+    // Throws std::runtime_error if the file is missing or not a book
+    explicit OpeningBook(const std::string& path);
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    size_t size() const;
+
+    // Every book move for the position, best first
+    std::vector<BookMove> lookup(const FastBoard& position) const;
+
+    // The most played legal book move, ties going to the better score. False
+    // when the position is not in the book. Safe to call from many threads.
+    bool probe(const FastBoard& position, PackedMove& move) const;
+
+    // Key positions are stored under: the same for every reflection and rotation
+    static uint64_t positionKey(const FastBoard& position);
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace amazons
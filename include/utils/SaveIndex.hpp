@@ -0,0 +1,58 @@
+#pragma once
+
+#include "core/Player.hpp"  // For GameMode
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace amazons {
+
+// What the load screen shows about a save, without opening it
+struct SaveInfo {
+    std::string name;
+    int64_t savedAt = 0;        // seconds since the Unix epoch
+    int turnNumber = 1;
+    uint32_t plies = 0;         // moves kept for undo; 0 for JSON saves
+    GameMode gameMode = GameMode::HUMAN_VS_HUMAN;
+    bool record = false;        // binary GameRecord rather than JSON
+
+    bool operator==(const SaveInfo& other) const {
+        return name == other.name && savedAt == other.savedAt && turnNumber == other.turnNumber &&
+               plies == other.plies && gameMode == other.gameMode && record == other.record;
+    }
+};
+
+// Metadata of every save in a directory, kept in one file next to them so that
+// listing saves neither scans the directory nor opens the saves. Entries are
+// sorted by name. Serializer keeps it in step with its saves and deletes and
+// rebuilds it from the directory when it is missing or damaged.
+//
+// File: "AMZSIX01", u32 count, per entry u16 name length, name, i64 savedAt,
+//       u32 turn number, u32 plies, u8 mode, u8 record; then u32 CRC-32
+class SaveIndex {
+public:
+    static constexpr const char* FILE_NAME = "saves.amzi";
+
+    explicit SaveIndex(const std::string& directory);
+
+    // False, leaving the index empty, if the file is missing or damaged
+    bool load();
+    // Replaces the file atomically; throws std::runtime_error
+    void store() const;
+
+    void put(const SaveInfo& info);
+    void erase(const std::string& name);
+    void clear() { entries.clear(); }
+
+    const SaveInfo* find(const std::string& name) const;
+    const std::vector<SaveInfo>& all() const { return entries; }
+
+    const std::string& getPath() const { return path; }
+
+private:
+    std::string path;
+    std::vector<SaveInfo> entries;
+};
+
+} // namespace amazons
@@ -2,42 +2,102 @@
 
 #include "core/GameState.hpp"
 #include "core/Player.hpp"  // For GameMode
+#include "utils/SaveIndex.hpp"
 #include <string>
+#include <string_view>
 #include <filesystem>
 
 namespace amazons {
 
 class Serializer {
 public:
+    // On-disk formats: JSON text of the final position (<name>.json), or a
+    // binary GameRecord of the whole game (<name>.amzr) that keeps undo working
+    enum class SaveFormat {
+        JSON,
+        RECORD
+    };
+    
     Serializer() = default;
     
-    // Save game state to file
-    bool saveGame(const GameState& gameState, GameMode gameMode, const std::string& filename) const;
+    // Keeps saves and their index in the given directory instead of data/saves/;
+    // for tests and tools that must not touch the player's saves
+    explicit Serializer(const std::string& saveDirectory);
+    
+    // Save game state to file, replacing a save of the same name in the other format
+    bool saveGame(const GameState& gameState, GameMode gameMode, const std::string& filename,
+                  SaveFormat format = SaveFormat::JSON) const;
+    
+    // The same save without logging; throws std::runtime_error on failure. The
+    // file is replaced atomically, so it is never left half written
+    void writeSave(const GameState& gameState, GameMode gameMode, const std::string& filename,
+                   SaveFormat format = SaveFormat::JSON) const;
+    
+    // Temp file, fsync, rename over the target; throws std::runtime_error
+    static void writeFileAtomically(const std::string& path, const std::string& content);
+    
+    // Where the crash-recovery journal of a game in progress lives
+    std::string getJournalPath(const std::string& name) const;
     
-    // Load game state from file
+    // Load game state from file; either format, a record winning if both exist
     std::unique_ptr<GameState> loadGame(const std::string& filename) const;
     
     // Load game state and game mode from file
     std::pair<std::unique_ptr<GameState>, GameMode> loadGameWithMode(const std::string& filename) const;
     
-    // Get list of saved games
+    // Load a save from an explicit path in either format, quietly; for bulk imports
+    std::pair<std::unique_ptr<GameState>, GameMode> loadGameFile(const std::string& path) const;
+    
+    // Get list of saved games, sorted by name; read from the save index
     std::vector<std::string> getSavedGames() const;
     
+    // The same with what the index knows about each save
+    std::vector<SaveInfo> listSaves() const;
+    
+    // Rescans the save directory, e.g. after saves were copied in by hand
+    void rebuildSaveIndex() const;
+    
     // Check if a save file exists
     bool saveExists(const std::string& filename) const;
     
     // Delete a save file
     bool deleteSave(const std::string& filename) const;
     
-private:
-    // Helper methods for JSON serialization
+    // JSON text of a save file, without touching the disk
     std::string serializeGameState(const GameState& gameState, GameMode gameMode) const;
-    std::unique_ptr<GameState> deserializeGameState(const std::string& json) const;
-    std::pair<std::unique_ptr<GameState>, GameMode> deserializeGameStateWithMode(const std::string& json) const;
+    std::unique_ptr<GameState> deserializeGameState(std::string_view json) const;
+    std::pair<std::unique_ptr<GameState>, GameMode> deserializeGameStateWithMode(std::string_view json) const;
     
+private:
     // File operations
     std::string getSaveDirectory() const;
     std::string getFullPath(const std::string& filename) const;
+    std::string getRecordPath(const std::string& filename) const;
+    
+    // Path of the existing save for a name, empty if there is none
+    std::string findSave(const std::string& filename) const;
+    
+    // Index of the save directory, rebuilt from the files if it is missing or
+    // damaged; callers hold the index mutex. Parsed once and kept in memory
+    // until the file changes on disk
+    SaveIndex openIndex() const;
+    void storeIndex(const SaveIndex& index) const;
+    // Writes the index back if it can; the entries are good either way
+    void rebuildIndex(SaveIndex& index) const;
+    static SaveInfo describeSave(const std::string& name, const GameState& gameState, GameMode gameMode,
+                                 bool record, int64_t savedAt);
+    
+    // Decodes whichever format the file content is in
+    std::pair<std::unique_ptr<GameState>, GameMode> decodeSave(std::string_view content) const;
+    
+    // Whole file into readBuffer with one open and (normally) one read; false if it cannot be opened
+    bool readFile(const std::string& path) const;
+    
+    // Reused across loads so reading many saves does not allocate per file
+    mutable std::string readBuffer;
+    
+    // Empty for the default data/saves/; otherwise ends in a slash
+    std::string saveDirectoryOverride;
     
     // JSON field names
     static constexpr const char* FIELD_BOARD = "board";
@@ -49,6 +109,10 @@ private:
     static constexpr const char* FIELD_PLAYER_BLACK = "black";
     static constexpr const char* FIELD_EMPTY = "empty";
     static constexpr const char* FIELD_ARROW = "arrow";
+    
+    static constexpr const char* JSON_EXTENSION = ".json";
+    static constexpr const char* RECORD_EXTENSION = ".amzr";
+    static constexpr const char* JOURNAL_EXTENSION = ".amzj";
 };
 
 } // namespace amazons
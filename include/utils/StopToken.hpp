@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+namespace amazons {
+
+// Minimal stand-in for C++20 std::stop_source / std::stop_token: a shared
+// flag that one side raises and any number of workers poll. Stopping is
+// cooperative; nothing is interrupted, workers just check stopRequested().
+class StopToken {
+public:
+    // A default token can never be stopped
+    StopToken() = default;
+
+    bool stopRequested() const {
+        return state && state->load(std::memory_order_relaxed);
+    }
+    bool stopPossible() const { return state != nullptr; }
+
+private:
+    friend class StopSource;
+    explicit StopToken(std::shared_ptr<std::atomic<bool>> state) : state(std::move(state)) {}
+
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+class StopSource {
+public:
+    StopSource() : state(std::make_shared<std::atomic<bool>>(false)) {}
+
+    // Returns true if this call was the one that requested the stop
+    bool requestStop() {
+        return !state->exchange(true, std::memory_order_relaxed);
+    }
+    bool stopRequested() const { return state->load(std::memory_order_relaxed); }
+
+    StopToken getToken() const { return StopToken(state); }
+
+private:
+    std::shared_ptr<std::atomic<bool>> state;
+};
+
+} // namespace amazons
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace amazons {
+
+// Hashed timing wheel for many deadlines of similar length. A timer lands in
+// the slot of the tick its deadline rounds up to, so it never fires early and
+// at most one tick late; timers more than one revolution away simply stay in
+// their slot until their tick comes round. Scheduling is O(1) and expiry costs
+// O(timers in the slots passed). There is no cancel: callers give each timer a
+// key and ignore expiries whose key is stale.
+class TimerWheel {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TimerWheel(Clock::duration tick = std::chrono::milliseconds(10), size_t slotCount = 512,
+                        Clock::time_point origin = Clock::now())
+        : slots(slotCount ? slotCount : 1), tick(tick), origin(origin) {}
+
+    void schedule(uint64_t key, Clock::time_point deadline) {
+        uint64_t due = tickAtOrAfter(deadline);
+        if (due <= currentTick) {
+            due = currentTick + 1;
+        }
+        slots[due % slots.size()].push_back({key, due});
+        count++;
+    }
+
+    // Calls onExpired(key) for every timer whose deadline is at or before now.
+    // Callbacks run after the wheel has been updated, so they may schedule more.
+    template <typename Callback>
+    void advance(Clock::time_point now, Callback&& onExpired) {
+        std::vector<uint64_t> expired;
+        uint64_t nowTick = tickAtOrBefore(now);
+        for (; currentTick < nowTick && count > 0; ) {
+            ++currentTick;
+            auto& slot = slots[currentTick % slots.size()];
+            for (size_t i = 0; i < slot.size(); ) {
+                if (slot[i].due <= currentTick) {
+                    expired.push_back(slot[i].key);
+                    slot[i] = slot.back();
+                    slot.pop_back();
+                    count--;
+                } else {
+                    ++i;
+                }
+            }
+        }
+        if (currentTick < nowTick) {
+            currentTick = nowTick;
+        }
+        for (uint64_t key : expired) {
+            onExpired(key);
+        }
+    }
+
+    // How long a poll may sleep before advance() has work; empty when no timer is set
+    std::optional<Clock::duration> timeUntilNext(Clock::time_point now) const {
+        if (count == 0) {
+            return std::nullopt;
+        }
+        uint64_t next = UINT64_MAX;
+        for (size_t i = 1; i <= slots.size() && next == UINT64_MAX; ++i) {
+            for (const auto& entry : slots[(currentTick + i) % slots.size()]) {
+                if (entry.due == currentTick + i) {
+                    next = entry.due;
+                    break;
+                }
+            }
+        }
+        if (next == UINT64_MAX) {
+            // Everything is more than a revolution away
+            for (const auto& slot : slots) {
+                for (const auto& entry : slot) {
+                    next = entry.due < next ? entry.due : next;
+                }
+            }
+        }
+        Clock::time_point due = origin + tick * static_cast<Clock::rep>(next);
+        return due > now ? due - now : Clock::duration::zero();
+    }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+private:
+    struct Entry {
+        uint64_t key;
+        uint64_t due;
+    };
+
+    uint64_t tickAtOrAfter(Clock::time_point time) const {
+        if (time <= origin) {
+            return 0;
+        }
+        return static_cast<uint64_t>((time - origin + tick - Clock::duration(1)) / tick);
+    }
+
+    uint64_t tickAtOrBefore(Clock::time_point time) const {
+        return time <= origin ? 0 : static_cast<uint64_t>((time - origin) / tick);
+    }
+
+    std::vector<std::vector<Entry>> slots;
+    Clock::duration tick;
+    Clock::time_point origin;
+    uint64_t currentTick = 0;
+    size_t count = 0;
+};
+
+} // namespace amazons
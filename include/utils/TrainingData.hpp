@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace amazons {
+
+// One labelled position. Stored on disk as RECORD_SIZE little-endian bytes:
+//   u64 arrows, u64 white amazons, u64 black amazons (square = row * 8 + col),
+//   i16 score, u8 ply, u8 flags
+struct TrainingRecord {
+    uint64_t arrows = 0;
+    uint64_t white = 0;
+    uint64_t black = 0;
+    int16_t score = 0;              // search value for the side to move, -1000 (lost) .. 1000 (won)
+    uint8_t ply = 0;
+    bool blackToMove = false;
+    bool sideToMoveWon = false;     // final game result from the side to move's point of view
+    bool hasScore = false;          // false when the engine reports no value
+
+    static constexpr size_t RECORD_SIZE = 28;
+
+    void encode(unsigned char* out) const;
+    static TrainingRecord decode(const unsigned char* in);
+
+    bool operator==(const TrainingRecord& other) const;
+};
+
+// Streams records to a file from any number of producer threads. Producers hand
+// over whole batches (typically one game); a single writer thread encodes them
+// into a large buffer and writes it out. At most maxPendingBatches batches wait
+// in memory, after which submit() blocks, so memory stays flat however long the
+// run is.
+class TrainingDataWriter {
+public:
+    static constexpr char MAGIC[8] = {'A', 'M', 'Z', 'T', 'R', 'N', '0', '1'};
+
+    explicit TrainingDataWriter(const std::string& path, size_t maxPendingBatches = 64);
+    ~TrainingDataWriter();
+
+    TrainingDataWriter(const TrainingDataWriter&) = delete;
+    TrainingDataWriter& operator=(const TrainingDataWriter&) = delete;
+
+    void submit(std::vector<TrainingRecord> batch);
+
+    // Flushes everything submitted so far and closes the file; throws on write errors
+    void close();
+
+    uint64_t recordsWritten() const;
+
+private:
+    void writerLoop();
+
+    std::FILE* file;
+    size_t maxPending;
+    std::deque<std::vector<TrainingRecord>> pending;
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty;
+    std::condition_variable notFull;
+    bool closing = false;
+    bool failed = false;
+    uint64_t written = 0;
+    std::thread writer;
+};
+
+// Reads a whole file back; for tests and small tools
+std::vector<TrainingRecord> readTrainingData(const std::string& path);
+
+} // namespace amazons
@@ -2,6 +2,8 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <limits>
+#include <stdexcept>
 
 namespace amazons {
 
@@ -1,4 +1,5 @@
 #include "ai/BotProcess.hpp"
+#include "utils/LineBuffer.hpp"
 #include <iostream>
 #include <stdexcept>
 #include <cstdio>
@@ -6,6 +7,9 @@
 #include <array>
 #include <thread>
 #include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -16,10 +20,80 @@
 #include <fcntl.h>
 #include <signal.h>
 #include <errno.h>
+#include <poll.h>
+#include <spawn.h>
+#include <sys/resource.h>
+
+extern char** environ;
 #endif
 
 namespace amazons {
 
+#ifndef _WIN32
+namespace {
+    // Reads a small file into a NUL-terminated buffer
+    bool readProcFile(const char* path, char* buffer, size_t size) {
+        int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        ssize_t length = ::read(fd, buffer, size - 1);
+        ::close(fd);
+        if (length <= 0) {
+            return false;
+        }
+        buffer[length] = '\0';
+        return true;
+    }
+
+    // Both ends close-on-exec, so a bot spawned by another thread does not
+    // inherit them and keep this bot's pipes open
+    bool makePipe(int fds[2]) {
+#ifdef __linux__
+        // Atomic: no spawn can slip in between creating and marking the ends
+        return pipe2(fds, O_CLOEXEC) == 0;
+#else
+        if (pipe(fds) == -1) {
+            return false;
+        }
+        if (fcntl(fds[0], F_SETFD, FD_CLOEXEC) == -1 || fcntl(fds[1], F_SETFD, FD_CLOEXEC) == -1) {
+            ::close(fds[0]);
+            ::close(fds[1]);
+            fds[0] = fds[1] = -1;
+            return false;
+        }
+        return true;
+#endif
+    }
+
+    // posix_spawn has no hook to run setrlimit in the child, so the caps are set
+    // from outside right after the spawn. The bot gets a few instructions in
+    // before that, which no meaningful limit can be sensitive to.
+    bool applyLimits(pid_t pid, const BotProcess::Limits& limits) {
+#ifdef __linux__
+        if (limits.cpuSeconds > 0.0) {
+            // SIGXCPU at the soft limit, SIGKILL a second later
+            rlim_t seconds = static_cast<rlim_t>(std::ceil(limits.cpuSeconds));
+            struct rlimit cpu {seconds, seconds + 1};
+            if (prlimit(pid, RLIMIT_CPU, &cpu, nullptr) != 0) {
+                return false;
+            }
+        }
+        if (limits.memoryBytes > 0) {
+            struct rlimit memory {limits.memoryBytes, limits.memoryBytes};
+            if (prlimit(pid, RLIMIT_AS, &memory, nullptr) != 0) {
+                return false;
+            }
+        }
+#else
+        (void)pid;
+        (void)limits;
+#endif
+        return true;
+    }
+}
+#endif
+
 // Platform-specific implementation
 struct BotProcess::Impl {
 #ifdef _WIN32
@@ -30,7 +104,14 @@ struct BotProcess::Impl {
     pid_t pid = -1;
     int stdinPipe[2] = {-1, -1};
     int stdoutPipe[2] = {-1, -1};
+    Usage exitUsage;        // from wait4 once the process has been reaped
 #endif
+    LineBuffer output;      // bot output read so far but not yet returned as lines
+    bool outputClosed = false;
+    
+    // Start of the turn being answered, for MoveStats
+    std::chrono::steady_clock::time_point turnStart;
+    Usage turnStartUsage;
     
     ~Impl() {
         cleanup();
@@ -49,12 +130,126 @@ struct BotProcess::Impl {
         if (stdinPipe[1] != -1) close(stdinPipe[1]);
         if (stdoutPipe[0] != -1) close(stdoutPipe[0]);
         if (stdoutPipe[1] != -1) close(stdoutPipe[1]);
+        stdinPipe[0] = stdinPipe[1] = stdoutPipe[0] = stdoutPipe[1] = -1;
         if (pid > 0) {
-            kill(pid, SIGTERM);
-            waitpid(pid, nullptr, 0);
+            // SIGKILL so that reaping can never hang on a bot that ignores SIGTERM
+            kill(pid, SIGKILL);
+            reap(0);
+        }
+#endif
+        output.clear();
+        outputClosed = false;
+    }
+
+#ifndef _WIN32
+    // Collects the exit status and final resource usage; false if still running
+    bool reap(int options) {
+        struct rusage usage {};
+        int status = 0;
+        pid_t result = wait4(pid, &status, options, &usage);
+        if (result == 0) {
+            return false;
+        }
+        if (result == pid) {
+            exitUsage.userSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+            exitUsage.systemSeconds = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#ifdef __APPLE__
+            exitUsage.peakRssBytes = static_cast<size_t>(usage.ru_maxrss);
+#else
+            exitUsage.peakRssBytes = static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+        }
+        // Forget the pid so cleanup never signals a recycled one
+        pid = -1;
+        return true;
+    }
+
+    Usage currentUsage() const {
+        if (pid <= 0) {
+            return exitUsage;
+        }
+        Usage usage;
+#ifdef __linux__
+        // Plain read() into a stack buffer: this runs twice per move
+        char text[4096];
+        std::string prefix = "/proc/" + std::to_string(pid);
+        // utime and stime are fields 14 and 15; the command name before them may contain spaces
+        if (readProcFile((prefix + "/stat").c_str(), text, sizeof(text))) {
+            const char* field = std::strrchr(text, ')');
+            for (int index = 2; field && index < 14; ++index) {
+                field = std::strchr(field + 1, ' ');
+            }
+            if (field) {
+                char* end = nullptr;
+                unsigned long long userTicks = std::strtoull(field, &end, 10);
+                unsigned long long systemTicks = std::strtoull(end, nullptr, 10);
+                double ticksPerSecond = static_cast<double>(sysconf(_SC_CLK_TCK));
+                usage.userSeconds = userTicks / ticksPerSecond;
+                usage.systemSeconds = systemTicks / ticksPerSecond;
+            }
+        }
+        if (readProcFile((prefix + "/status").c_str(), text, sizeof(text))) {
+            if (const char* peak = std::strstr(text, "VmHWM:")) {
+                usage.peakRssBytes = static_cast<size_t>(std::strtoull(peak + 6, nullptr, 10)) * 1024;
+            }
         }
 #endif
+        return usage;
+    }
+
+    // Writes everything, resuming after partial writes and signals
+    bool writeAll(const std::string& text) {
+        const char* next = text.data();
+        size_t left = text.size();
+        while (left > 0) {
+            ssize_t written = ::write(stdinPipe[1], next, left);
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            next += written;
+            left -= static_cast<size_t>(written);
+        }
+        return true;
+    }
+
+    // Waits for bot output until the deadline; false on timeout or end of output
+    bool fill(std::chrono::steady_clock::time_point deadline) {
+        while (!outputClosed) {
+            auto space = output.writeSpace();
+            ssize_t bytesRead = ::read(stdoutPipe[0], space.first, space.second);
+            if (bytesRead > 0) {
+                output.commit(static_cast<size_t>(bytesRead));
+                return true;
+            }
+            if (bytesRead == 0) {
+                outputClosed = true;
+                break;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                outputClosed = true;
+                break;
+            }
+
+            // Round up so poll never wakes just before the deadline
+            double remaining = std::chrono::duration<double, std::milli>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (remaining <= 0.0) {
+                return false;
+            }
+            pollfd descriptor{stdoutPipe[0], POLLIN, 0};
+            if (::poll(&descriptor, 1, static_cast<int>(std::ceil(remaining))) < 0 && errno != EINTR) {
+                outputClosed = true;
+            }
+        }
+        return false;
     }
+#endif
 };
 
 BotProcess::BotProcess(const std::string& botPath)
@@ -100,36 +295,37 @@ bool BotProcess::start() {
     CloseHandle(stdoutWrite);
     
 #else
-    // Unix implementation
-    if (pipe(impl->stdinPipe) == -1 || pipe(impl->stdoutPipe) == -1) {
+    // Unix implementation. Our pipe ends are close-on-exec, so a bot only ever
+    // inherits its own stdin and stdout, never the pipes of other bots.
+    if (!makePipe(impl->stdinPipe) || !makePipe(impl->stdoutPipe)) {
+        impl->cleanup();
         return false;
     }
     
-    impl->pid = fork();
-    if (impl->pid == 0) {
-        // Child process
-        close(impl->stdinPipe[1]); // Close write end of stdin
-        close(impl->stdoutPipe[0]); // Close read end of stdout
-        
-        dup2(impl->stdinPipe[0], STDIN_FILENO);
-        dup2(impl->stdoutPipe[1], STDOUT_FILENO);
-        
-        execl(botPath.c_str(), botPath.c_str(), nullptr);
-        exit(1); // exec failed
-    } else if (impl->pid > 0) {
-        // Parent process
-        close(impl->stdinPipe[0]); // Close read end of stdin
-        close(impl->stdoutPipe[1]); // Close write end of stdout
-        
-        // Set non-blocking mode for stdout
-        int flags = fcntl(impl->stdoutPipe[0], F_GETFL, 0);
-        fcntl(impl->stdoutPipe[0], F_SETFL, flags | O_NONBLOCK);
-    } else {
-        // Fork failed
-        close(impl->stdinPipe[0]);
-        close(impl->stdinPipe[1]);
-        close(impl->stdoutPipe[0]);
-        close(impl->stdoutPipe[1]);
+    // posix_spawn avoids copying our page tables the way fork() would
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, impl->stdinPipe[0], STDIN_FILENO);
+    posix_spawn_file_actions_adddup2(&actions, impl->stdoutPipe[1], STDOUT_FILENO);
+    char* argv[] = {const_cast<char*>(botPath.c_str()), nullptr};
+    int error = posix_spawn(&impl->pid, botPath.c_str(), &actions, nullptr, argv, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if (error != 0) {
+        impl->pid = -1;
+        impl->cleanup();
+        return false;
+    }
+    impl->exitUsage = Usage();
+    
+    close(impl->stdinPipe[0]); // Close read end of stdin
+    close(impl->stdoutPipe[1]); // Close write end of stdout
+    impl->stdinPipe[0] = impl->stdoutPipe[1] = -1;
+    
+    // Set non-blocking mode for stdout
+    int flags = fcntl(impl->stdoutPipe[0], F_GETFL, 0);
+    if (flags == -1 || fcntl(impl->stdoutPipe[0], F_SETFL, flags | O_NONBLOCK) == -1 ||
+        !applyLimits(impl->pid, limits)) {
+        impl->cleanup();
         return false;
     }
 #endif
@@ -153,8 +349,7 @@ bool BotProcess::isRunning() const {
     return exitCode == STILL_ACTIVE;
 #else
     if (impl->pid <= 0) return false;
-    int status;
-    return waitpid(impl->pid, &status, WNOHANG) == 0;
+    return !impl->reap(WNOHANG);
 #endif
 }
 
@@ -163,9 +358,9 @@ bool BotProcess::sendFirstTurn(const std::vector<std::string>& moveHistory) {
     
     // For Amazons simple interaction protocol
     // First line: turn_id (1 for first turn)
-    // Then 2*turn_id - 1 lines of move history
+    // Then 2*turn_id - 1 lines of move history, requests and responses alternating
     // For first turn: 1 line of move history which is "-1 -1 -1 -1 -1 -1" for black player
-    std::string input = "1\n";
+    std::string input = std::to_string(moveHistory.empty() ? 1 : (moveHistory.size() + 1) / 2) + "\n";
     
     if (moveHistory.empty()) {
         // First move of the game, bot is black
@@ -177,38 +372,49 @@ bool BotProcess::sendFirstTurn(const std::vector<std::string>& moveHistory) {
         }
     }
     
-#ifdef _WIN32
-    DWORD written;
-    return WriteFile(impl->stdinWrite, input.c_str(), input.size(), &written, NULL) && written == input.size();
-#else
-    ssize_t written = write(impl->stdinPipe[1], input.c_str(), input.size());
-    return written == static_cast<ssize_t>(input.size());
-#endif
+    return sendInput(input);
 }
 
 bool BotProcess::sendTurn(const std::string& opponentMove) {
-    if (!isRunning() || !keepRunningMode) return false;
+    if (!keepRunningMode) return false;
+    return sendInput(opponentMove + "\n");
+}
+
+bool BotProcess::sendInput(const std::string& input) {
+    if (!isRunning()) return false;
     
-    std::string input = opponentMove + "\n";
+    impl->turnStart = std::chrono::steady_clock::now();
+    impl->turnStartUsage = getUsage();
     
 #ifdef _WIN32
     DWORD written;
     return WriteFile(impl->stdinWrite, input.c_str(), input.size(), &written, NULL) && written == input.size();
 #else
-    ssize_t written = write(impl->stdinPipe[1], input.c_str(), input.size());
-    return written == static_cast<ssize_t>(input.size());
+    return impl->writeAll(input);
 #endif
 }
 
 std::string BotProcess::readMove(double timeoutSeconds) {
-    return readLine(timeoutSeconds);
+    std::string line = readLine(timeoutSeconds);
+    if (!line.empty()) {
+        Usage now = getUsage();
+        lastMoveStats.wallSeconds =
+            std::chrono::duration<double>(std::chrono::steady_clock::now() - impl->turnStart).count();
+        lastMoveStats.userSeconds = now.userSeconds - impl->turnStartUsage.userSeconds;
+        lastMoveStats.systemSeconds = now.systemSeconds - impl->turnStartUsage.systemSeconds;
+        lastMoveStats.peakRssBytes = now.peakRssBytes;
+    }
+    return line;
 }
 
 std::string BotProcess::readKeepRunning(double timeoutSeconds) {
-    return readLine(timeoutSeconds);
+    std::string line = readLine(timeoutSeconds);
+    keepRunningMode = line == ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<";
+    return line;
 }
 
 std::string BotProcess::readLine(double timeoutSeconds) {
+#ifdef _WIN32
     if (!isRunning()) return "";
     
     std::string line;
@@ -216,7 +422,6 @@ std::string BotProcess::readLine(double timeoutSeconds) {
     
     while (std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count() < timeoutSeconds) {
         char ch;
-#ifdef _WIN32
         DWORD bytesRead;
         if (ReadFile(impl->stdoutRead, &ch, 1, &bytesRead, NULL) && bytesRead == 1) {
             if (ch == '\n') break;
@@ -224,23 +429,62 @@ std::string BotProcess::readLine(double timeoutSeconds) {
         } else {
             std::this_thread::sleep_for(std::chrono::milliseconds(10));
         }
+    }
+    
+    return line;
 #else
-        ssize_t bytesRead = ::read(impl->stdoutPipe[0], &ch, 1);
-        if (bytesRead == 1) {
-            if (ch == '\n') break;
-            line += ch;
-        } else if (bytesRead == 0) {
-            // EOF
-            break;
-        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        } else {
-            break;
+    // Lines the bot already wrote are returned even if it has exited since
+    if (impl->stdoutPipe[0] == -1) return "";
+
+    auto deadline = std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(timeoutSeconds));
+    std::string line;
+    while (!impl->output.popLine(line)) {
+        if (!impl->fill(deadline)) {
+            // A last unterminated line still counts once the bot has closed its output
+            return impl->outputClosed ? impl->output.takeAll() : "";
         }
-#endif
     }
-    
     return line;
+#endif
+}
+
+bool BotProcess::readAvailableLine(std::string& line) {
+#ifdef _WIN32
+    (void)line;
+    return false;
+#else
+    bool found = impl->output.popLine(line);
+    // A deadline in the past makes fill() read what is there and never wait
+    while (!found && impl->stdoutPipe[0] != -1 && impl->fill(std::chrono::steady_clock::time_point())) {
+        found = impl->output.popLine(line);
+    }
+    if (!found && impl->outputClosed && !impl->output.empty()) {
+        line = impl->output.takeAll();
+        found = true;
+    }
+    if (found && line == ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<") {
+        keepRunningMode = true;
+    }
+    return found;
+#endif
+}
+
+bool BotProcess::outputEnded() const {
+#ifdef _WIN32
+    return !isRunning();
+#else
+    return impl->outputClosed && impl->output.empty();
+#endif
+}
+
+int BotProcess::outputHandle() const {
+#ifdef _WIN32
+    return -1;
+#else
+    return impl->stdoutPipe[0];
+#endif
 }
 
 std::string BotProcess::getBotPath() const {
@@ -251,4 +495,26 @@ bool BotProcess::isKeepRunning() const {
     return keepRunningMode;
 }
 
+void BotProcess::setLimits(const Limits& newLimits) {
+    limits = newLimits;
+}
+
+const BotProcess::Limits& BotProcess::getLimits() const {
+    return limits;
+}
+
+BotProcess::Usage BotProcess::getUsage() const {
+#ifdef _WIN32
+    return Usage();
+#else
+    // Reap first so a bot that just exited reports its final figures
+    isRunning();
+    return impl->currentUsage();
+#endif
+}
+
+const BotProcess::MoveStats& BotProcess::getLastMoveStats() const {
+    return lastMoveStats;
+}
+
 } // namespace amazons
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include "ai/BotProcessPool.hpp"
+#include <chrono>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    // Pause before retrying when the system refuses to start a process
+    constexpr std::chrono::milliseconds START_RETRY_DELAY(100);
+}
+
+BotProcessPool::BotProcessPool(const std::string& botPath, size_t idleTarget)
+    : botPath(botPath), idleTarget(idleTarget) {
+    if (botPath.empty()) {
+        throw std::invalid_argument("BotProcessPool: empty bot path");
+    }
+    replenisher = std::thread(&BotProcessPool::replenishLoop, this);
+}
+
+BotProcessPool::~BotProcessPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    replenisher.join();
+    // Idle processes are stopped by their destructors
+}
+
+std::unique_ptr<BotProcess> BotProcessPool::acquire() {
+    std::unique_ptr<BotProcess> process;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while (!idle.empty()) {
+            std::unique_ptr<BotProcess> candidate = std::move(idle.front());
+            idle.pop_front();
+            if (candidate->isRunning()) {
+                process = std::move(candidate);
+                break;
+            }
+            discarded++;
+        }
+    }
+    wake.notify_all();
+
+    if (!process) {
+        process = startProcess();
+        if (!process) {
+            throw std::runtime_error("Failed to start bot process " + botPath);
+        }
+    }
+    return process;
+}
+
+size_t BotProcessPool::idleCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return idle.size();
+}
+
+uint64_t BotProcessPool::processesStarted() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return started;
+}
+
+uint64_t BotProcessPool::processesDiscarded() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return discarded;
+}
+
+std::unique_ptr<BotProcess> BotProcessPool::startProcess() {
+    auto process = std::make_unique<BotProcess>(botPath);
+    if (!process->start()) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    started++;
+    return process;
+}
+
+void BotProcessPool::replenishLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || idle.size() < idleTarget; });
+        if (stopping) {
+            return;
+        }
+
+        // Fork and exec outside the lock so acquire() never waits on it
+        lock.unlock();
+        std::unique_ptr<BotProcess> process = startProcess();
+        lock.lock();
+
+        if (process) {
+            idle.push_back(std::move(process));
+        } else {
+            wake.wait_for(lock, START_RETRY_DELAY, [this]() { return stopping; });
+        }
+    }
+}
+
+} // namespace amazons
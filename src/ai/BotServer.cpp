@@ -0,0 +1,418 @@
+#include "ai/BotServer.hpp"
+#include "ai/BotzoneProtocol.hpp"
+#include "core/GameState.hpp"
+#include "utils/TimerWheel.hpp"
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <unistd.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+namespace amazons {
+
+const char* BotServer::reasonName(EndReason reason) {
+    switch (reason) {
+        case EndReason::NO_MOVES: return "no-moves";
+        case EndReason::ILLEGAL_MOVE: return "illegal";
+        case EndReason::TIMEOUT: return "timeout";
+        case EndReason::CRASH: return "crash";
+    }
+    return "unknown";
+}
+
+#ifdef _WIN32
+
+BotServer::Result BotServer::run(const Options&, const std::function<void(const GameResult&)>&) {
+    throw std::runtime_error("BotServer needs POSIX pipes");
+}
+
+#else
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // Readiness of many descriptors at once, each tagged with a caller token
+    class Poller {
+    public:
+#ifdef __linux__
+        Poller() : epollFd(epoll_create1(EPOLL_CLOEXEC)) {
+            if (epollFd < 0) {
+                throw std::runtime_error("epoll_create1 failed");
+            }
+        }
+        ~Poller() { close(epollFd); }
+
+        void add(int fd, uint64_t token) {
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.u64 = token;
+            if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+                throw std::runtime_error("epoll_ctl failed");
+            }
+        }
+
+        void remove(int fd) { epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr); }
+
+        void wait(int timeoutMs, std::vector<uint64_t>& ready) {
+            epoll_event events[256];
+            ready.clear();
+            int count = epoll_wait(epollFd, events, 256, timeoutMs);
+            for (int i = 0; i < count; ++i) {
+                ready.push_back(events[i].data.u64);
+            }
+        }
+
+    private:
+        int epollFd;
+#else
+        void add(int fd, uint64_t token) {
+            position[fd] = descriptors.size();
+            descriptors.push_back({fd, POLLIN, 0});
+            tokens.push_back(token);
+        }
+
+        void remove(int fd) {
+            auto found = position.find(fd);
+            if (found == position.end()) {
+                return;
+            }
+            size_t index = found->second;
+            position.erase(found);
+            if (index + 1 != descriptors.size()) {
+                descriptors[index] = descriptors.back();
+                tokens[index] = tokens.back();
+                position[descriptors[index].fd] = index;
+            }
+            descriptors.pop_back();
+            tokens.pop_back();
+        }
+
+        void wait(int timeoutMs, std::vector<uint64_t>& ready) {
+            ready.clear();
+            if (::poll(descriptors.data(), descriptors.size(), timeoutMs) <= 0) {
+                return;
+            }
+            for (size_t i = 0; i < descriptors.size(); ++i) {
+                if (descriptors[i].revents != 0) {
+                    ready.push_back(tokens[i]);
+                }
+            }
+        }
+
+    private:
+        std::vector<pollfd> descriptors;
+        std::vector<uint64_t> tokens;
+        std::unordered_map<int, size_t> position;
+#endif
+    };
+
+    const char* const KEEP_RUNNING = BotzoneProtocol::KEEP_RUNNING;
+
+    struct Side {
+        std::unique_ptr<BotProcess> process;
+        bool fresh = true;              // has not answered a turn yet
+        bool awaitingMarker = false;    // answered, keep-running marker not seen yet
+        double cpuSeconds = 0.0;        // from processes already retired
+    };
+
+    struct Game {
+        uint64_t id = 0;
+        int bots[2] = {0, 0};           // [0] plays Black
+        GameState state;
+        std::vector<std::string> lines; // moves so far in Botzone notation
+        Side sides[2];
+        int toMove = 0;
+        uint64_t turn = 0;              // bumped per turn so stale timers can be told apart
+        Clock::time_point started;
+    };
+
+    std::string csvField(const std::string& text) {
+        std::string quoted = "\"";
+        for (char c : text) {
+            quoted += c;
+            if (c == '"') {
+                quoted += '"';
+            }
+        }
+        return quoted + "\"";
+    }
+
+    class Server {
+    public:
+        Server(const BotServer::Options& options, const std::function<void(const BotServer::GameResult&)>& progress)
+            : options(options), progress(progress) {
+            result.wins.assign(options.bots.size(), 0);
+            result.played.assign(options.bots.size(), 0);
+            for (size_t i = 0; i < options.bots.size(); ++i) {
+                for (size_t j = i + 1; j < options.bots.size(); ++j) {
+                    for (int g = 0; g < options.gamesPerPair; ++g) {
+                        int a = static_cast<int>(i), b = static_cast<int>(j);
+                        pending.push_back(g % 2 == 0 ? std::make_pair(a, b) : std::make_pair(b, a));
+                    }
+                }
+            }
+            if (!options.resultsPath.empty()) {
+                results.open(options.resultsPath);
+                if (!results.is_open()) {
+                    throw std::runtime_error("Could not open results file " + options.resultsPath);
+                }
+                results << "black,white,winner,reason,plies,seconds,black_cpu,white_cpu,moves\n" << std::flush;
+            }
+        }
+
+        BotServer::Result run() {
+            auto start = Clock::now();
+            std::vector<uint64_t> ready;
+            while (!pending.empty() || !games.empty()) {
+                while (!pending.empty() && games.size() < options.maxConcurrentGames) {
+                    auto pairing = pending.front();
+                    pending.pop_front();
+                    startGame(pairing.first, pairing.second);
+                }
+                if (games.empty()) {
+                    continue;
+                }
+
+                poller.wait(pollTimeout(), ready);
+                for (uint64_t token : ready) {
+                    onReadable(token >> 1, static_cast<int>(token & 1));
+                }
+                timers.advance(Clock::now(), [this](uint64_t key) { onTimer(key); });
+            }
+            result.elapsedSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+            return result;
+        }
+
+    private:
+        int pollTimeout() const {
+            auto wait = timers.timeUntilNext(Clock::now());
+            if (!wait) {
+                return 1000;
+            }
+            // Round up: waking a little early would only mean a second wait
+            double ms = std::ceil(std::chrono::duration<double, std::milli>(*wait).count());
+            return ms > 1000.0 ? 1000 : static_cast<int>(ms);
+        }
+
+        void startGame(int black, int white) {
+            auto game = std::make_unique<Game>();
+            game->id = nextId++;
+            game->bots[0] = black;
+            game->bots[1] = white;
+            game->started = Clock::now();
+            Game& ref = *game;
+            games[ref.id] = std::move(game);
+            // Both start now so the second mover's startup overlaps the first move
+            spawn(ref, 0);
+            spawn(ref, 1);
+            beginTurn(ref);
+        }
+
+        bool spawn(Game& game, int side) {
+            Side& s = game.sides[side];
+            retire(game, side);
+            auto process = std::make_unique<BotProcess>(options.bots[game.bots[side]]);
+            process->setLimits(options.limits);
+            if (!process->start()) {
+                return false;
+            }
+            poller.add(process->outputHandle(), (game.id << 1) | static_cast<uint64_t>(side));
+            s.process = std::move(process);
+            s.fresh = true;
+            s.awaitingMarker = false;
+            return true;
+        }
+
+        // Stops a side's process and books its CPU time
+        void retire(Game& game, int side) {
+            Side& s = game.sides[side];
+            if (!s.process) {
+                return;
+            }
+            if (s.process->outputHandle() >= 0) {
+                poller.remove(s.process->outputHandle());
+            }
+            s.process->stop();
+            BotProcess::Usage usage = s.process->getUsage();
+            s.cpuSeconds += usage.userSeconds + usage.systemSeconds;
+            s.process.reset();
+        }
+
+        // The bot's view of the game: requests and responses alternating, Black's
+        // first request being the "-1" placeholder
+        std::vector<std::string> history(const Game& game, int side) const {
+            std::vector<std::string> lines;
+            if (side == 0) {
+                lines.push_back("-1 -1 -1 -1 -1 -1");
+            }
+            lines.insert(lines.end(), game.lines.begin(), game.lines.end());
+            return lines;
+        }
+
+        void beginTurn(Game& game) {
+            const int side = game.toMove;
+            if (game.state.isGameOver()) {
+                finish(game, 1 - side, BotServer::EndReason::NO_MOVES);
+                return;
+            }
+
+            Side& s = game.sides[side];
+            bool sent = false;
+            bool reusable = s.process && !s.fresh && !s.awaitingMarker &&
+                            s.process->isKeepRunning() && s.process->isRunning();
+            if (reusable) {
+                sent = s.process->sendTurn(game.lines.back());
+            } else {
+                if (!s.process || !s.fresh || !s.process->isRunning()) {
+                    spawn(game, side);
+                }
+                sent = s.process && s.process->sendFirstTurn(history(game, side));
+            }
+            if (!sent) {
+                finish(game, 1 - side, BotServer::EndReason::CRASH);
+                return;
+            }
+
+            game.turn++;
+            double allowance = options.turnSeconds + (s.fresh ? options.startupSeconds : 0.0);
+            auto deadline = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(allowance));
+            timers.schedule((game.id << 10) | (game.turn & 1023), deadline);
+        }
+
+        void onReadable(uint64_t id, int side) {
+            std::string line;
+            while (true) {
+                auto found = games.find(id);
+                if (found == games.end()) {
+                    return;
+                }
+                Game& game = *found->second;
+                BotProcess* process = game.sides[side].process.get();
+                if (!process) {
+                    return;
+                }
+                if (process->readAvailableLine(line)) {
+                    handleLine(game, side, line);
+                    continue;
+                }
+                if (process->outputEnded()) {
+                    if (side == game.toMove) {
+                        finish(game, 1 - side, BotServer::EndReason::CRASH);
+                    } else {
+                        // A bot without keep-running exits after each move
+                        retire(game, side);
+                    }
+                }
+                return;
+            }
+        }
+
+        void handleLine(Game& game, int side, const std::string& line) {
+            Side& s = game.sides[side];
+            if (line == KEEP_RUNNING) {
+                s.awaitingMarker = false;
+                return;
+            }
+            if (side != game.toMove) {
+                return;     // stray output between turns
+            }
+
+            std::optional<Move> move;
+            try {
+                move = BotzoneProtocol::parseMove(line);
+            } catch (const std::invalid_argument&) {
+            }
+            // The game is not over, so "-1 ..." is as wrong as a malformed line
+            if (!move || !game.state.isValidMove(*move)) {
+                finish(game, 1 - side, BotServer::EndReason::ILLEGAL_MOVE);
+                return;
+            }
+            game.state.makeMove(*move);
+            game.lines.push_back(BotzoneProtocol::formatMove(*move));
+            s.fresh = false;
+            s.awaitingMarker = true;
+            game.toMove = 1 - side;
+            beginTurn(game);
+        }
+
+        void onTimer(uint64_t key) {
+            auto found = games.find(key >> 10);
+            if (found == games.end()) {
+                return;
+            }
+            Game& game = *found->second;
+            if ((game.turn & 1023) == (key & 1023)) {
+                finish(game, 1 - game.toMove, BotServer::EndReason::TIMEOUT);
+            }
+        }
+
+        void finish(Game& game, int winnerSide, BotServer::EndReason reason) {
+            retire(game, 0);
+            retire(game, 1);
+
+            BotServer::GameResult record;
+            record.black = game.bots[0];
+            record.white = game.bots[1];
+            record.winner = game.bots[winnerSide];
+            record.reason = reason;
+            record.plies = static_cast<int>(game.lines.size());
+            record.seconds = std::chrono::duration<double>(Clock::now() - game.started).count();
+            record.blackCpuSeconds = game.sides[0].cpuSeconds;
+            record.whiteCpuSeconds = game.sides[1].cpuSeconds;
+            for (size_t i = 0; i < game.lines.size(); ++i) {
+                record.moves += (i ? ";" : "") + game.lines[i];
+            }
+
+            result.wins[record.winner]++;
+            result.played[record.black]++;
+            result.played[record.white]++;
+            if (results.is_open()) {
+                // Flushed per game so an interrupted run keeps what it finished
+                results << csvField(options.bots[record.black]) << ',' << csvField(options.bots[record.white]) << ','
+                        << csvField(options.bots[record.winner]) << ',' << BotServer::reasonName(reason) << ','
+                        << record.plies << ',' << record.seconds << ',' << record.blackCpuSeconds << ','
+                        << record.whiteCpuSeconds << ',' << csvField(record.moves) << '\n' << std::flush;
+            }
+            result.games.push_back(record);
+            games.erase(game.id);
+            if (progress) {
+                progress(result.games.back());
+            }
+        }
+
+        const BotServer::Options& options;
+        const std::function<void(const BotServer::GameResult&)>& progress;
+        std::deque<std::pair<int, int>> pending;
+        std::unordered_map<uint64_t, std::unique_ptr<Game>> games;
+        Poller poller;
+        TimerWheel timers;
+        std::ofstream results;
+        BotServer::Result result;
+        uint64_t nextId = 0;
+    };
+}
+
+BotServer::Result BotServer::run(const Options& options, const std::function<void(const GameResult&)>& progress) {
+    if (options.bots.size() < 2) {
+        throw std::invalid_argument("BotServer needs at least two bots");
+    }
+    if (options.maxConcurrentGames == 0) {
+        throw std::invalid_argument("BotServer needs room for at least one game");
+    }
+    Server server(options, progress);
+    return server.run();
+}
+
+#endif
+
+} // namespace amazons
@@ -1,9 +1,11 @@
 #include "ai/BotzoneAI.hpp"
 #include "ai/BotProcess.hpp"
+#include "ai/BotProcessPool.hpp"
+#include "ai/BotzoneProtocol.hpp"
 #include "core/GameState.hpp"
 #include "core/Move.hpp"
 #include "core/Position.hpp"
-#include <sstream>
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 
@@ -16,51 +18,44 @@ BotzoneAI::BotzoneAI(const std::string& botPath)
     }
 }
 
+BotzoneAI::BotzoneAI(std::shared_ptr<BotProcessPool> pool)
+    : keepRunningMode(false), aiColor(Player::WHITE) {
+    setProcessPool(std::move(pool));
+}
+
 BotzoneAI::~BotzoneAI() {
     // BotProcess will clean up in its destructor
 }
 
 Move BotzoneAI::getBestMove(const GameState& gameState) {
-    if (botPath.empty() || !botProcess) {
+    if (!isBotAvailable()) {
         throw std::runtime_error("BotzoneAI: No bot path configured");
     }
     
     try {
-        // Get move history
-        std::vector<std::string> history = getMoveHistory(gameState);
-        
-        // Check if we need to start or restart the bot
-        if (!botProcess->isRunning() || !keepRunningMode) {
-            // Start bot and send first turn
-            if (!botProcess->start()) {
+        const std::vector<Move>& history = gameState.getMoveHistory();
+        // Check if we need to start or restart the bot. A running bot can only be
+        // told one more move; a new game, an undo or a skipped turn replays everything.
+        if (!botProcess || !botProcess->isRunning() || !keepRunningMode || !extendsBotHistory(history)) {
+            // Start bot (or take a warm one from the pool) and replay the whole game to it
+            std::string input = convertGameStateToBotzoneInput(gameState);
+            if (processPool) {
+                botProcess = processPool->acquire();
+            } else if (!botProcess->start()) {     // stops the old process first
                 throw std::runtime_error("Failed to start bot process");
             }
-            
-            // Send first turn based on AI color
-            if (aiColor == Player::BLACK) {
-                // AI is black (moves first) - send (-1,-1,-1,-1,-1,-1) as first request
-                if (!botProcess->sendFirstTurn(history)) {
-                    throw std::runtime_error("Failed to send first turn to bot");
-                }
-            } else {
-                // AI is white (moves second) - need to send opponent's first move
-                // The history should contain opponent's first move
-                if (history.empty()) {
-                    throw std::runtime_error("AI is white but no opponent move in history");
-                }
-                if (!botProcess->sendTurn(history[0])) {
-                    throw std::runtime_error("Failed to send opponent's move to bot");
-                }
+            if (!botProcess->sendInput(input)) {
+                throw std::runtime_error("Failed to send first turn to bot");
             }
-            
             keepRunningMode = true;
         } else {
-            // Send opponent's last move (if any)
+            // A running bot only needs the opponent's last move
+            std::optional<Move> lastMove;
             if (!history.empty()) {
-                std::string lastMove = history.back();
-                if (!botProcess->sendTurn(lastMove)) {
-                    throw std::runtime_error("Failed to send turn to bot");
-                }
+                lastMove = history.back();
+            }
+            if (!botProcess->sendTurn(BotzoneProtocol::formatMove(lastMove))) {
+                throw std::runtime_error("Failed to send turn to bot");
             }
         }
         
@@ -72,27 +67,29 @@ Move BotzoneAI::getBestMove(const GameState& gameState) {
         
         // Read keep-running signal
         std::string keepSignal = botProcess->readKeepRunning(0.5);
-        if (keepSignal != ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<") {
+        if (keepSignal != BotzoneProtocol::KEEP_RUNNING) {
             // Bot didn't send keep-running signal, need to restart next time
             keepRunningMode = false;
         }
         
-        // Convert output to Move
         Move move = convertBotzoneOutputToMove(moveOutput);
-        
-        // Add move to history
-        moveHistory.push_back(moveOutput);
-        
+        botHistory = history;
+        botHistory.push_back(move);
         return move;
         
     } catch (const std::exception& e) {
         std::cerr << "BotzoneAI error: " << e.what() << std::endl;
         keepRunningMode = false;
+        if (processPool) {
+            // Kill a crashed or stuck bot now; the pool already has a replacement
+            botProcess.reset();
+        }
         throw;
     }
 }
 
 void BotzoneAI::setBotPath(const std::string& path) {
+    processPool.reset();
     botPath = path;
     if (!path.empty()) {
         botProcess = std::make_unique<BotProcess>(path);
@@ -100,19 +97,25 @@ void BotzoneAI::setBotPath(const std::string& path) {
         botProcess.reset();
     }
     keepRunningMode = false;
-    moveHistory.clear();
 }
 
 std::string BotzoneAI::getBotPath() const {
     return botPath;
 }
 
+void BotzoneAI::setProcessPool(std::shared_ptr<BotProcessPool> pool) {
+    processPool = std::move(pool);
+    botPath = processPool ? processPool->getBotPath() : "";
+    // The next move takes a fresh process from the pool
+    botProcess.reset();
+    keepRunningMode = false;
+}
+
 void BotzoneAI::setAIColor(Player color) {
     aiColor = color;
     // When AI color changes, we need to reset the bot process
     // because the protocol differs based on who moves first
     keepRunningMode = false;
-    moveHistory.clear();
 }
 
 Player BotzoneAI::getAIColor() const {
@@ -120,42 +123,47 @@ Player BotzoneAI::getAIColor() const {
 }
 
 bool BotzoneAI::isBotAvailable() const {
-    return !botPath.empty() && botProcess != nullptr;
+    return processPool != nullptr || (!botPath.empty() && botProcess != nullptr);
 }
 
-std::string BotzoneAI::convertGameStateToBotzoneInput(const GameState& /*gameState*/) const {
-    // This method builds the Botzone protocol input
-    // For now, return empty string - actual implementation will be in getBestMove
-    return "";
+BotProcess::MoveStats BotzoneAI::getLastMoveStats() const {
+    return botProcess ? botProcess->getLastMoveStats() : BotProcess::MoveStats();
 }
 
-Move BotzoneAI::convertBotzoneOutputToMove(const std::string& output) const {
-    // Parse "x0 y0 x1 y1 x2 y2" format
-    std::istringstream iss(output);
-    int x0, y0, x1, y1, x2, y2;
-    
-    if (!(iss >> x0 >> y0 >> x1 >> y1 >> x2 >> y2)) {
-        throw std::invalid_argument("Invalid move format: " + output);
+bool BotzoneAI::extendsBotHistory(const std::vector<Move>& history) const {
+    // The bot's own reply, then the opponent's
+    return history.size() == botHistory.size() + 1 &&
+           std::equal(botHistory.begin(), botHistory.end(), history.begin());
+}
+
+std::string BotzoneAI::convertGameStateToBotzoneInput(const GameState& gameState) const {
+    // Botzone games always begin from the standard position, so anything else
+    // (e.g. a loaded save without its moves) cannot be described to the bot
+    const std::vector<Move>& history = gameState.getMoveHistory();
+    GameState replay;
+    for (const auto& move : history) {
+        replay.makeMove(move);
     }
-    
-    // Check for special "no move" case
-    if (x0 == -1 && y0 == -1 && x1 == -1 && y1 == -1 && x2 == -1 && y2 == -1) {
+    if (replay != gameState) {
+        throw std::runtime_error("BotzoneAI: position is not reachable from its move history");
+    }
+    return BotzoneProtocol::simpleInput(history);
+}
+
+Move BotzoneAI::convertBotzoneOutputToMove(const std::string& output) const {
+    std::optional<Move> move = BotzoneProtocol::parseMove(output);
+    if (!move) {
         throw std::runtime_error("Bot returned no legal moves");
     }
-    
-    // Create positions and move
-    Position from(y0, x0); // Note: Botzone uses (x,y), we use (row,col)
-    Position to(y1, x1);
-    Position arrow(y2, x2);
-    
-    return Move(from, to, arrow);
+    return *move;
 }
 
-std::vector<std::string> BotzoneAI::getMoveHistory(const GameState& /*gameState*/) const {
-    // For now, return empty history
-    // In a complete implementation, we would track the game history
-    // and convert all previous moves to Botzone format
-    return moveHistory;
+std::vector<std::string> BotzoneAI::getMoveHistory(const GameState& gameState) const {
+    std::vector<std::string> lines;
+    for (const auto& move : gameState.getMoveHistory()) {
+        lines.push_back(BotzoneProtocol::formatMove(move));
+    }
+    return lines;
 }
 
-} // namespace amazons
\ No newline at end of file
+} // namespace amazons
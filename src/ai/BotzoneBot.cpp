@@ -0,0 +1,118 @@
+#include "ai/BotzoneBot.hpp"
+#include "ai/BotzoneProtocol.hpp"
+#include <chrono>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace amazons {
+
+namespace {
+    // Skips blank lines, which some judges send between turns
+    bool readLine(std::istream& in, std::string& line) {
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.find_first_not_of(" \t") != std::string::npos) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // A line holding a single integer starts a full history
+    bool isTurnCount(const std::string& line, int& count) {
+        std::istringstream iss(line);
+        std::string rest;
+        return static_cast<bool>(iss >> count) && !(iss >> rest);
+    }
+}
+
+BotzoneBot::BotzoneBot() : BotzoneBot(Options()) {}
+
+BotzoneBot::BotzoneBot(const Options& options) : options(options), ai(options.mcts) {
+    if (!options.bookPath.empty()) {
+        book = std::make_unique<OpeningBook>(options.bookPath);
+    }
+}
+
+int BotzoneBot::run(std::istream& in, std::ostream& out) {
+    int answered = 0;
+    std::string line;
+    while (readLine(in, line)) {
+        auto received = std::chrono::steady_clock::now();
+
+        // Answer in whichever protocol the judge speaks
+        const bool json = line[line.find_first_not_of(" \t")] == '{';
+        int count = 0;
+        if (json && BotzoneProtocol::jsonField(line, "requests")) {
+            // Full history: rebuild the position; the search tree is kept if it still fits
+            BotzoneProtocol::JsonInput input = BotzoneProtocol::parseJsonInput(line);
+            gameState = GameState();
+            for (size_t i = 0; i < input.requests.size(); ++i) {
+                applyRequest(input.requests[i]);
+                if (i < input.responses.size()) {
+                    applyRequest(input.responses[i]);
+                }
+            }
+        } else if (json) {
+            applyRequest(BotzoneProtocol::parseJsonMove(line));
+        } else if (isTurnCount(line, count)) {
+            if (count < 1) {
+                throw std::invalid_argument("Bad turn count: " + line);
+            }
+            gameState = GameState();
+            for (int i = 0; i < 2 * count - 1; ++i) {
+                if (!readLine(in, line)) {
+                    throw std::runtime_error("Input ended inside the turn history");
+                }
+                applyRequest(BotzoneProtocol::parseMove(line));
+            }
+        } else {
+            applyRequest(BotzoneProtocol::parseMove(line));
+        }
+
+        double spent = std::chrono::duration<double>(std::chrono::steady_clock::now() - received).count();
+        std::optional<Move> move = think(options.turnSeconds - options.safetyMarginSeconds - spent);
+        out << (json ? BotzoneProtocol::jsonOutput(move) : BotzoneProtocol::formatMove(move)) << '\n';
+        if (options.keepRunning) {
+            out << BotzoneProtocol::KEEP_RUNNING << '\n';
+        }
+        out.flush();
+        answered++;
+        if (!options.keepRunning) {
+            break;      // Botzone restarts us with the full history next turn
+        }
+    }
+    return answered;
+}
+
+void BotzoneBot::applyRequest(const std::optional<Move>& move) {
+    if (move) {
+        // GameState rejects anything illegal, so a corrupt history cannot go unnoticed
+        gameState.makeMove(*move);
+    }
+}
+
+std::optional<Move> BotzoneBot::think(double secondsLeft) {
+    if (gameState.isGameOver()) {
+        return std::nullopt;
+    }
+    PackedMove bookMove;
+    if (book && book->probe(FastBoard::fromGameState(gameState), bookMove)) {
+        // Answered in microseconds; the tree is rebuilt once the book runs out
+        gameState.makeMove(bookMove.toMove());
+        return bookMove.toMove();
+    }
+    MctsAI::SearchLimits limits = ai.defaultLimits();
+    // Always search a little, even if parsing somehow ate the whole budget
+    limits.timeLimitSeconds = secondsLeft > 0.01 ? secondsLeft : 0.01;
+    Move move = ai.startSearch(gameState, limits).result().get();
+    gameState.makeMove(move);
+    return move;
+}
+
+} // namespace amazons
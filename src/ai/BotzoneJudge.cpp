@@ -0,0 +1,160 @@
+#include "ai/BotzoneJudge.hpp"
+#include "ai/BotzoneProtocol.hpp"
+#include "core/GameState.hpp"
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    // How long a bot may take to print the keep-running marker after its move
+    const double MARKER_SECONDS = 0.2;
+
+    struct Seat {
+        const BotzoneJudge::BotSpec* spec = nullptr;
+        std::unique_ptr<BotProcess> process;
+        bool keepRunning = false;
+        std::string data;           // JSON bots' data/globaldata, handed back on restarts
+        std::string globalData;
+    };
+
+    double cpuSeconds(const BotProcess::Usage& usage) {
+        return usage.userSeconds + usage.systemSeconds;
+    }
+
+    void writeTurn(std::ofstream& out, size_t index, const BotzoneJudge::TurnRecord& turn) {
+        out << "[" << index + 1 << "] " << playerToString(turn.player)
+            << (turn.restarted ? " (started)" : "") << '\n';
+        std::istringstream lines(turn.input);
+        std::string line;
+        while (std::getline(lines, line)) {
+            out << "> " << line << '\n';
+        }
+        out << "< " << turn.output << '\n'
+            << "  wall " << turn.wallSeconds << " s, cpu " << turn.cpuSeconds << " s\n";
+        // Flushed per turn so a hung or crashed run still leaves its trail
+        out.flush();
+    }
+}
+
+const char* BotzoneJudge::protocolName(Protocol protocol) {
+    return protocol == Protocol::JSON ? "json" : "simple";
+}
+
+BotzoneJudge::Result BotzoneJudge::play(const Options& options) {
+    if (options.black.path.empty() || options.white.path.empty()) {
+        throw std::invalid_argument("BotzoneJudge needs two bots");
+    }
+    std::ofstream transcript;
+    if (!options.transcriptPath.empty()) {
+        transcript.open(options.transcriptPath);
+        if (!transcript.is_open()) {
+            throw std::runtime_error("Could not open transcript file " + options.transcriptPath);
+        }
+        transcript << "# black: " << options.black.path << " (" << protocolName(options.black.protocol) << ")\n"
+                   << "# white: " << options.white.path << " (" << protocolName(options.white.protocol) << ")\n";
+    }
+
+    auto start = Clock::now();
+    Result result;
+    GameState state;
+    Seat seats[2];
+    seats[0].spec = &options.black;
+    seats[1].spec = &options.white;
+
+    auto finish = [&](Player loser, BotServer::EndReason reason) {
+        for (Seat& seat : seats) {
+            if (seat.process) {
+                seat.process->stop();
+            }
+        }
+        result.winner = oppositePlayer(loser);
+        result.reason = reason;
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        if (transcript.is_open()) {
+            transcript << "# " << playerToString(result.winner) << " wins (" << BotServer::reasonName(reason)
+                       << "), " << result.moves.size() << " plies, " << result.seconds << " s\n";
+        }
+        return result;
+    };
+
+    while (true) {
+        const Player player = state.getCurrentPlayer();
+        if (state.isGameOver()) {
+            return finish(player, BotServer::EndReason::NO_MOVES);
+        }
+        Seat& seat = seats[player == Player::BLACK ? 0 : 1];
+        const bool json = seat.spec->protocol == Protocol::JSON;
+
+        TurnRecord turn;
+        turn.player = player;
+        turn.restarted = !seat.process || !seat.keepRunning || !seat.process->isRunning();
+        if (turn.restarted) {
+            seat.process = std::make_unique<BotProcess>(seat.spec->path);
+            seat.process->setLimits(options.limits);
+            if (!seat.process->start()) {
+                return finish(player, BotServer::EndReason::CRASH);
+            }
+            turn.input = json ? BotzoneProtocol::jsonInput(result.moves, seat.data, seat.globalData) + "\n"
+                              : BotzoneProtocol::simpleInput(result.moves);
+        } else {
+            std::optional<Move> last;
+            if (!result.moves.empty()) {
+                last = result.moves.back();
+            }
+            turn.input = (json ? BotzoneProtocol::jsonMove(last) : BotzoneProtocol::formatMove(last)) + "\n";
+        }
+
+        auto sent = Clock::now();
+        const double cpuBefore = cpuSeconds(seat.process->getUsage());
+        bool delivered = seat.process->sendInput(turn.input);
+        if (delivered) {
+            double allowance = options.turnSeconds + (turn.restarted ? options.startupSeconds : 0.0);
+            turn.output = seat.process->readMove(allowance);
+        }
+        turn.wallSeconds = std::chrono::duration<double>(Clock::now() - sent).count();
+        turn.cpuSeconds = cpuSeconds(seat.process->getUsage()) - cpuBefore;
+        result.turns.push_back(turn);
+        if (transcript.is_open()) {
+            writeTurn(transcript, result.turns.size() - 1, turn);
+        }
+
+        if (turn.output.empty()) {
+            bool crashed = !delivered || seat.process->outputEnded() || !seat.process->isRunning();
+            return finish(player, crashed ? BotServer::EndReason::CRASH : BotServer::EndReason::TIMEOUT);
+        }
+
+        std::optional<Move> move;
+        try {
+            if (json) {
+                BotzoneProtocol::JsonOutput output = BotzoneProtocol::parseJsonOutput(turn.output);
+                move = output.move;
+                seat.data = output.data;
+                seat.globalData = output.globalData;
+            } else {
+                move = BotzoneProtocol::parseMove(turn.output);
+            }
+        } catch (const std::invalid_argument&) {
+        }
+        // The game is not over, so the "-1" placeholder is as wrong as garbage
+        if (!move || !state.isValidMove(*move)) {
+            return finish(player, BotServer::EndReason::ILLEGAL_MOVE);
+        }
+        state.makeMove(*move);
+        result.moves.push_back(*move);
+
+        // Like Botzone, a bot that does not ask to keep running is killed after its move
+        seat.keepRunning = seat.process->readKeepRunning(MARKER_SECONDS) == BotzoneProtocol::KEEP_RUNNING;
+        if (!seat.keepRunning) {
+            seat.process->stop();
+        }
+    }
+}
+
+} // namespace amazons
@@ -0,0 +1,282 @@
+#include "ai/BotzoneProtocol.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    const char* const COORDINATE_NAMES[6] = {"x0", "y0", "x1", "y1", "x2", "y2"};
+
+    size_t skipSpace(const std::string& text, size_t i) {
+        while (i < text.size() && (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' || text[i] == '\n')) {
+            ++i;
+        }
+        return i;
+    }
+
+    [[noreturn]] void malformed(const std::string& text) {
+        throw std::invalid_argument("Malformed JSON: " + text.substr(0, 80));
+    }
+
+    // Index just past the string starting at the quote at i
+    size_t skipString(const std::string& text, size_t i) {
+        for (++i; i < text.size(); ++i) {
+            if (text[i] == '\\') {
+                ++i;
+            } else if (text[i] == '"') {
+                return i + 1;
+            }
+        }
+        malformed(text);
+    }
+
+    // Index just past the value starting at i
+    size_t skipValue(const std::string& text, size_t i) {
+        if (i >= text.size()) {
+            malformed(text);
+        }
+        if (text[i] == '"') {
+            return skipString(text, i);
+        }
+        if (text[i] == '{' || text[i] == '[') {
+            int depth = 0;
+            while (i < text.size()) {
+                char c = text[i];
+                if (c == '"') {
+                    i = skipString(text, i);
+                    continue;
+                }
+                if (c == '{' || c == '[') {
+                    depth++;
+                } else if (c == '}' || c == ']') {
+                    if (--depth == 0) {
+                        return i + 1;
+                    }
+                }
+                ++i;
+            }
+            malformed(text);
+        }
+        size_t start = i;
+        while (i < text.size() && text[i] != ',' && text[i] != '}' && text[i] != ']' &&
+               text[i] != ' ' && text[i] != '\t' && text[i] != '\r' && text[i] != '\n') {
+            ++i;
+        }
+        if (i == start) {
+            malformed(text);
+        }
+        return i;
+    }
+
+    void appendMoves(std::ostringstream& out, const std::vector<Move>& moves, bool placeholder, size_t first) {
+        bool comma = false;
+        if (placeholder) {
+            out << BotzoneProtocol::jsonMove(std::nullopt);
+            comma = true;
+        }
+        for (size_t i = first; i < moves.size(); i += 2) {
+            out << (comma ? "," : "") << BotzoneProtocol::jsonMove(moves[i]);
+            comma = true;
+        }
+    }
+}
+
+std::string BotzoneProtocol::formatMove(const std::optional<Move>& move) {
+    if (!move) {
+        return "-1 -1 -1 -1 -1 -1";
+    }
+    std::ostringstream oss;
+    // Coordinates are int8_t, which a stream would print as characters
+    oss << int(move->from.col) << ' ' << int(move->from.row) << ' '
+        << int(move->to.col) << ' ' << int(move->to.row) << ' '
+        << int(move->arrow.col) << ' ' << int(move->arrow.row);
+    return oss.str();
+}
+
+std::optional<Move> BotzoneProtocol::parseMove(const std::string& line) {
+    std::istringstream iss(line);
+    int x0, y0, x1, y1, x2, y2;
+    if (!(iss >> x0 >> y0 >> x1 >> y1 >> x2 >> y2)) {
+        throw std::invalid_argument("Invalid move format: " + line);
+    }
+    if (x0 == -1) {
+        return std::nullopt;
+    }
+    return Move(Position(y0, x0), Position(y1, x1), Position(y2, x2));
+}
+
+std::string BotzoneProtocol::simpleInput(const std::vector<Move>& moves) {
+    // Black is to move after an even number of moves and starts with the placeholder
+    const bool black = moves.size() % 2 == 0;
+    const size_t lines = moves.size() + (black ? 1 : 0);
+    std::string input = std::to_string((lines + 1) / 2) + "\n";
+    if (black) {
+        input += formatMove(std::nullopt) + "\n";
+    }
+    for (const auto& move : moves) {
+        input += formatMove(move) + "\n";
+    }
+    return input;
+}
+
+std::string BotzoneProtocol::jsonMove(const std::optional<Move>& move) {
+    int values[6] = {-1, -1, -1, -1, -1, -1};
+    if (move) {
+        int coordinates[6] = {move->from.col, move->from.row, move->to.col, move->to.row,
+                              move->arrow.col, move->arrow.row};
+        std::copy(coordinates, coordinates + 6, values);
+    }
+    std::ostringstream oss;
+    oss << '{';
+    for (int i = 0; i < 6; ++i) {
+        oss << (i ? "," : "") << '"' << COORDINATE_NAMES[i] << "\":" << values[i];
+    }
+    oss << '}';
+    return oss.str();
+}
+
+std::optional<Move> BotzoneProtocol::parseJsonMove(const std::string& object) {
+    int values[6];
+    for (int i = 0; i < 6; ++i) {
+        auto field = jsonField(object, COORDINATE_NAMES[i]);
+        if (!field) {
+            throw std::invalid_argument(std::string("Move without ") + COORDINATE_NAMES[i] + ": " + object);
+        }
+        try {
+            size_t used = 0;
+            values[i] = std::stoi(*field, &used);
+            if (used != field->size()) {
+                throw std::invalid_argument(*field);
+            }
+        } catch (const std::exception&) {
+            throw std::invalid_argument("Bad coordinate " + *field + " in " + object);
+        }
+    }
+    if (values[0] == -1) {
+        return std::nullopt;
+    }
+    return Move(Position(values[1], values[0]), Position(values[3], values[2]), Position(values[5], values[4]));
+}
+
+std::string BotzoneProtocol::jsonInput(const std::vector<Move>& moves, const std::string& data,
+                                       const std::string& globalData) {
+    // Requests are the opponent's moves (after Black's placeholder), responses our own
+    const bool black = moves.size() % 2 == 0;
+    std::ostringstream out;
+    out << "{\"requests\":[";
+    appendMoves(out, moves, black, black ? 1 : 0);
+    out << "],\"responses\":[";
+    appendMoves(out, moves, false, black ? 0 : 1);
+    out << ']';
+    if (!data.empty()) {
+        out << ",\"data\":" << data;
+    }
+    if (!globalData.empty()) {
+        out << ",\"globaldata\":" << globalData;
+    }
+    out << '}';
+    return out.str();
+}
+
+BotzoneProtocol::JsonInput BotzoneProtocol::parseJsonInput(const std::string& text) {
+    JsonInput input;
+    auto requests = jsonField(text, "requests");
+    if (!requests) {
+        throw std::invalid_argument("JSON input without requests: " + text.substr(0, 80));
+    }
+    for (const auto& element : jsonArray(*requests)) {
+        input.requests.push_back(parseJsonMove(element));
+    }
+    if (auto responses = jsonField(text, "responses")) {
+        for (const auto& element : jsonArray(*responses)) {
+            input.responses.push_back(parseJsonMove(element));
+        }
+    }
+    if (input.requests.empty() || input.responses.size() + 1 != input.requests.size()) {
+        throw std::invalid_argument("JSON input needs one more request than responses");
+    }
+    return input;
+}
+
+std::string BotzoneProtocol::jsonOutput(const std::optional<Move>& move) {
+    return "{\"response\":" + jsonMove(move) + "}";
+}
+
+BotzoneProtocol::JsonOutput BotzoneProtocol::parseJsonOutput(const std::string& text) {
+    JsonOutput output;
+    auto response = jsonField(text, "response");
+    if (!response) {
+        throw std::invalid_argument("JSON output without response: " + text.substr(0, 80));
+    }
+    if (!response->empty() && (*response)[0] == '"') {
+        // Some bots answer with the simple-protocol line as a string
+        output.move = parseMove(response->substr(1, response->size() - 2));
+    } else {
+        output.move = parseJsonMove(*response);
+    }
+    output.data = jsonField(text, "data").value_or("");
+    output.globalData = jsonField(text, "globaldata").value_or("");
+    return output;
+}
+
+std::optional<std::string> BotzoneProtocol::jsonField(const std::string& object, const std::string& key) {
+    size_t i = skipSpace(object, 0);
+    if (i >= object.size() || object[i] != '{') {
+        malformed(object);
+    }
+    i = skipSpace(object, i + 1);
+    if (i < object.size() && object[i] == '}') {
+        return std::nullopt;
+    }
+    while (true) {
+        if (i >= object.size() || object[i] != '"') {
+            malformed(object);
+        }
+        size_t keyEnd = skipString(object, i);
+        bool match = object.compare(i + 1, keyEnd - i - 2, key) == 0 && keyEnd - i - 2 == key.size();
+        i = skipSpace(object, keyEnd);
+        if (i >= object.size() || object[i] != ':') {
+            malformed(object);
+        }
+        size_t valueStart = skipSpace(object, i + 1);
+        size_t valueEnd = skipValue(object, valueStart);
+        if (match) {
+            return object.substr(valueStart, valueEnd - valueStart);
+        }
+        i = skipSpace(object, valueEnd);
+        if (i < object.size() && object[i] == ',') {
+            i = skipSpace(object, i + 1);
+        } else if (i < object.size() && object[i] == '}') {
+            return std::nullopt;
+        } else {
+            malformed(object);
+        }
+    }
+}
+
+std::vector<std::string> BotzoneProtocol::jsonArray(const std::string& array) {
+    std::vector<std::string> elements;
+    size_t i = skipSpace(array, 0);
+    if (i >= array.size() || array[i] != '[') {
+        malformed(array);
+    }
+    i = skipSpace(array, i + 1);
+    if (i < array.size() && array[i] == ']') {
+        return elements;
+    }
+    while (true) {
+        size_t end = skipValue(array, i);
+        elements.push_back(array.substr(i, end - i));
+        i = skipSpace(array, end);
+        if (i < array.size() && array[i] == ',') {
+            i = skipSpace(array, i + 1);
+        } else if (i < array.size() && array[i] == ']') {
+            return elements;
+        } else {
+            malformed(array);
+        }
+    }
+}
+
+} // namespace amazons
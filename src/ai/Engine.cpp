@@ -0,0 +1,183 @@
+#include "ai/Engine.hpp"
+#include "ai/BasicAI.hpp"
+#include "ai/MctsAI.hpp"
+#include "core/FastBoard.hpp"
+#include "utils/OpeningBook.hpp"
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    class BasicEngine : public Engine {
+    public:
+        Move getBestMove(const GameState& gameState) override {
+            return ai.getBestMove(gameState);
+        }
+        std::string getName() const override { return "basic"; }
+
+    private:
+        BasicAI ai;
+    };
+
+    class RandomEngine : public Engine {
+    public:
+        // Seed 0 draws a fresh seed so parallel workers do not replay the same game
+        explicit RandomEngine(uint64_t seed)
+            : rng(seed ? seed : (static_cast<uint64_t>(std::random_device{}()) << 32) ^ std::random_device{}()) {}
+
+        Move getBestMove(const GameState& gameState) override {
+            PackedMove move;
+            if (!FastBoard::fromGameState(gameState).randomMove(rng, move)) {
+                throw std::runtime_error("No legal moves available");
+            }
+            return move.toMove();
+        }
+        std::string getName() const override { return "random"; }
+
+    private:
+        FastRandom rng;
+    };
+
+    class MctsEngine : public Engine {
+    public:
+        MctsEngine(const MctsAI::Config& config, std::string name) : ai(config), name(std::move(name)) {}
+
+        Move getBestMove(const GameState& gameState) override {
+            return ai.getBestMove(gameState);
+        }
+        void newGame() override { ai.reset(); }
+        std::string getName() const override { return name; }
+        std::optional<double> getLastWinRate() const override {
+            // A forced move is returned without searching
+            if (ai.getLastStats().playouts == 0) {
+                return std::nullopt;
+            }
+            return ai.getLastStats().bestWinRate;
+        }
+
+    private:
+        MctsAI ai;
+        std::string name;
+    };
+
+    // Plays from the book while the game is in it and hands over to the
+    // wrapped engine after that
+    class BookEngine : public Engine {
+    public:
+        BookEngine(std::unique_ptr<Engine> inner, std::shared_ptr<const OpeningBook> book)
+            : inner(std::move(inner)), book(std::move(book)) {}
+
+        Move getBestMove(const GameState& gameState) override {
+            FastBoard board = FastBoard::fromGameState(gameState);
+            bookMoveScore.reset();
+            // Best first; the legality check guards against key collisions
+            for (const auto& entry : book->lookup(board)) {
+                if (board.isLegal(entry.move)) {
+                    bookMoveScore = entry.score;
+                    return entry.move.toMove();
+                }
+            }
+            return inner->getBestMove(gameState);
+        }
+        void newGame() override { inner->newGame(); }
+        std::string getName() const override { return inner->getName(); }
+        std::optional<double> getLastWinRate() const override {
+            return bookMoveScore ? bookMoveScore : inner->getLastWinRate();
+        }
+
+    private:
+        std::unique_ptr<Engine> inner;
+        std::shared_ptr<const OpeningBook> book;
+        std::optional<double> bookMoveScore;    // set while the last move came from the book
+    };
+
+    std::map<std::string, std::string> parseOptions(const std::string& text) {
+        std::map<std::string, std::string> options;
+        std::istringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            if (item.empty()) {
+                continue;
+            }
+            size_t eq = item.find('=');
+            if (eq == std::string::npos || eq == 0) {
+                throw std::invalid_argument("Engine option '" + item + "' is not key=value");
+            }
+            options[item.substr(0, eq)] = item.substr(eq + 1);
+        }
+        return options;
+    }
+
+    MctsAI::Config mctsConfig(const std::map<std::string, std::string>& options) {
+        MctsAI::Config config;
+        for (const auto& [key, value] : options) {
+            if (key == "time") {
+                config.timeLimitSeconds = std::stod(value);
+            } else if (key == "playouts") {
+                config.maxPlayouts = std::stoull(value);
+            } else if (key == "threads") {
+                config.threads = static_cast<unsigned>(std::stoul(value));
+            } else if (key == "rule") {
+                if (value != "uct" && value != "puct") {
+                    throw std::invalid_argument("mcts rule must be uct or puct");
+                }
+                config.rule = value == "puct" ? MctsAI::SelectionRule::PUCT : MctsAI::SelectionRule::UCT;
+            } else if (key == "c") {
+                config.exploration = std::stod(value);
+            } else if (key == "widening") {
+                config.wideningBase = std::stod(value);
+            } else if (key == "reuse") {
+                config.reuseTree = value != "0";
+            } else if (key == "seed") {
+                config.seed = std::stoull(value);
+            } else {
+                throw std::invalid_argument("Unknown mcts option '" + key + "'");
+            }
+        }
+        return config;
+    }
+
+    std::unique_ptr<Engine> createBareEngine(const std::string& spec, const std::string& kind,
+                                             const std::map<std::string, std::string>& options) {
+        if (kind == "basic") {
+            if (!options.empty()) {
+                throw std::invalid_argument("basic engine takes no options");
+            }
+            return std::make_unique<BasicEngine>();
+        }
+        if (kind == "random") {
+            uint64_t seed = 0;
+            for (const auto& [key, value] : options) {
+                if (key != "seed") {
+                    throw std::invalid_argument("Unknown random option '" + key + "'");
+                }
+                seed = std::stoull(value);
+            }
+            return std::make_unique<RandomEngine>(seed);
+        }
+        if (kind == "mcts") {
+            return std::make_unique<MctsEngine>(mctsConfig(options), spec);
+        }
+        throw std::invalid_argument("Unknown engine '" + kind + "'");
+    }
+}
+
+std::unique_ptr<Engine> createEngine(const std::string& spec) {
+    size_t colon = spec.find(':');
+    std::string kind = spec.substr(0, colon);
+    auto options = parseOptions(colon == std::string::npos ? "" : spec.substr(colon + 1));
+
+    // Any engine can sit behind a book
+    auto bookOption = options.find("book");
+    if (bookOption == options.end()) {
+        return createBareEngine(spec, kind, options);
+    }
+    auto book = std::make_shared<const OpeningBook>(bookOption->second);
+    options.erase(bookOption);
+    return std::make_unique<BookEngine>(createBareEngine(spec, kind, options), std::move(book));
+}
+
+} // namespace amazons
@@ -0,0 +1,177 @@
+#include "ai/Match.hpp"
+#include "ai/Engine.hpp"
+#include "core/GameState.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace amazons {
+
+namespace {
+    struct GameOutcome {
+        bool aWon = false;
+        bool illegal = false;
+    };
+
+    // A playing Black means A moves first
+    GameOutcome playGame(Engine& a, Engine& b, bool aIsBlack, const Match::Opening& opening) {
+        GameState state;
+        for (const auto& move : opening) {
+            if (!state.isValidMove(move)) {
+                throw std::invalid_argument("Opening contains illegal move " + move.toString());
+            }
+            state.makeMove(move);
+        }
+        a.newGame();
+        b.newGame();
+
+        const Player aColor = aIsBlack ? Player::BLACK : Player::WHITE;
+        while (!state.isGameOver()) {
+            bool aToMove = state.getCurrentPlayer() == aColor;
+            Move move = (aToMove ? a : b).getBestMove(state);
+            if (!state.isValidMove(move)) {
+                return {!aToMove, true};
+            }
+            state.makeMove(move);
+        }
+        return {state.getWinner() == aColor, false};
+    }
+
+    double scoreFromElo(double elo) {
+        return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+    }
+}
+
+double Match::eloFromScore(double score) {
+    if (score <= 0.0) {
+        return -std::numeric_limits<double>::infinity();
+    }
+    if (score >= 1.0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double Match::eloError(int wins, int losses) {
+    int games = wins + losses;
+    if (wins == 0 || losses == 0) {
+        return std::numeric_limits<double>::infinity();
+    }
+    double score = static_cast<double>(wins) / games;
+    double deviation = std::sqrt(score * (1.0 - score) / games);
+    double low = eloFromScore(score - 1.959964 * deviation);
+    double high = eloFromScore(score + 1.959964 * deviation);
+    return (high - low) / 2.0;
+}
+
+double Match::sprtLlr(int wins, int losses, double elo0, double elo1) {
+    double p0 = scoreFromElo(elo0);
+    double p1 = scoreFromElo(elo1);
+    return wins * std::log(p1 / p0) + losses * std::log((1.0 - p1) / (1.0 - p0));
+}
+
+std::vector<Match::Opening> Match::loadOpenings(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open opening suite " + path);
+    }
+    std::vector<Opening> openings;
+    std::string line;
+    while (std::getline(file, line)) {
+        line = line.substr(0, line.find('#'));
+        if (line.find_first_not_of(" \t\r") == std::string::npos) {
+            continue;
+        }
+        Opening opening;
+        std::istringstream moves(line);
+        std::string text;
+        while (std::getline(moves, text, ';')) {
+            if (text.find_first_not_of(" \t\r") != std::string::npos) {
+                opening.push_back(Move::fromString(text));
+            }
+        }
+        openings.push_back(std::move(opening));
+    }
+    return openings;
+}
+
+Match::Result Match::run(const Options& options, const std::function<void(const Result&)>& progress) {
+    // Fail fast on bad specs instead of inside every worker
+    createEngine(options.engineA);
+    createEngine(options.engineB);
+
+    Result result;
+    result.lowerBound = std::log(options.beta / (1.0 - options.alpha));
+    result.upperBound = std::log((1.0 - options.beta) / options.alpha);
+
+    const std::vector<Opening> openings = options.openings.empty() ? std::vector<Opening>{Opening()}
+                                                                   : options.openings;
+    std::atomic<int> nextGame{0};
+    std::atomic<bool> stop{false};
+    std::mutex resultMutex;
+    std::exception_ptr failure;
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto worker = [&]() {
+        try {
+            auto a = createEngine(options.engineA);
+            auto b = createEngine(options.engineB);
+            for (int game = nextGame++; game < options.games && !stop; game = nextGame++) {
+                // Consecutive games share an opening with colours swapped
+                const Opening& opening = openings[static_cast<size_t>(game / 2) % openings.size()];
+                GameOutcome outcome = playGame(*a, *b, game % 2 == 0, opening);
+
+                std::lock_guard<std::mutex> lock(resultMutex);
+                result.games++;
+                (outcome.aWon ? result.winsA : result.winsB)++;
+                result.illegalMoves += outcome.illegal ? 1 : 0;
+                result.elo = eloFromScore(static_cast<double>(result.winsA) / result.games);
+                result.eloError = eloError(result.winsA, result.winsB);
+                result.llr = sprtLlr(result.winsA, result.winsB, options.elo0, options.elo1);
+                if (options.sprt && result.sprtOutcome == SprtOutcome::CONTINUE) {
+                    if (result.llr >= result.upperBound) {
+                        result.sprtOutcome = SprtOutcome::ACCEPT_H1;
+                    } else if (result.llr <= result.lowerBound) {
+                        result.sprtOutcome = SprtOutcome::ACCEPT_H0;
+                    }
+                    stop = result.sprtOutcome != SprtOutcome::CONTINUE;
+                }
+                result.elapsedSeconds =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+                if (progress) {
+                    progress(result);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            stop = true;
+        }
+    };
+
+    unsigned threads = std::max(1u, options.concurrency);
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return result;
+}
+
+} // namespace amazons
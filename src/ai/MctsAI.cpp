@@ -0,0 +1,569 @@
+#include "ai/MctsAI.hpp"
+#include "ai/NodeArena.hpp"
+#include "core/FastBoard.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace amazons {
+
+namespace {
+    constexpr uint16_t UNKNOWN_MOVES = 0xFFFF;
+
+    // Stride for walking a node's move list in a scrambled but repeatable order.
+    // It is prime and larger than MAX_MOVES, so it is coprime to every move count.
+    constexpr uint32_t EXPANSION_STRIDE = 7919;
+
+    // Statistics are atomics so tree-parallel workers update them without locks.
+    // move and nextSibling are written once, before the node is published.
+    struct Node {
+        PackedMove move;                                    // move that led to this node
+        std::atomic<uint16_t> numMoves{UNKNOWN_MOVES};      // legal moves here
+        std::atomic<uint16_t> numExpanded{0};
+        std::atomic<uint32_t> firstChild{0xFFFFFFFFu};
+        uint32_t nextSibling = 0xFFFFFFFFu;
+        std::atomic<uint32_t> visits{0};                    // includes playouts still in flight
+        std::atomic<uint32_t> wins{0};                      // playouts won by the player who made move
+        std::atomic<uint32_t> virtualLoss{0};               // extra pessimism while workers are below
+    };
+
+    using Arena = NodeArena<Node>;
+    using Clock = std::chrono::steady_clock;
+
+    // Copies statistics only; links are rebuilt by the caller
+    void copyNode(Node& to, const Node& from) {
+        to.move = from.move;
+        to.numMoves.store(from.numMoves.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.numExpanded.store(from.numExpanded.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.visits.store(from.visits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        to.wins.store(from.wins.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+struct MctsAI::Tree {
+    Arena arena;
+    Arena spare;                            // compaction target when re-rooting
+    FastBoard rootPosition;
+    Arena::Index root = Arena::NONE;
+    // Slots in the arena that hold no tree node: the rest of a worker's last
+    // chunk and a node it allocated but never linked when the search stopped
+    std::atomic<size_t> unusedSlots{0};
+
+    void clear() {
+        arena.reset();
+        root = Arena::NONE;
+        unusedSlots.store(0, std::memory_order_relaxed);
+    }
+
+    // Nodes actually in the tree
+    size_t nodeCount() const {
+        return arena.size() - unusedSlots.load(std::memory_order_relaxed);
+    }
+
+    // Finds the node whose position equals target within maxDepth plies of the root
+    Arena::Index findDescendant(const FastBoard& target, int maxDepth) const {
+        if (root == Arena::NONE) {
+            return Arena::NONE;
+        }
+        if (rootPosition == target) {
+            return root;
+        }
+        FastBoard position = rootPosition;
+        return findBelow(root, position, target, maxDepth);
+    }
+
+    Arena::Index findBelow(Arena::Index node, FastBoard& position, const FastBoard& target, int depth) const {
+        if (depth == 0) {
+            return Arena::NONE;
+        }
+        for (Arena::Index child = arena[node].firstChild.load(std::memory_order_relaxed); child != Arena::NONE;
+             child = arena[child].nextSibling) {
+            position.makeMove(arena[child].move);
+            Arena::Index found = position == target ? child : findBelow(child, position, target, depth - 1);
+            position.unmakeMove(arena[child].move);
+            if (found != Arena::NONE) {
+                return found;
+            }
+        }
+        return Arena::NONE;
+    }
+
+    // Copies the subtree under newRoot into the spare arena and swaps, releasing everything else
+    void rerootAt(Arena::Index newRoot, const FastBoard& newRootPosition) {
+        if (newRoot != root) {
+            spare.reserve(arena.capacity());
+            Arena::Index copiedRoot = spare.allocate();
+            copyNode(spare[copiedRoot], arena[newRoot]);
+
+            // Breadth-first copy over a queue of (old, new) index pairs
+            std::vector<Arena::Index> queue{newRoot, copiedRoot};
+            for (size_t i = 0; i < queue.size(); i += 2) {
+                Arena::Index from = queue[i];
+                Arena::Index to = queue[i + 1];
+                Arena::Index previous = Arena::NONE;
+                for (Arena::Index child = arena[from].firstChild.load(std::memory_order_relaxed);
+                     child != Arena::NONE; child = arena[child].nextSibling) {
+                    Arena::Index copy = spare.allocate();
+                    copyNode(spare[copy], arena[child]);
+                    if (previous == Arena::NONE) {
+                        spare[to].firstChild.store(copy, std::memory_order_relaxed);
+                    } else {
+                        spare[previous].nextSibling = copy;
+                    }
+                    previous = copy;
+                    queue.push_back(child);
+                    queue.push_back(copy);
+                }
+            }
+            arena.swap(spare);
+            spare.reset();
+            root = copiedRoot;
+            unusedSlots.store(0, std::memory_order_relaxed);
+        }
+        rootPosition = newRootPosition;
+    }
+
+    // Code of the most visited root child, or Search::NO_MOVE; safe while workers run
+    uint32_t mostVisitedChild() const {
+        uint32_t bestCode = 0xFFFFFFFFu;
+        uint32_t bestVisits = 0;
+        for (Arena::Index child = arena[root].firstChild.load(std::memory_order_acquire); child != Arena::NONE;
+             child = arena[child].nextSibling) {
+            uint32_t visits = arena[child].visits.load(std::memory_order_relaxed);
+            if (visits > bestVisits) {
+                bestVisits = visits;
+                bestCode = arena[child].move.code();
+            }
+        }
+        return bestCode;
+    }
+
+    // Sets up the root for position, keeping a matching subtree when allowed. Returns true if reused.
+    bool prepareRoot(const FastBoard& position, int rootMoves, size_t capacity, bool reuse) {
+        if (arena.capacity() != capacity) {
+            arena.reserve(capacity);
+            root = Arena::NONE;
+        }
+        // Our last search root is normally two plies back: our move, then the opponent's
+        Arena::Index reused = reuse ? findDescendant(position, 2) : Arena::NONE;
+        if (reused != Arena::NONE) {
+            rerootAt(reused, position);
+            // A subtree taking most of the arena would leave the search little or no
+            // room to grow, and its stale statistics would decide the move
+            if (nodeCount() <= arena.capacity() / 2) {
+                return true;
+            }
+        }
+        clear();
+        root = arena.allocate();
+        if (root == Arena::NONE) {
+            throw std::runtime_error("MctsAI: node arena has no capacity");
+        }
+        arena[root].numMoves.store(static_cast<uint16_t>(rootMoves), std::memory_order_relaxed);
+        rootPosition = position;
+        return false;
+    }
+};
+
+// Limits and counters shared by every worker of one search
+struct MctsAI::Search {
+    const Config& config;
+    SearchLimits limits;
+    bool ponder = false;                    // pondering updates no stats but the ponder count
+    Clock::time_point deadline;
+    StopSource stop;                        // raised by the handle, the deadline or a full arena
+    StopToken cancel;                       // raised by the caller of startSearch
+    std::atomic<uint64_t> started{0};       // playouts begun, checked against maxPlayouts
+    std::atomic<uint64_t> finished{0};
+    std::atomic<uint32_t> bestSoFar{NO_MOVE};
+    std::promise<Move> promise;
+    std::shared_future<Move> result = promise.get_future().share();
+
+    static constexpr uint32_t NO_MOVE = 0xFFFFFFFFu;
+
+    Search(const Config& config, const SearchLimits& limits, StopToken cancel = StopToken())
+        : config(config), limits(limits), cancel(std::move(cancel)) {}
+
+    bool stopRequested() const { return stop.stopRequested() || cancel.stopRequested(); }
+};
+
+void MctsAI::runWorker(Tree& t, Search& search, uint64_t seed, bool reportsBest) {
+    const Config& cfg = search.config;
+    const double c = cfg.exploration;
+    const uint32_t virtualLoss = cfg.virtualLoss;
+
+    // Everything below is private to this thread, so the hot loop only touches shared
+    // memory through node statistics and one chunk claim per 256 allocations
+    Arena::Allocator allocator(t.arena);
+    Arena::Index pendingNode = Arena::NONE;     // allocated but not yet linked into the tree
+    std::vector<PackedMove> moveBuffer(FastBoard::MAX_MOVES);
+    std::vector<Arena::Index> path;
+    FastRandom rng(seed);
+    uint64_t iterations = 0;
+
+    while (!search.stopRequested()) {
+        if (search.limits.maxPlayouts &&
+            search.started.fetch_add(1, std::memory_order_relaxed) >= search.limits.maxPlayouts) {
+            break;
+        }
+        if ((iterations++ & 63) == 0) {
+            if (search.limits.timeLimitSeconds > 0 && Clock::now() >= search.deadline) {
+                search.stop.requestStop();
+                break;
+            }
+            // One worker keeps the anytime answer fresh for SearchHandle::bestSoFar()
+            if (reportsBest && (iterations & 1023) == 1) {
+                search.bestSoFar.store(t.mostVisitedChild(), std::memory_order_relaxed);
+            }
+        }
+
+        FastBoard position = t.rootPosition;
+        path.clear();
+        path.push_back(t.root);
+        t.arena[t.root].visits.fetch_add(1, std::memory_order_relaxed);
+        Arena::Index current = t.root;
+        bool arenaFull = false;
+        Player winner = Player::WHITE;
+
+        // Selection and expansion. A visit is counted on the way down, so other workers
+        // already see it as a loss; virtualLoss adds further pessimism on top of that.
+        while (true) {
+            Node& node = t.arena[current];
+            uint16_t numMoves = node.numMoves.load(std::memory_order_relaxed);
+            if (numMoves == UNKNOWN_MOVES) {
+                numMoves = static_cast<uint16_t>(position.countMoves());
+                node.numMoves.store(numMoves, std::memory_order_relaxed);
+            }
+            if (numMoves == 0) {
+                winner = oppositePlayer(position.sideToMove());
+                break;
+            }
+
+            uint32_t visits = node.visits.load(std::memory_order_relaxed);
+            uint32_t allowed = 1 + static_cast<uint32_t>(
+                cfg.wideningBase * std::pow(static_cast<double>(visits), cfg.wideningExponent));
+            uint16_t expanded = node.numExpanded.load(std::memory_order_relaxed);
+            if (expanded < numMoves && expanded < allowed) {
+                // Allocate before claiming the slot so a full arena never leaves a claimed gap
+                if (pendingNode == Arena::NONE) {
+                    pendingNode = allocator.allocate();
+                    if (pendingNode == Arena::NONE) {
+                        arenaFull = true;
+                        break;
+                    }
+                }
+                if (!node.numExpanded.compare_exchange_weak(expanded, static_cast<uint16_t>(expanded + 1),
+                                                            std::memory_order_relaxed)) {
+                    continue;
+                }
+                Arena::Index child = pendingNode;
+                pendingNode = Arena::NONE;
+
+                position.generateMoves(moveBuffer.data());
+                uint32_t offset = (current * 2654435761u) % numMoves;
+                uint32_t pick = static_cast<uint32_t>(
+                    (offset + static_cast<uint64_t>(expanded) * EXPANSION_STRIDE) % numMoves);
+
+                Node& childNode = t.arena[child];
+                childNode.move = moveBuffer[pick];
+                childNode.visits.store(1, std::memory_order_relaxed);
+                childNode.virtualLoss.store(virtualLoss, std::memory_order_relaxed);
+
+                // Publish with a lock-free push onto the parent's child list
+                uint32_t head = node.firstChild.load(std::memory_order_relaxed);
+                do {
+                    childNode.nextSibling = head;
+                } while (!node.firstChild.compare_exchange_weak(head, child, std::memory_order_release,
+                                                                std::memory_order_relaxed));
+
+                position.makeMove(childNode.move);
+                path.push_back(child);
+
+                // Playout from the new leaf
+                PackedMove playoutMove;
+                while (position.randomMove(rng, playoutMove)) {
+                    position.makeMove(playoutMove);
+                }
+                winner = oppositePlayer(position.sideToMove());
+                break;
+            }
+
+            // Descend to the best expanded child
+            double logParent = std::log(static_cast<double>(visits) + 1.0);
+            double sqrtParent = std::sqrt(static_cast<double>(visits) + 1.0);
+            double prior = 1.0 / numMoves;
+            Arena::Index best = Arena::NONE;
+            double bestScore = -1.0;
+            for (Arena::Index child = node.firstChild.load(std::memory_order_acquire); child != Arena::NONE;
+                 child = t.arena[child].nextSibling) {
+                const Node& childNode = t.arena[child];
+                double n = static_cast<double>(childNode.visits.load(std::memory_order_relaxed)) +
+                           childNode.virtualLoss.load(std::memory_order_relaxed);
+                double mean = n > 0 ? childNode.wins.load(std::memory_order_relaxed) / n : 0.5;
+                double score = cfg.rule == SelectionRule::UCT
+                    ? mean + c * std::sqrt(logParent / (n + 1e-9))
+                    : mean + c * prior * sqrtParent / (1.0 + n);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = child;
+                }
+            }
+            if (best == Arena::NONE) {
+                // Another worker has claimed the first child but not linked it yet
+                std::this_thread::yield();
+                continue;
+            }
+            Node& bestNode = t.arena[best];
+            bestNode.visits.fetch_add(1, std::memory_order_relaxed);
+            bestNode.virtualLoss.fetch_add(virtualLoss, std::memory_order_relaxed);
+            position.makeMove(bestNode.move);
+            path.push_back(best);
+            current = best;
+        }
+
+        // Backpropagation; the side that made a node's move alternates down the path.
+        // An iteration cut short by a full arena never happened: its visits come
+        // off again along with the virtual loss, so they do not count as losses.
+        Player mover = t.rootPosition.sideToMove();
+        for (size_t i = 1; i < path.size(); ++i) {
+            Node& node = t.arena[path[i]];
+            if (arenaFull) {
+                node.visits.fetch_sub(1, std::memory_order_relaxed);
+            } else if (mover == winner) {
+                node.wins.fetch_add(1, std::memory_order_relaxed);
+            }
+            node.virtualLoss.fetch_sub(virtualLoss, std::memory_order_relaxed);
+            mover = oppositePlayer(mover);
+        }
+        if (arenaFull) {
+            t.arena[t.root].visits.fetch_sub(1, std::memory_order_relaxed);
+            search.stop.requestStop();
+            break;
+        }
+        search.finished.fetch_add(1, std::memory_order_relaxed);
+    }
+    t.unusedSlots.fetch_add(allocator.unused() + (pendingNode != Arena::NONE ? 1 : 0), std::memory_order_relaxed);
+}
+
+MctsAI::MctsAI() : MctsAI(Config()) {}
+
+MctsAI::MctsAI(const Config& config)
+    : config(config),
+      seed(config.seed ? config.seed : static_cast<uint64_t>(Clock::now().time_since_epoch().count())) {}
+
+MctsAI::~MctsAI() {
+    stopSearch();
+}
+
+std::optional<Move> MctsAI::SearchHandle::bestSoFar() const {
+    uint32_t code = search ? search->bestSoFar.load(std::memory_order_relaxed) : Search::NO_MOVE;
+    if (code == Search::NO_MOVE) {
+        return std::nullopt;
+    }
+    return PackedMove::fromCode(code).toMove();
+}
+
+void MctsAI::SearchHandle::stop() {
+    if (search) {
+        search->stop.requestStop();
+    }
+}
+
+bool MctsAI::SearchHandle::isReady() const {
+    return search && search->result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+std::shared_future<Move> MctsAI::SearchHandle::result() const {
+    return search ? search->result : std::shared_future<Move>();
+}
+
+void MctsAI::reset() {
+    stopSearch();
+    for (auto& tree : trees) {
+        tree->clear();
+    }
+}
+
+uint64_t MctsAI::nextSeed() {
+    seed += 0x9E3779B97F4A7C15ULL;
+    return seed;
+}
+
+bool MctsAI::prepareTrees(const FastBoard& rootPosition, int rootMoveCount) {
+    // Tree mode shares one tree between all threads; root mode gives each thread its own
+    const bool rootParallel = config.parallelMode == ParallelMode::ROOT && config.threads > 1;
+    const size_t treeCount = rootParallel ? config.threads : 1;
+    if (trees.size() != treeCount) {
+        trees.clear();
+        for (size_t i = 0; i < treeCount; ++i) {
+            trees.push_back(std::make_unique<Tree>());
+        }
+    }
+    bool reused = false;
+    for (auto& tree : trees) {
+        reused |= tree->prepareRoot(rootPosition, rootMoveCount, config.arenaNodes / treeCount, config.reuseTree);
+    }
+    return reused;
+}
+
+void MctsAI::runSearch(Search& search) {
+    const unsigned threads = std::max(1u, config.threads);
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < threads; ++i) {
+        Tree& tree = trees.size() > 1 ? *trees[i] : *trees[0];
+        helpers.emplace_back(&MctsAI::runWorker, std::ref(tree), std::ref(search), nextSeed(), false);
+    }
+    runWorker(*trees[0], search, nextSeed(), true);
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+}
+
+Move MctsAI::searchPosition(Search& search, const FastBoard& rootPosition) {
+    std::vector<PackedMove> rootMoves(FastBoard::MAX_MOVES);
+    int rootMoveCount = rootPosition.generateMoves(rootMoves.data());
+    if (rootMoveCount == 0) {
+        throw std::runtime_error("No legal moves available");
+    }
+    if (rootMoveCount == 1 && !search.ponder) {
+        // Forced move; may run on the background thread, so clear directly rather than reset()
+        lastStats = SearchStats();
+        for (auto& tree : trees) {
+            tree->clear();
+        }
+        search.bestSoFar.store(rootMoves[0].code(), std::memory_order_relaxed);
+        return rootMoves[0].toMove();
+    }
+
+    SearchStats stats;
+    stats.ponderPlayouts = lastPonderPlayouts;
+    lastPonderPlayouts = 0;
+    if (prepareTrees(rootPosition, rootMoveCount)) {
+        for (auto& tree : trees) {
+            stats.reusedNodes += tree->nodeCount();
+        }
+    }
+    for (auto& tree : trees) {
+        stats.reusedVisits += tree->arena[tree->root].visits.load(std::memory_order_relaxed);
+    }
+
+    auto startTime = Clock::now();
+    search.deadline = startTime + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(search.limits.timeLimitSeconds));
+    runSearch(search);
+
+    if (search.ponder) {
+        lastPonderPlayouts = search.finished.load();
+    }
+
+    // Sum root children by move; with a single tree this is just its root's children
+    struct RootTotal {
+        PackedMove move;
+        uint64_t visits = 0;
+        uint64_t wins = 0;
+    };
+    std::unordered_map<uint32_t, RootTotal> totals;
+    size_t nodes = 0;
+    for (auto& tree : trees) {
+        nodes += tree->nodeCount();
+        for (Arena::Index child = tree->arena[tree->root].firstChild.load(std::memory_order_relaxed);
+             child != Arena::NONE; child = tree->arena[child].nextSibling) {
+            const Node& node = tree->arena[child];
+            RootTotal& total = totals[node.move.code()];
+            total.move = node.move;
+            total.visits += node.visits.load(std::memory_order_relaxed);
+            total.wins += node.wins.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Most visited child is the most robust choice; ties go to the lowest move code
+    const RootTotal* best = nullptr;
+    for (const auto& entry : totals) {
+        const RootTotal& total = entry.second;
+        if (!best || total.visits > best->visits ||
+            (total.visits == best->visits && total.move < best->move)) {
+            best = &total;
+        }
+    }
+    PackedMove chosen = best ? best->move : rootMoves[0];   // no playout finished: any legal move
+    search.bestSoFar.store(chosen.code(), std::memory_order_relaxed);
+
+    if (!search.ponder) {
+        double elapsed = std::chrono::duration<double>(Clock::now() - startTime).count();
+        stats.playouts = search.finished.load();
+        stats.nodes = nodes;
+        stats.threads = std::max(1u, config.threads);
+        stats.elapsedSeconds = elapsed;
+        stats.playoutsPerSecond = elapsed > 0 ? stats.playouts / elapsed : 0.0;
+        stats.bestWinRate = best && best->visits ? static_cast<double>(best->wins) / best->visits : 0.0;
+        lastStats = stats;
+    }
+    return chosen.toMove();
+}
+
+Move MctsAI::getBestMove(const GameState& gameState) {
+    stopSearch();
+    Search search(config, defaultLimits());
+    return searchPosition(search, FastBoard::fromGameState(gameState));
+}
+
+MctsAI::SearchHandle MctsAI::launch(std::shared_ptr<Search> search, const FastBoard& rootPosition) {
+    backgroundSearch = search;
+    background = std::thread([this, search, rootPosition]() {
+        try {
+            search->promise.set_value(searchPosition(*search, rootPosition));
+        } catch (...) {
+            search->promise.set_exception(std::current_exception());
+        }
+    });
+    return SearchHandle(std::move(search));
+}
+
+MctsAI::SearchHandle MctsAI::startSearch(const GameState& gameState, const SearchLimits& limits, StopToken cancel) {
+    stopSearch();
+    return launch(std::make_shared<Search>(config, limits, std::move(cancel)), FastBoard::fromGameState(gameState));
+}
+
+void MctsAI::stopSearch() {
+    if (!background.joinable()) {
+        return;
+    }
+    backgroundSearch->stop.requestStop();
+    background.join();
+    backgroundSearch.reset();
+}
+
+void MctsAI::startPondering(const GameState& gameState) {
+    stopSearch();
+    // Without tree reuse the next search could not pick up anything found here
+    if (!config.reuseTree || gameState.isGameOver()) {
+        return;
+    }
+    FastBoard position = FastBoard::fromGameState(gameState);
+    if (position.countMoves() < 2) {
+        return;
+    }
+    // No limits: the search runs until it is stopped or the arena fills up
+    auto search = std::make_shared<Search>(config, SearchLimits());
+    search->ponder = true;
+    launch(std::move(search), position);
+}
+
+void MctsAI::stopPondering() {
+    if (isPondering()) {
+        stopSearch();
+    }
+}
+
+bool MctsAI::isPondering() const {
+    return background.joinable() && backgroundSearch->ponder;
+}
+
+} // namespace amazons
@@ -0,0 +1,117 @@
+#include "ai/SelfPlay.hpp"
+#include "ai/Engine.hpp"
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace amazons {
+
+namespace {
+    TrainingRecord recordPosition(const GameState& state, int ply) {
+        FastBoard board = FastBoard::fromGameState(state);
+        TrainingRecord record;
+        record.arrows = board.arrows();
+        record.white = board.amazons(Player::WHITE);
+        record.black = board.amazons(Player::BLACK);
+        record.blackToMove = board.sideToMove() == Player::BLACK;
+        record.ply = static_cast<uint8_t>(ply);
+        return record;
+    }
+}
+
+SelfPlay::Stats SelfPlay::run(const Options& options, TrainingDataWriter& writer,
+                              const std::function<void(const Stats&)>& progress) {
+    // Fail fast on a bad spec instead of inside every worker
+    createEngine(options.engine);
+
+    const uint64_t baseSeed = options.seed ? options.seed
+        : static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    std::atomic<int> nextGame{0};
+    std::atomic<bool> stop{false};
+    std::mutex statsMutex;
+    std::exception_ptr failure;
+    Stats stats;
+    auto startTime = std::chrono::steady_clock::now();
+
+    auto worker = [&](unsigned index) {
+        try {
+            auto engine = createEngine(options.engine);
+            FastRandom rng(baseSeed + 0x9E3779B97F4A7C15ULL * (index + 1));
+            GameState state;
+            std::vector<TrainingRecord> records;
+
+            for (int game = nextGame++; game < options.games && !stop; game = nextGame++) {
+                state = GameState();
+                engine->newGame();
+                records.clear();
+
+                int ply = 0;
+                PackedMove randomMove;
+                for (; ply < options.randomPlies && !state.isGameOver(); ++ply) {
+                    FastBoard::fromGameState(state).randomMove(rng, randomMove);
+                    state.makeMove(randomMove.toMove());
+                }
+
+                while (!state.isGameOver()) {
+                    TrainingRecord record = recordPosition(state, ply);
+                    state.makeMove(engine->getBestMove(state));
+                    if (auto winRate = engine->getLastWinRate()) {
+                        record.hasScore = true;
+                        record.score = static_cast<int16_t>(std::lround((2.0 * *winRate - 1.0) * 1000.0));
+                    }
+                    records.push_back(record);
+                    ++ply;
+                }
+
+                const bool blackWon = state.getWinner() == Player::BLACK;
+                for (auto& record : records) {
+                    record.sideToMoveWon = record.blackToMove == blackWon;
+                }
+                size_t positions = records.size();
+                writer.submit(std::move(records));
+                records = std::vector<TrainingRecord>();
+
+                std::lock_guard<std::mutex> lock(statsMutex);
+                if (options.archive) {
+                    options.archive->add(state, GameMode::AI_VS_AI);
+                }
+                stats.games++;
+                stats.positions += positions;
+                stats.elapsedSeconds =
+                    std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+                if (progress) {
+                    progress(stats);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(statsMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            stop = true;
+        }
+    };
+
+    unsigned threads = std::max(1u, options.threads);
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < threads; ++i) {
+        pool.emplace_back(worker, i);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+    stats.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    return stats;
+}
+
+} // namespace amazons
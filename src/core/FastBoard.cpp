@@ -0,0 +1,279 @@
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <array>
+
+namespace amazons {
+
+namespace {
+    using SquareTable = std::array<uint64_t, FastBoard::SQUARES>;
+
+    // Ray directions; the first four walk towards higher square indices, the last four towards lower
+    constexpr int RAY_COUNT = 8;
+    constexpr int POSITIVE_RAYS = 4;
+    constexpr std::array<std::pair<int, int>, RAY_COUNT> RAY_DIRECTIONS = {{
+        {0, 1}, {1, -1}, {1, 0}, {1, 1},
+        {0, -1}, {-1, 1}, {-1, 0}, {-1, -1}
+    }};
+
+    constexpr std::array<SquareTable, RAY_COUNT> makeRays() {
+        std::array<SquareTable, RAY_COUNT> rays{};
+        for (int d = 0; d < RAY_COUNT; ++d) {
+            for (int sq = 0; sq < FastBoard::SQUARES; ++sq) {
+                int r = sq / Board::SIZE + RAY_DIRECTIONS[d].first;
+                int c = sq % Board::SIZE + RAY_DIRECTIONS[d].second;
+                uint64_t ray = 0;
+                while (r >= 0 && r < Board::SIZE && c >= 0 && c < Board::SIZE) {
+                    ray |= 1ULL << (r * Board::SIZE + c);
+                    r += RAY_DIRECTIONS[d].first;
+                    c += RAY_DIRECTIONS[d].second;
+                }
+                rays[d][sq] = ray;
+            }
+        }
+        return rays;
+    }
+
+    constexpr uint64_t splitMix(uint64_t& state) {
+        state += 0x9E3779B97F4A7C15ULL;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    struct ZobristKeys {
+        SquareTable arrow{};
+        SquareTable amazon[2]{};
+        uint64_t blackToMove{0};
+    };
+
+    constexpr ZobristKeys makeZobristKeys() {
+        ZobristKeys keys{};
+        uint64_t state = 0x416D617A6F6E73ULL; // "Amazons"
+        for (int sq = 0; sq < FastBoard::SQUARES; ++sq) {
+            keys.arrow[sq] = splitMix(state);
+            keys.amazon[0][sq] = splitMix(state);
+            keys.amazon[1][sq] = splitMix(state);
+        }
+        keys.blackToMove = splitMix(state);
+        return keys;
+    }
+
+    // Both tables are built by the compiler; nothing runs at startup
+    constexpr std::array<SquareTable, RAY_COUNT> RAYS = makeRays();
+    constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+    int nthBit(uint64_t bits, uint32_t n) {
+        while (n--) {
+            bits &= bits - 1;
+        }
+        return lowestBit(bits);
+    }
+}
+
+PackedMove PackedMove::fromMove(const Move& move) {
+    return PackedMove(static_cast<uint8_t>(FastBoard::squareOf(move.from.row, move.from.col)),
+                      static_cast<uint8_t>(FastBoard::squareOf(move.to.row, move.to.col)),
+                      static_cast<uint8_t>(FastBoard::squareOf(move.arrow.row, move.arrow.col)));
+}
+
+Move PackedMove::toMove() const {
+    auto position = [](uint8_t square) {
+        return Position(static_cast<int8_t>(square / Board::SIZE),
+                        static_cast<int8_t>(square % Board::SIZE));
+    };
+    return Move(position(from), position(to), position(arrow));
+}
+
+FastBoard::FastBoard() : arrowBits(0), amazonBits{0, 0}, side(Player::BLACK), key(0) {
+    key = computeHash();
+}
+
+FastBoard FastBoard::standardPosition() {
+    Board board;
+    board.initializeStandardPosition();
+    return fromBoard(board, Player::BLACK);
+}
+
+FastBoard FastBoard::fromBoard(const Board& board, Player sideToMove) {
+    FastBoard result;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            uint64_t bit = squareBit(squareOf(r, c));
+            switch (board.getCell(r, c)) {
+                case Board::Cell::ARROW: result.arrowBits |= bit; break;
+                case Board::Cell::WHITE_AMAZON: result.amazonBits[0] |= bit; break;
+                case Board::Cell::BLACK_AMAZON: result.amazonBits[1] |= bit; break;
+                case Board::Cell::EMPTY: break;
+            }
+        }
+    }
+    result.side = sideToMove;
+    result.key = result.computeHash();
+    return result;
+}
+
+FastBoard FastBoard::fromGameState(const GameState& gameState) {
+    return fromBoard(gameState.getBoard(), gameState.getCurrentPlayer());
+}
+
+FastBoard FastBoard::fromBitboards(uint64_t arrows, uint64_t white, uint64_t black, Player sideToMove) {
+    FastBoard result;
+    result.arrowBits = arrows;
+    result.amazonBits[0] = white;
+    result.amazonBits[1] = black;
+    result.side = sideToMove;
+    result.key = result.computeHash();
+    return result;
+}
+
+Board FastBoard::toBoard() const {
+    Board board;
+    for (int sq = 0; sq < SQUARES; ++sq) {
+        uint64_t bit = squareBit(sq);
+        int r = sq / Board::SIZE;
+        int c = sq % Board::SIZE;
+        if (arrowBits & bit) {
+            board.setCell(r, c, Board::Cell::ARROW);
+        } else if (amazonBits[0] & bit) {
+            board.setCell(r, c, Board::Cell::WHITE_AMAZON);
+        } else if (amazonBits[1] & bit) {
+            board.setCell(r, c, Board::Cell::BLACK_AMAZON);
+        }
+    }
+    return board;
+}
+
+uint64_t FastBoard::queenReach(int square, uint64_t occupancy) {
+    uint64_t reach = 0;
+    for (int d = 0; d < RAY_COUNT; ++d) {
+        uint64_t ray = RAYS[d][square];
+        uint64_t blockers = ray & occupancy;
+        if (blockers) {
+            int first = d < POSITIVE_RAYS ? lowestBit(blockers) : highestBit(blockers);
+            ray ^= RAYS[d][first];
+        }
+        reach |= ray;
+    }
+    return reach & ~occupancy;
+}
+
+void FastBoard::makeMove(PackedMove move) {
+    int mover = index(side);
+    amazonBits[mover] ^= squareBit(move.from) | squareBit(move.to);
+    arrowBits |= squareBit(move.arrow);
+    key ^= ZOBRIST.amazon[mover][move.from] ^ ZOBRIST.amazon[mover][move.to] ^
+           ZOBRIST.arrow[move.arrow] ^ ZOBRIST.blackToMove;
+    side = oppositePlayer(side);
+}
+
+void FastBoard::unmakeMove(PackedMove move) {
+    side = oppositePlayer(side);
+    int mover = index(side);
+    arrowBits &= ~squareBit(move.arrow);
+    amazonBits[mover] ^= squareBit(move.from) | squareBit(move.to);
+    key ^= ZOBRIST.amazon[mover][move.from] ^ ZOBRIST.amazon[mover][move.to] ^
+           ZOBRIST.arrow[move.arrow] ^ ZOBRIST.blackToMove;
+}
+
+bool FastBoard::isLegal(PackedMove move) const {
+    if (move.from >= SQUARES || move.to >= SQUARES || move.arrow >= SQUARES) {
+        return false;
+    }
+    if (!(amazonBits[index(side)] & squareBit(move.from))) {
+        return false;
+    }
+    uint64_t occupancy = occupied();
+    if (!(queenReach(move.from, occupancy) & squareBit(move.to))) {
+        return false;
+    }
+    // The amazon has left its square, so the arrow may pass through or land on it
+    uint64_t afterMove = (occupancy ^ squareBit(move.from)) | squareBit(move.to);
+    return (queenReach(move.to, afterMove) & squareBit(move.arrow)) != 0;
+}
+
+int FastBoard::generateMoves(PackedMove* out) const {
+    int count = 0;
+    uint64_t occupancy = occupied();
+    for (uint64_t pieces = amazonBits[index(side)]; pieces; pieces &= pieces - 1) {
+        int from = lowestBit(pieces);
+        uint64_t vacated = occupancy ^ squareBit(from);
+        for (uint64_t targets = queenReach(from, occupancy); targets; targets &= targets - 1) {
+            int to = lowestBit(targets);
+            uint64_t afterMove = vacated | squareBit(to);
+            for (uint64_t shots = queenReach(to, afterMove); shots; shots &= shots - 1) {
+                out[count++] = PackedMove(static_cast<uint8_t>(from), static_cast<uint8_t>(to),
+                                          static_cast<uint8_t>(lowestBit(shots)));
+            }
+        }
+    }
+    return count;
+}
+
+int FastBoard::countMoves() const {
+    int count = 0;
+    uint64_t occupancy = occupied();
+    for (uint64_t pieces = amazonBits[index(side)]; pieces; pieces &= pieces - 1) {
+        int from = lowestBit(pieces);
+        uint64_t vacated = occupancy ^ squareBit(from);
+        for (uint64_t targets = queenReach(from, occupancy); targets; targets &= targets - 1) {
+            int to = lowestBit(targets);
+            count += popCount(queenReach(to, vacated | squareBit(to)));
+        }
+    }
+    return count;
+}
+
+bool FastBoard::hasMoves(Player player) const {
+    // Any amazon that can step anywhere can always shoot back at the square it left
+    uint64_t occupancy = occupied();
+    for (uint64_t pieces = amazonBits[index(player)]; pieces; pieces &= pieces - 1) {
+        if (queenReach(lowestBit(pieces), occupancy)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FastBoard::randomMove(FastRandom& rng, PackedMove& out) const {
+    uint64_t occupancy = occupied();
+    int mobile[4];
+    uint64_t reach[4];
+    uint32_t mobileCount = 0;
+    for (uint64_t pieces = amazonBits[index(side)]; pieces && mobileCount < 4; pieces &= pieces - 1) {
+        int from = lowestBit(pieces);
+        uint64_t targets = queenReach(from, occupancy);
+        if (targets) {
+            mobile[mobileCount] = from;
+            reach[mobileCount] = targets;
+            ++mobileCount;
+        }
+    }
+    if (mobileCount == 0) {
+        return false;
+    }
+
+    uint32_t pick = rng.below(mobileCount);
+    int from = mobile[pick];
+    int to = nthBit(reach[pick], rng.below(static_cast<uint32_t>(popCount(reach[pick]))));
+    uint64_t shots = queenReach(to, (occupancy ^ squareBit(from)) | squareBit(to));
+    int arrow = nthBit(shots, rng.below(static_cast<uint32_t>(popCount(shots))));
+
+    out = PackedMove(static_cast<uint8_t>(from), static_cast<uint8_t>(to), static_cast<uint8_t>(arrow));
+    return true;
+}
+
+uint64_t FastBoard::computeHash() const {
+    uint64_t result = side == Player::BLACK ? ZOBRIST.blackToMove : 0;
+    for (uint64_t bits = arrowBits; bits; bits &= bits - 1) {
+        result ^= ZOBRIST.arrow[lowestBit(bits)];
+    }
+    for (int p = 0; p < 2; ++p) {
+        for (uint64_t bits = amazonBits[p]; bits; bits &= bits - 1) {
+            result ^= ZOBRIST.amazon[p][lowestBit(bits)];
+        }
+    }
+    return result;
+}
+
+} // namespace amazons
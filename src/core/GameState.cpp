@@ -95,10 +95,12 @@ GameState::GameState() : currentPlayer(Player::BLACK), turnNumber(1) {
 
 GameState::GameState(const Board& board, Player currentPlayer, int turnNumber) 
     : board(board), currentPlayer(currentPlayer), turnNumber(turnNumber) {
-    // Move history is not restored - this is a limitation
-    // In a full implementation, we would also save/restore move history
+    // Only the position is known; saves that keep the moves use the constructor below
 }
 
+GameState::GameState(const Board& board, Player currentPlayer, int turnNumber, std::vector<Move> moveHistory)
+    : board(board), currentPlayer(currentPlayer), turnNumber(turnNumber), moveHistory(std::move(moveHistory)) {}
+
 void GameState::initializeStandardGame() {
     board.initializeStandardPosition();
     currentPlayer = Player::BLACK;
@@ -207,6 +209,10 @@ void GameState::makeMove(const Move& move) {
     if (currentPlayer == Player::WHITE) {
         turnNumber++;
     }
+    
+    if (listener.current) {
+        listener.current->movePlayed(*this, move);
+    }
 }
 
 void GameState::undoLastMove() {
@@ -233,6 +239,10 @@ void GameState::undoLastMove() {
     if (currentPlayer == Player::BLACK) {
         turnNumber--;
     }
+    
+    if (listener.current) {
+        listener.current->moveUndone(*this);
+    }
 }
 
 bool GameState::hasLegalMoves(Player player) const {
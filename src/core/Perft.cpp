@@ -0,0 +1,104 @@
+#include "core/Perft.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+namespace amazons {
+
+namespace {
+    // Standard position leaf counts; depth 1 and 2 also agree with GameState's generator
+    constexpr uint64_t REFERENCE_COUNTS[] = {
+        1,              // depth 0
+        1232,
+        1331198,
+        1358441750
+    };
+
+    uint64_t countRecursive(FastBoard& board, int depth, bool bulk, std::vector<std::vector<PackedMove>>& buffers) {
+        if (depth == 0) {
+            return 1;
+        }
+        if (depth == 1 && bulk) {
+            return static_cast<uint64_t>(board.countMoves());
+        }
+        std::vector<PackedMove>& moves = buffers[depth];
+        int count = board.generateMoves(moves.data());
+        uint64_t nodes = 0;
+        for (int i = 0; i < count; ++i) {
+            board.makeMove(moves[i]);
+            nodes += countRecursive(board, depth - 1, bulk, buffers);
+            board.unmakeMove(moves[i]);
+        }
+        return nodes;
+    }
+
+    // One move buffer per ply so recursion never reallocates
+    std::vector<std::vector<PackedMove>> makeBuffers(int depth) {
+        return std::vector<std::vector<PackedMove>>(
+            static_cast<size_t>(depth) + 1, std::vector<PackedMove>(FastBoard::MAX_MOVES));
+    }
+}
+
+uint64_t Perft::count(FastBoard& board, int depth, bool bulk) {
+    if (depth < 0) {
+        throw std::invalid_argument("Perft depth must not be negative");
+    }
+    auto buffers = makeBuffers(depth);
+    return countRecursive(board, depth, bulk, buffers);
+}
+
+Perft::Result Perft::run(const FastBoard& board, const Options& options) {
+    if (options.depth < 1) {
+        throw std::invalid_argument("Perft depth must be at least 1");
+    }
+    auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<PackedMove> rootMoves(FastBoard::MAX_MOVES);
+    rootMoves.resize(static_cast<size_t>(board.generateMoves(rootMoves.data())));
+    std::vector<DivideEntry> entries(rootMoves.size());
+
+    // Threads pull root moves off a shared counter; each works on its own board copy
+    std::atomic<size_t> nextRoot{0};
+    auto worker = [&]() {
+        FastBoard local = board;
+        auto buffers = makeBuffers(options.depth);
+        for (size_t i = nextRoot++; i < rootMoves.size(); i = nextRoot++) {
+            local.makeMove(rootMoves[i]);
+            entries[i].move = rootMoves[i];
+            entries[i].nodes = countRecursive(local, options.depth - 1, options.bulk, buffers);
+            local.unmakeMove(rootMoves[i]);
+        }
+    };
+
+    unsigned threads = std::max(1u, std::min<unsigned>(options.threads, static_cast<unsigned>(rootMoves.size())));
+    std::vector<std::thread> helpers;
+    for (unsigned i = 1; i < threads; ++i) {
+        helpers.emplace_back(worker);
+    }
+    worker();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    Result result;
+    for (const auto& entry : entries) {
+        result.nodes += entry.nodes;
+    }
+    result.elapsedSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    result.nodesPerSecond = result.elapsedSeconds > 0 ? result.nodes / result.elapsedSeconds : 0.0;
+    if (options.divide) {
+        std::sort(entries.begin(), entries.end(),
+                  [](const DivideEntry& a, const DivideEntry& b) { return a.move < b.move; });
+        result.divide = std::move(entries);
+    }
+    return result;
+}
+
+uint64_t Perft::referenceCount(int depth) {
+    constexpr int known = static_cast<int>(sizeof(REFERENCE_COUNTS) / sizeof(REFERENCE_COUNTS[0]));
+    return depth >= 0 && depth < known ? REFERENCE_COUNTS[depth] : 0;
+}
+
+} // namespace amazons
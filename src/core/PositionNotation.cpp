@@ -0,0 +1,164 @@
+#include "core/PositionNotation.hpp"
+#include <array>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    const int AMAZONS_PER_SIDE = 4;
+    // Turn numbers past this are rejected rather than overflowing
+    const int MAX_TURN = 1 << 20;
+
+    enum Plane : uint8_t {
+        PLANE_WHITE,
+        PLANE_BLACK,
+        PLANE_ARROW,
+        PLANE_NONE      // empty runs and separators set a bit nobody reads
+    };
+
+    // What one character of the board field does
+    struct CellCode {
+        uint8_t advance;    // squares covered
+        uint8_t plane;
+        uint8_t slash;      // ends a row
+        uint8_t digit;      // an empty run; two in a row are not allowed
+        uint8_t invalid;
+    };
+
+    constexpr std::array<CellCode, 256> makeCellTable() {
+        std::array<CellCode, 256> table{};
+        for (auto& code : table) {
+            code = {0, PLANE_NONE, 0, 0, 1};
+        }
+        for (int run = 1; run <= 8; ++run) {
+            table['0' + run] = {static_cast<uint8_t>(run), PLANE_NONE, 0, 1, 0};
+        }
+        table['W'] = {1, PLANE_WHITE, 0, 0, 0};
+        table['B'] = {1, PLANE_BLACK, 0, 0, 0};
+        table['X'] = {1, PLANE_ARROW, 0, 0, 0};
+        table['/'] = {0, PLANE_NONE, 1, 0, 0};
+        return table;
+    }
+
+    constexpr std::array<CellCode, 256> CELL_TABLE = makeCellTable();
+
+    bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    // nullptr on success, otherwise what is wrong
+    const char* parseInto(std::string_view text, FastBoard& board, int& turnNumber) {
+        uint64_t planes[4] = {0, 0, 0, 0};
+        size_t pos = 0;
+        int square = 0;
+        int rowsEnded = 0;
+        unsigned bad = 0;
+        unsigned previousDigit = 0;
+        for (; pos < text.size() && text[pos] != ' '; ++pos) {
+            const CellCode code = CELL_TABLE[static_cast<unsigned char>(text[pos])];
+            bad |= code.invalid | (code.digit & previousDigit);
+            previousDigit = code.digit;
+            planes[code.plane] |= FastBoard::squareBit(square & 63);
+            square += code.advance;
+            bad |= square > FastBoard::SQUARES;
+            rowsEnded += code.slash;
+            // A slash has to fall exactly on the end of a row
+            bad |= code.slash & (square != rowsEnded * Board::SIZE);
+        }
+        if (bad || square != FastBoard::SQUARES || rowsEnded != Board::SIZE - 1) {
+            return "the board needs 8 rows of 8 cells from B, W, X and digits 1-8, separated by '/'";
+        }
+        if (popCount(planes[PLANE_WHITE]) != AMAZONS_PER_SIDE || popCount(planes[PLANE_BLACK]) != AMAZONS_PER_SIDE) {
+            return "each side needs exactly 4 amazons";
+        }
+
+        if (pos + 2 > text.size() || (text[pos + 1] != 'b' && text[pos + 1] != 'w')) {
+            return "the side to move must follow the board as b or w";
+        }
+        const Player side = text[pos + 1] == 'w' ? Player::WHITE : Player::BLACK;
+        pos += 2;
+
+        int turn = 1;
+        if (pos < text.size() && text[pos] == ' ' && pos + 1 < text.size() && !isSpace(text[pos + 1])) {
+            ++pos;
+            turn = 0;
+            const size_t start = pos;
+            while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9' && turn <= MAX_TURN) {
+                turn = turn * 10 + (text[pos++] - '0');
+            }
+            if (pos == start || turn < 1 || turn > MAX_TURN) {
+                return "the turn number must be a positive integer";
+            }
+        }
+        while (pos < text.size() && isSpace(text[pos])) {
+            ++pos;
+        }
+        if (pos != text.size()) {
+            return "unexpected text after the turn number";
+        }
+
+        board = FastBoard::fromBitboards(planes[PLANE_ARROW], planes[PLANE_WHITE], planes[PLANE_BLACK], side);
+        turnNumber = turn;
+        return nullptr;
+    }
+}
+
+std::string PositionNotation::format(const FastBoard& board, int turnNumber) {
+    std::string text;
+    text.reserve(40);
+    const uint64_t white = board.amazons(Player::WHITE);
+    const uint64_t black = board.amazons(Player::BLACK);
+    for (int row = 0; row < Board::SIZE; ++row) {
+        if (row > 0) {
+            text += '/';
+        }
+        int empty = 0;
+        for (int col = 0; col < Board::SIZE; ++col) {
+            const uint64_t bit = FastBoard::squareBit(FastBoard::squareOf(row, col));
+            const char cell = (white & bit) ? 'W' : (black & bit) ? 'B' : (board.arrows() & bit) ? 'X' : '\0';
+            if (!cell) {
+                ++empty;
+                continue;
+            }
+            if (empty) {
+                text += static_cast<char>('0' + empty);
+                empty = 0;
+            }
+            text += cell;
+        }
+        if (empty) {
+            text += static_cast<char>('0' + empty);
+        }
+    }
+    text += board.sideToMove() == Player::WHITE ? " w " : " b ";
+    text += std::to_string(turnNumber);
+    return text;
+}
+
+std::string PositionNotation::format(const GameState& gameState) {
+    return format(FastBoard::fromGameState(gameState), gameState.getTurnNumber());
+}
+
+FastBoard PositionNotation::parse(std::string_view text, int* turnNumber) {
+    FastBoard board;
+    int turn = 1;
+    if (const char* error = parseInto(text, board, turn)) {
+        throw std::invalid_argument("Invalid position \"" + std::string(text) + "\": " + error);
+    }
+    if (turnNumber) {
+        *turnNumber = turn;
+    }
+    return board;
+}
+
+GameState PositionNotation::parseGameState(std::string_view text) {
+    int turn = 1;
+    FastBoard board = parse(text, &turn);
+    return GameState(board.toBoard(), board.sideToMove(), turn);
+}
+
+bool PositionNotation::tryParse(std::string_view text, FastBoard& board, int& turnNumber) {
+    return parseInto(text, board, turnNumber) == nullptr;
+}
+
+} // namespace amazons
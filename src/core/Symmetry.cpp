@@ -0,0 +1,102 @@
+#include "core/Symmetry.hpp"
+
+namespace amazons {
+
+namespace {
+    const int TRANSPOSE = 4;
+    const int FLIP_ROWS = 2;
+    const int MIRROR_COLUMNS = 1;
+
+    // A transpose turns a later row flip into a column mirror and back, so
+    // undoing one swaps the two flip bits
+    const int INVERSE[Symmetry::COUNT] = {0, 1, 2, 3, 4, 6, 5, 7};
+
+    // Row r to row 7 - r: rows are bytes
+    uint64_t flipRows(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(bits);
+#else
+        bits = ((bits >> 8) & 0x00FF00FF00FF00FFULL) | ((bits & 0x00FF00FF00FF00FFULL) << 8);
+        bits = ((bits >> 16) & 0x0000FFFF0000FFFFULL) | ((bits & 0x0000FFFF0000FFFFULL) << 16);
+        return (bits >> 32) | (bits << 32);
+#endif
+    }
+
+    // Column c to column 7 - c: reverse the bits of every byte
+    uint64_t mirrorColumns(uint64_t bits) {
+        bits = ((bits >> 1) & 0x5555555555555555ULL) | ((bits & 0x5555555555555555ULL) << 1);
+        bits = ((bits >> 2) & 0x3333333333333333ULL) | ((bits & 0x3333333333333333ULL) << 2);
+        return ((bits >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((bits & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    }
+
+    // (row, col) to (col, row) with three delta swaps
+    uint64_t transpose(uint64_t bits) {
+        uint64_t t = 0x0F0F0F0F00000000ULL & (bits ^ (bits << 28));
+        bits ^= t ^ (t >> 28);
+        t = 0x3333000033330000ULL & (bits ^ (bits << 14));
+        bits ^= t ^ (t >> 14);
+        t = 0x5500550055005500ULL & (bits ^ (bits << 7));
+        return bits ^ t ^ (t >> 7);
+    }
+}
+
+uint64_t Symmetry::transform(uint64_t bits, int symmetry) {
+    if (symmetry & TRANSPOSE) {
+        bits = transpose(bits);
+    }
+    if (symmetry & FLIP_ROWS) {
+        bits = flipRows(bits);
+    }
+    if (symmetry & MIRROR_COLUMNS) {
+        bits = mirrorColumns(bits);
+    }
+    return bits;
+}
+
+int Symmetry::transformSquare(int square, int symmetry) {
+    int row = square / Board::SIZE;
+    int col = square % Board::SIZE;
+    if (symmetry & TRANSPOSE) {
+        const int swapped = row;
+        row = col;
+        col = swapped;
+    }
+    if (symmetry & FLIP_ROWS) {
+        row = Board::SIZE - 1 - row;
+    }
+    if (symmetry & MIRROR_COLUMNS) {
+        col = Board::SIZE - 1 - col;
+    }
+    return FastBoard::squareOf(row, col);
+}
+
+PackedMove Symmetry::transform(PackedMove move, int symmetry) {
+    return PackedMove(static_cast<uint8_t>(transformSquare(move.from, symmetry)),
+                      static_cast<uint8_t>(transformSquare(move.to, symmetry)),
+                      static_cast<uint8_t>(transformSquare(move.arrow, symmetry)));
+}
+
+FastBoard Symmetry::transform(const FastBoard& board, int symmetry) {
+    return FastBoard::fromBitboards(transform(board.arrows(), symmetry),
+                                    transform(board.amazons(Player::WHITE), symmetry),
+                                    transform(board.amazons(Player::BLACK), symmetry), board.sideToMove());
+}
+
+int Symmetry::inverse(int symmetry) {
+    return INVERSE[symmetry];
+}
+
+Symmetry::Canonical Symmetry::canonical(const FastBoard& board) {
+    // The lowest-numbered symmetry wins ties, so a position that is its own
+    // mirror image always maps the same way
+    Canonical best{board.hash(), 0};
+    for (int symmetry = 1; symmetry < COUNT; ++symmetry) {
+        const uint64_t key = transform(board, symmetry).hash();
+        if (key < best.key) {
+            best = {key, symmetry};
+        }
+    }
+    return best;
+}
+
+} // namespace amazons
@@ -1,12 +1,16 @@
 #include "ui/GraphicalController.hpp"
 #include "ui/Display.hpp"
 #include <iostream>
-#include <thread>
 #include <chrono>
 #include <ctime>
 
 namespace amazons {
 
+namespace {
+    // Save name of the crash-recovery journal
+    const char* const AUTOSAVE_NAME = "autosave";
+}
+
 GraphicalController::GraphicalController()
     : savedGameMode(GameModeGUI::NOT_SELECTED),
       selectionState(SelectionState::NO_SELECTION),
@@ -22,6 +26,7 @@ GraphicalController::GraphicalController()
     if (!initialize()) {
         throw std::runtime_error("Failed to initialize GraphicalController");
     }
+    recoverUnfinishedGame();
 }
 
 GraphicalController::~GraphicalController() {
@@ -44,8 +49,10 @@ bool GraphicalController::initialize() {
         std::cerr << "Warning: Could not load all resources\n";
     }
     
-    // Initialize AI
-    ai = std::make_unique<BasicAI>();
+    // Initialize AI; it keeps its search tree across turns and re-roots on the position it is given
+    MctsAI::Config aiConfig;
+    aiConfig.timeLimitSeconds = 2.0;
+    ai = std::make_unique<MctsAI>(aiConfig);
     
     return true;
 }
@@ -64,6 +71,8 @@ bool GraphicalController::loadResources() {
 void GraphicalController::run() {
     while (window->isOpen()) {
         handleEvents();
+        pollAISearch();
+        pollSaves();
         render();
     }
 }
@@ -197,6 +206,7 @@ void GraphicalController::handleKeyPress(sf::Keyboard::Key key) {
         case sf::Keyboard::Key::R:
             // Restart - return to mode selection
             if (gameState) {
+                cancelAISearch();
                 showModeSelection = true;
                 gameState.reset();
                 resetSelection();
@@ -206,6 +216,7 @@ void GraphicalController::handleKeyPress(sf::Keyboard::Key key) {
         case sf::Keyboard::Key::U:
             // Undo move
             if (gameState && gameState->canUndo()) {
+                cancelAISearch();
                 // Check if we're in AI vs Human mode and it's human's turn
                 bool isHumanVsAI = (currentGameMode == GameModeGUI::HUMAN_VS_AI_HUMAN_WHITE || 
                                    currentGameMode == GameModeGUI::HUMAN_VS_AI_HUMAN_BLACK);
@@ -242,12 +253,21 @@ void GraphicalController::handleKeyPress(sf::Keyboard::Key key) {
                 
                 resetSelection();
                 updateStatusMessage();
+                scheduleAI();
+            }
+            break;
+            
+        case sf::Keyboard::Key::M:
+            // Move now: the AI plays the best move found so far
+            if (aiSearch.valid()) {
+                aiSearch.stop();
             }
             break;
             
         case sf::Keyboard::Key::Escape:
             // Return to main menu instead of closing window
             if (gameState) {
+                cancelAISearch();
                 // Save current game state for "Continue" feature
                 savedGameState = std::make_unique<GameState>(*gameState);
                 savedGameMode = currentGameMode;
@@ -276,10 +296,12 @@ void GraphicalController::continueGame() {
     
     // Restore saved game state
     gameState = std::make_unique<GameState>(*savedGameState);
+    startJournal();
     
     // Reset selection state
     resetSelection();
     updateStatusMessage();
+    scheduleAI();
 }
 
 void GraphicalController::startGame(GameModeGUI mode) {
@@ -294,15 +316,14 @@ void GraphicalController::startGame(GameModeGUI mode) {
     // Create new game state
     gameState = std::make_unique<GameState>();
     gameState->initializeStandardGame();
+    startJournal();
     
     // Reset selection state
     resetSelection();
     updateStatusMessage();
     
-    // If AI is black (human is white), AI moves first
-    if (currentGameMode == GameModeGUI::HUMAN_VS_AI_HUMAN_WHITE) {
-        processAIMove();
-    }
+    // If AI is black (human is white), AI moves first; otherwise it ponders
+    scheduleAI();
 }
 
 void GraphicalController::selectAmazon(const Position& pos) {
@@ -429,32 +450,68 @@ void GraphicalController::processAIMove() {
     // Show AI thinking status
     statusMessage = "AI is thinking...";
     
-    // Process AI move asynchronously to avoid blocking UI
-    std::thread([this]() {
-        try {
-            // Simulate AI thinking time (max 3 seconds as requested)
-            auto startTime = std::chrono::steady_clock::now();
-            Move aiMove = ai->getBestMove(*gameState);
-            auto endTime = std::chrono::steady_clock::now();
-            
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-            
-            // Ensure minimum thinking time for visual feedback (300ms)
-            if (elapsed < std::chrono::milliseconds(300)) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(300) - elapsed);
-            }
-            
-            // Execute AI move on main thread (UI thread)
-            // Note: In a real implementation, we'd need proper thread synchronization
-            // For now, we'll execute directly since SFML events are processed in main thread
+    // Search in the background; pollAISearch() applies the result on this thread
+    aiSearch = ai->startSearch(*gameState);
+    aiSearchStarted = std::chrono::steady_clock::now();
+}
+
+void GraphicalController::pollAISearch() {
+    if (!aiSearch.valid()) return;
+    
+    if (!aiSearch.isReady()) {
+        if (auto best = aiSearch.bestSoFar()) {
+            statusMessage = "AI is thinking... (best so far " + best->toString() + ", M: move now)";
+        }
+        return;
+    }
+    
+    // Ensure minimum thinking time for visual feedback (300ms)
+    if (std::chrono::steady_clock::now() - aiSearchStarted < std::chrono::milliseconds(300)) {
+        return;
+    }
+    
+    MctsAI::SearchHandle finished = aiSearch;
+    aiSearch = MctsAI::SearchHandle();
+    try {
+        Move aiMove = finished.result().get();
+        if (gameState && gameState->isValidMove(aiMove)) {
             gameState->makeMove(aiMove);
             updateStatusMessage();
-            
-        } catch (const std::exception& e) {
-            std::cerr << "AI error: " << e.what() << "\n";
-            statusMessage = "AI error occurred";
+            scheduleAI();
         }
-    }).detach(); // Detach thread to run independently
+    } catch (const std::exception& e) {
+        std::cerr << "AI error: " << e.what() << "\n";
+        statusMessage = "AI error occurred";
+    }
+}
+
+void GraphicalController::cancelAISearch() {
+    // Drops a pending result and stops pondering as well
+    aiSearch = MctsAI::SearchHandle();
+    if (ai) {
+        ai->stopSearch();
+    }
+}
+
+void GraphicalController::scheduleAI() {
+    if (!gameState || !ai || gameState->isGameOver()) return;
+    
+    Player humanColor;
+    if (currentGameMode == GameModeGUI::HUMAN_VS_AI_HUMAN_BLACK) {
+        humanColor = Player::BLACK;
+    } else if (currentGameMode == GameModeGUI::HUMAN_VS_AI_HUMAN_WHITE) {
+        humanColor = Player::WHITE;
+    } else {
+        return;
+    }
+    
+    // On the human's turn search on their time; the AI's next search starts from whatever matches.
+    // Only ever called on the UI thread, which also stops pondering on R, U and Escape
+    if (gameState->getCurrentPlayer() == humanColor) {
+        ai->startPondering(*gameState);
+    } else {
+        processAIMove();
+    }
 }
 
 void GraphicalController::resetSelection() {
@@ -729,7 +786,7 @@ void GraphicalController::drawUI() {
     window->draw(status);
     
     // Instructions
-    std::string instructions = "R: Restart | U: Undo | ESC: Menu";
+    std::string instructions = "R: Restart | U: Undo | M: Move now | ESC: Menu";
     if (selectionState == SelectionState::AMAZON_SELECTED) {
         instructions += " | Click on highlighted teal cells to move";
     } else if (selectionState == SelectionState::MOVE_SELECTED) {
@@ -832,31 +889,82 @@ void GraphicalController::saveCurrentGame() {
     std::strftime(buffer, sizeof(buffer), "game_%Y%m%d_%H%M%S", &tm);
     std::string filename(buffer);
     
+    // Snapshotted here, written by the saver's thread; pollSaves() reports back
+    saver.save(*gameState, serializedGameMode(), filename, Serializer::SaveFormat::RECORD);
+    statusMessage = "Saving " + filename + "...";
+}
+
+GameMode GraphicalController::serializedGameMode() const {
     // Convert GameModeGUI to GameMode
-    GameMode gameMode;
     switch (currentGameMode) {
-        case GameModeGUI::HUMAN_VS_HUMAN:
-            gameMode = GameMode::HUMAN_VS_HUMAN;
-            break;
         case GameModeGUI::HUMAN_VS_AI_HUMAN_WHITE:
-            gameMode = GameMode::HUMAN_VS_AI_HUMAN_WHITE;
-            break;
+            return GameMode::HUMAN_VS_AI_HUMAN_WHITE;
         case GameModeGUI::HUMAN_VS_AI_HUMAN_BLACK:
-            gameMode = GameMode::HUMAN_VS_AI_HUMAN_BLACK;
-            break;
+            return GameMode::HUMAN_VS_AI_HUMAN_BLACK;
         default:
-            gameMode = GameMode::HUMAN_VS_HUMAN;
+            return GameMode::HUMAN_VS_HUMAN;
+    }
+}
+
+void GraphicalController::startJournal() {
+    // Each game put in play gets a fresh journal, replacing the last one's
+    gameState->setListener(nullptr);
+    journal.reset();
+    try {
+        journal = std::make_unique<GameJournal>(serializer.getJournalPath(AUTOSAVE_NAME), *gameState, serializedGameMode());
+        gameState->setListener(journal.get());
+    } catch (const std::exception& e) {
+        std::cerr << "Autosave disabled: " << e.what() << std::endl;
+    }
+}
+
+void GraphicalController::recoverUnfinishedGame() {
+    const std::string path = serializer.getJournalPath(AUTOSAVE_NAME);
+    if (!GameJournal::exists(path)) {
+        return;
+    }
+    std::pair<std::unique_ptr<GameState>, GameMode> recovered;
+    try {
+        recovered = GameJournal::recover(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Could not recover the last game: " << e.what() << std::endl;
+    }
+    // A game that ended needs no recovery
+    if (!recovered.first || recovered.first->isGameOver()) {
+        GameJournal::remove(path);
+        return;
     }
     
-    if (serializer.saveGame(*gameState, gameMode, filename)) {
-        statusMessage = "Game saved: " + filename;
-    } else {
-        statusMessage = "Failed to save game!";
+    // Offered through the Continue button, like a game left for the menu
+    savedGameState = std::move(recovered.first);
+    switch (recovered.second) {
+        case GameMode::HUMAN_VS_AI_HUMAN_WHITE:
+            savedGameMode = GameModeGUI::HUMAN_VS_AI_HUMAN_WHITE;
+            break;
+        case GameMode::HUMAN_VS_AI_HUMAN_BLACK:
+            savedGameMode = GameModeGUI::HUMAN_VS_AI_HUMAN_BLACK;
+            break;
+        default:
+            savedGameMode = GameModeGUI::HUMAN_VS_HUMAN;
+    }
+    statusMessage = "Unfinished game recovered - Continue to resume it";
+}
+
+void GraphicalController::pollSaves() {
+    for (const AsyncSaver::Outcome& outcome : saver.takeFinished()) {
+        if (outcome.saved) {
+            statusMessage = "Game saved: " + outcome.name;
+        } else {
+            std::cerr << "Error saving game: " << outcome.error << std::endl;
+            statusMessage = "Failed to save game!";
+        }
     }
 }
 
 void GraphicalController::loadSavedGamesList() {
-    savedGamesList = serializer.getSavedGames();
+    // A save still in flight should be in the list
+    saver.flush();
+    savedGamesList = serializer.listSaves();
 }
 
 void GraphicalController::openLoadScreen() {
@@ -928,7 +1036,7 @@ void GraphicalController::handleLoadScreenClick(int x, int y) {
         if (x >= buttonX && x <= buttonX + buttonWidth &&
             y >= loadButtonY && y <= loadButtonY + buttonHeight) {
             // Load the selected game
-            std::string selectedSave = savedGamesList[selectedSaveIndex];
+            std::string selectedSave = savedGamesList[selectedSaveIndex].name;
             auto result = serializer.loadGameWithMode(selectedSave);
             
             if (result.first) {
@@ -951,9 +1059,11 @@ void GraphicalController::handleLoadScreenClick(int x, int y) {
                 
                 showLoadScreen = false;
                 showModeSelection = false;
+                startJournal();
                 resetSelection();
                 updateStatusMessage();
                 statusMessage = "Game loaded: " + selectedSave;
+                scheduleAI();
             } else {
                 statusMessage = "Failed to load game!";
             }
@@ -1024,7 +1134,8 @@ void GraphicalController::drawLoadScreen() {
             window->draw(button);
             
             // Button text
-            sf::Text btnText(font, savedGamesList[i], 18);
+            const SaveInfo& save = savedGamesList[i];
+            sf::Text btnText(font, save.name + "  (turn " + std::to_string(save.turnNumber) + ")", 18);
             btnText.setFillColor(sf::Color::White);
             sf::FloatRect textBounds = btnText.getLocalBounds();
             btnText.setPosition({buttonX + (buttonWidth - textBounds.size.x) / 2, 
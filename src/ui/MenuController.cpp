@@ -4,7 +4,7 @@
 #include "ui/GraphicalDisplay.hpp"
 #endif
 #include "utils/Serializer.hpp"
-#include "ai/BasicAI.hpp"
+#include "ai/MctsAI.hpp"
 #include <iostream>
 #include <limits>
 #include <cstdlib>
@@ -13,15 +13,28 @@
 
 namespace amazons {
 
+namespace {
+    // Save name of the crash-recovery journal
+    const char* const AUTOSAVE_NAME = "autosave";
+    
+    MctsAI::Config aiConfig() {
+        MctsAI::Config config;
+        config.timeLimitSeconds = 2.0;
+        return config;
+    }
+}
+
 MenuController::MenuController() 
     : gameState(std::make_unique<GameState>()), 
       display(createDisplay()),
-      currentGameMode(GameMode::HUMAN_VS_HUMAN) {}
+      currentGameMode(GameMode::HUMAN_VS_HUMAN),
+      ai(std::make_unique<MctsAI>(aiConfig())) {}
 
 MenuController::MenuController(std::unique_ptr<Display> display)
     : gameState(std::make_unique<GameState>()),
       display(std::move(display)),
-      currentGameMode(GameMode::HUMAN_VS_HUMAN) {}
+      currentGameMode(GameMode::HUMAN_VS_HUMAN),
+      ai(std::make_unique<MctsAI>(aiConfig())) {}
 
 MenuController::~MenuController() = default;
 
@@ -39,6 +52,7 @@ std::unique_ptr<Display> MenuController::createDisplay(bool useGraphical) {
 }
 
 void MenuController::run() {
+    recoverUnfinishedGame();
     mainMenu();
 }
 
@@ -103,6 +117,7 @@ bool MenuController::makePlayerMove() {
     // Fall back to text input
     while (true) {
         try {
+            reportSaves();
             std::cout << "Enter your move as 6 numbers: from_row from_col to_row to_col arrow_row arrow_col\n";
             std::cout << "Or enter 'help' to see legal moves, 'undo' to undo last move, 'save' to save game, or 'exit' to return to main menu: ";
             
@@ -329,8 +344,11 @@ void MenuController::newGame() {
 void MenuController::loadGame() {
     std::cout << "\n=== Load Game ===\n";
     
+    // Saves still being written belong in the list
+    saver.flush();
+    reportSaves();
     Serializer serializer;
-    auto savedGames = serializer.getSavedGames();
+    auto savedGames = serializer.listSaves();
     
     if (savedGames.empty()) {
         std::cout << "No saved games found.\n";
@@ -341,7 +359,8 @@ void MenuController::loadGame() {
     
     std::cout << "Saved games:\n";
     for (size_t i = 0; i < savedGames.size(); ++i) {
-        std::cout << "  " << (i + 1) << ". " << savedGames[i] << "\n";
+        std::cout << "  " << (i + 1) << ". " << savedGames[i].name << " (turn " << savedGames[i].turnNumber
+                  << ", " << gameModeToString(savedGames[i].gameMode) << ")\n";
     }
     std::cout << "  0. Back to Main Menu\n";
     std::cout << "\nSelect a game to load (0-" << savedGames.size() << "): ";
@@ -362,7 +381,7 @@ void MenuController::loadGame() {
             return;
         }
         
-        std::string selectedGame = savedGames[choice - 1];
+        std::string selectedGame = savedGames[choice - 1].name;
         loadAndRunGame(selectedGame);
     } catch (const std::exception& e) {
         std::cout << "Invalid input: " << e.what() << "\n";
@@ -414,7 +433,7 @@ void MenuController::saveGame() {
         }
     }
     
-    if (serializer.saveGame(*gameState, currentGameMode, input)) {
+    if (serializer.saveGame(*gameState, currentGameMode, input, Serializer::SaveFormat::RECORD)) {
         std::cout << "Game saved successfully as '" << input << "'.\n";
     } else {
         std::cout << "Failed to save game.\n";
@@ -453,7 +472,7 @@ void MenuController::saveCurrentGame() {
     }
     
     // Check if save already exists
-    if (serializer.saveExists(input)) {
+    if (saver.isPending(input) || serializer.saveExists(input)) {
         std::cout << "A save with name '" << input << "' already exists.\n";
         if (!confirmAction("Overwrite? (y/n): ")) {
             std::cout << "Save cancelled.\n";
@@ -461,15 +480,64 @@ void MenuController::saveCurrentGame() {
         }
     }
     
-    if (serializer.saveGame(*gameState, currentGameMode, input)) {
-        std::cout << "Game saved successfully as '" << input << "'.\n";
-    } else {
-        std::cout << "Failed to save game.\n";
+    // The game goes on while the save is written; the outcome is reported at the next prompt
+    saver.save(*gameState, currentGameMode, input, Serializer::SaveFormat::RECORD);
+    std::cout << "Saving game as '" << input << "'...\n";
+}
+
+void MenuController::startJournal() {
+    // Every game loop starts a fresh journal, replacing the last game's
+    gameState->setListener(nullptr);
+    journal.reset();
+    try {
+        journal = std::make_unique<GameJournal>(Serializer().getJournalPath(AUTOSAVE_NAME), *gameState, currentGameMode);
+        gameState->setListener(journal.get());
+    } catch (const std::exception& e) {
+        std::cerr << "Autosave disabled: " << e.what() << "\n";
+    }
+}
+
+void MenuController::recoverUnfinishedGame() {
+    const std::string path = Serializer().getJournalPath(AUTOSAVE_NAME);
+    if (!GameJournal::exists(path)) {
+        return;
+    }
+    std::pair<std::unique_ptr<GameState>, GameMode> recovered;
+    try {
+        recovered = GameJournal::recover(path);
+    } catch (const std::exception& e) {
+        std::cerr << "Could not recover the last game: " << e.what() << "\n";
+    }
+    // A game that ended needs no recovery
+    if (!recovered.first || recovered.first->isGameOver()) {
+        GameJournal::remove(path);
+        return;
+    }
+    
+    std::cout << "\nAn unfinished game from the last session was found ("
+              << gameModeToString(recovered.second) << ", turn " << recovered.first->getTurnNumber() << ").\n";
+    if (!confirmAction("Resume it? (y/n): ")) {
+        GameJournal::remove(path);
+        return;
+    }
+    gameState = std::move(recovered.first);
+    currentGameMode = recovered.second;
+    runCurrentGame();
+}
+
+void MenuController::reportSaves() {
+    for (const AsyncSaver::Outcome& outcome : saver.takeFinished()) {
+        if (outcome.saved) {
+            std::cout << "Game saved successfully as '" << outcome.name << "'.\n";
+        } else {
+            std::cout << "Failed to save game '" << outcome.name << "': " << outcome.error << "\n";
+        }
     }
 }
 
 void MenuController::gameLoop() {
     if (!gameState) return;
+    startJournal();
     
     // Main game loop
     while (!gameState->isGameOver()) {
@@ -497,8 +565,10 @@ void MenuController::gameLoop() {
 
 void MenuController::humanVsAIGameLoop() {
     if (!gameState) return;
+    startJournal();
     
-    BasicAI ai;
+    // New or freshly loaded game: nothing in the old tree applies
+    ai->reset();
     
     // Determine human and AI colors based on game mode
     Player humanColor;
@@ -516,8 +586,11 @@ void MenuController::humanVsAIGameLoop() {
         std::cout << Display::playerToString(current) << "'s turn.\n";
         
         if (current == humanColor) {
-            // Human turn
-            if (!makePlayerMove()) {
+            // Human turn; the engine keeps searching while the human thinks
+            ai->startPondering(*gameState);
+            bool moved = makePlayerMove();
+            ai->stopPondering();
+            if (!moved) {
                 // User wants to exit to main menu
                 return;
             }
@@ -527,9 +600,12 @@ void MenuController::humanVsAIGameLoop() {
             std::this_thread::sleep_for(std::chrono::milliseconds(500)); // Small delay for realism
             
             try {
-                Move aiMove = ai.getBestMove(*gameState);
+                Move aiMove = ai->getBestMove(*gameState);
                 gameState->makeMove(aiMove);
-                std::cout << "AI made move: " << aiMove.toString() << "\n";
+                const MctsAI::SearchStats& stats = ai->getLastStats();
+                std::cout << "AI made move: " << aiMove.toString()
+                          << " (" << stats.playouts << " playouts, "
+                          << stats.reusedVisits << " reused)\n";
             } catch (const std::exception& e) {
                 std::cout << "AI error: " << e.what() << "\n";
                 break;
@@ -554,8 +630,10 @@ void MenuController::humanVsAIGameLoop() {
 
 void MenuController::aiVsAiGameLoop() {
     if (!gameState) return;
+    startJournal();
     
-    BasicAI ai;
+    // One engine plays both sides, so each search starts from the previous one's subtree
+    ai->reset();
     int moveCount = 0;
     const int MAX_MOVES = 200; // Prevent infinite loops
     
@@ -570,9 +648,10 @@ void MenuController::aiVsAiGameLoop() {
         std::this_thread::sleep_for(std::chrono::milliseconds(1000)); // Delay for visibility
         
         try {
-            Move aiMove = ai.getBestMove(*gameState);
+            Move aiMove = ai->getBestMove(*gameState);
             gameState->makeMove(aiMove);
-            std::cout << "AI made move: " << aiMove.toString() << "\n";
+            std::cout << "AI made move: " << aiMove.toString()
+                      << " (" << ai->getLastStats().playouts << " playouts)\n";
             moveCount++;
         } catch (const std::exception& e) {
             std::cout << "AI error: " << e.what() << "\n";
@@ -605,10 +684,8 @@ void MenuController::aiVsAiGameLoop() {
 void MenuController::makeAIMove() {
     if (!gameState) return;
     
-    BasicAI ai;
-    
     try {
-        Move aiMove = ai.getBestMove(*gameState);
+        Move aiMove = ai->getBestMove(*gameState);
         gameState->makeMove(aiMove);
         std::cout << "AI made move: " << aiMove.toString() << "\n";
     } catch (const std::exception& e) {
@@ -631,7 +708,10 @@ void MenuController::loadAndRunGame(const std::string& filename) {
     currentGameMode = result.second;
     
     std::cout << "Game loaded successfully. Game mode: " << gameModeToString(currentGameMode) << "\n";
-    
+    runCurrentGame();
+}
+
+void MenuController::runCurrentGame() {
     // Run appropriate game loop based on saved game mode
     switch (currentGameMode) {
         case GameMode::HUMAN_VS_HUMAN:
@@ -0,0 +1,118 @@
+#include "utils/AsyncSaver.hpp"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace amazons {
+
+struct AsyncSaver::Impl {
+    struct Job {
+        GameState snapshot;
+        GameMode gameMode;
+        Serializer::SaveFormat format;
+    };
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;       // work queued or stopping
+    std::condition_variable idle;       // queue drained
+    std::deque<std::string> order;      // slots in the order they were first queued
+    std::unordered_map<std::string, Job> queued;
+    std::string writing;                // slot being written, if busy
+    bool busy = false;
+    std::vector<Outcome> finished;
+    bool stopping = false;
+    Serializer serializer;              // only the worker touches it
+    std::thread worker;
+
+    void run();
+};
+
+AsyncSaver::AsyncSaver() : impl(std::make_unique<Impl>()) {
+    impl->worker = std::thread(&Impl::run, impl.get());
+}
+
+AsyncSaver::AsyncSaver(const std::string& saveDirectory) : impl(std::make_unique<Impl>()) {
+    impl->serializer = Serializer(saveDirectory);
+    impl->worker = std::thread(&Impl::run, impl.get());
+}
+
+AsyncSaver::~AsyncSaver() {
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->stopping = true;
+    }
+    impl->wake.notify_all();
+    // The worker drains the queue before it exits
+    impl->worker.join();
+}
+
+void AsyncSaver::save(const GameState& gameState, GameMode gameMode, const std::string& name,
+                      Serializer::SaveFormat format) {
+    Impl::Job job{gameState, gameMode, format};
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        auto found = impl->queued.find(name);
+        if (found != impl->queued.end()) {
+            // Not written yet: the newer snapshot takes its place in the queue
+            found->second = std::move(job);
+            return;
+        }
+        impl->queued.emplace(name, std::move(job));
+        impl->order.push_back(name);
+    }
+    impl->wake.notify_one();
+}
+
+bool AsyncSaver::isPending(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    return (impl->busy && impl->writing == name) || impl->queued.count(name) != 0;
+}
+
+void AsyncSaver::flush() {
+    std::unique_lock<std::mutex> lock(impl->mutex);
+    impl->idle.wait(lock, [this] { return impl->order.empty() && !impl->busy; });
+}
+
+std::vector<AsyncSaver::Outcome> AsyncSaver::takeFinished() {
+    std::lock_guard<std::mutex> lock(impl->mutex);
+    std::vector<Outcome> result;
+    result.swap(impl->finished);
+    return result;
+}
+
+void AsyncSaver::Impl::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this] { return stopping || !order.empty(); });
+        if (order.empty()) {
+            return;     // stopping, and nothing left to write
+        }
+        writing = std::move(order.front());
+        busy = true;
+        order.pop_front();
+        auto found = queued.find(writing);
+        Job job = std::move(found->second);
+        queued.erase(found);
+
+        // The disk is touched without the lock, so save() never waits on it
+        lock.unlock();
+        Outcome outcome{writing, true, ""};
+        try {
+            serializer.writeSave(job.snapshot, job.gameMode, writing, job.format);
+        } catch (const std::exception& e) {
+            outcome.saved = false;
+            outcome.error = e.what();
+        }
+        lock.lock();
+
+        finished.push_back(std::move(outcome));
+        busy = false;
+        if (order.empty()) {
+            idle.notify_all();
+        }
+    }
+}
+
+} // namespace amazons
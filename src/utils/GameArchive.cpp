@@ -0,0 +1,508 @@
+#include "utils/GameArchive.hpp"
+#include "core/FastBoard.hpp"
+#include "utils/GameRecord.hpp"
+#include "utils/MappedFile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <mutex>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+namespace amazons {
+
+namespace {
+    const char MAGIC[8] = {'A', 'M', 'Z', 'A', 'R', 'C', '0', '1'};
+    const char INDEX_MAGIC[8] = {'A', 'M', 'Z', 'A', 'I', 'X', '0', '1'};
+    const size_t HEADER_SIZE = 16;
+    const size_t BLOCK_HEADER_SIZE = 12;
+    const size_t FOOTER_SIZE = 28;
+    const uint32_t GAME_MODES = static_cast<uint32_t>(GameMode::AI_VS_AI) + 1;
+
+    void put32(unsigned char* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    void put64(unsigned char* out, uint64_t value) {
+        put32(out, static_cast<uint32_t>(value));
+        put32(out + 4, static_cast<uint32_t>(value >> 32));
+    }
+
+    uint32_t get32(const unsigned char* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+               (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    uint64_t get64(const unsigned char* in) {
+        return get32(in) | (static_cast<uint64_t>(get32(in + 4)) << 32);
+    }
+
+    // Subbotin's carryless range coder. Totals are at most BOTTOM, which the
+    // 3072 moves an 8x8 position can have stay well below.
+    const uint32_t TOP = 1u << 24;
+    const uint32_t BOTTOM = 1u << 16;
+
+    class RangeEncoder {
+    public:
+        explicit RangeEncoder(std::string* out) : out(out) {}
+
+        // A value from [0, total), all equally likely; a forced choice costs nothing
+        void encode(uint32_t value, uint32_t total) {
+            if (total <= 1) {
+                return;
+            }
+            range /= total;
+            low += value * range;
+            while ((low ^ (low + range)) < TOP || (range < BOTTOM && ((range = -low & (BOTTOM - 1)), true))) {
+                *out += static_cast<char>(low >> 24);
+                low <<= 8;
+                range <<= 8;
+            }
+        }
+
+        void finish() {
+            for (int i = 0; i < 4; ++i) {
+                *out += static_cast<char>(low >> 24);
+                low <<= 8;
+            }
+        }
+
+    private:
+        std::string* out;
+        uint32_t low = 0;
+        uint32_t range = 0xFFFFFFFFu;
+    };
+
+    class RangeDecoder {
+    public:
+        RangeDecoder(const unsigned char* data, size_t size) : data(data), size(size) {
+            for (int i = 0; i < 4; ++i) {
+                code = (code << 8) | nextByte();
+            }
+        }
+
+        uint32_t decode(uint32_t total) {
+            if (total <= 1) {
+                return 0;
+            }
+            range /= total;
+            // Only damage can push the value past the end; the CRC has caught that already
+            const uint32_t value = std::min((code - low) / range, total - 1);
+            low += value * range;
+            while ((low ^ (low + range)) < TOP || (range < BOTTOM && ((range = -low & (BOTTOM - 1)), true))) {
+                code = (code << 8) | nextByte();
+                low <<= 8;
+                range <<= 8;
+            }
+            return value;
+        }
+
+    private:
+        uint32_t nextByte() { return pos < size ? data[pos++] : 0; }
+
+        const unsigned char* data;
+        size_t size;
+        size_t pos = 0;
+        uint32_t low = 0;
+        uint32_t range = 0xFFFFFFFFu;
+        uint32_t code = 0;
+    };
+
+    // Two bits per square: empty, arrow, white, black, as in GameRecord
+    uint32_t cellOf(const FastBoard& board, int square) {
+        const uint64_t bit = FastBoard::squareBit(square);
+        if (board.arrows() & bit) return 1;
+        if (board.amazons(Player::WHITE) & bit) return 2;
+        if (board.amazons(Player::BLACK) & bit) return 3;
+        return 0;
+    }
+
+    void encodeGame(RangeEncoder& encoder, const GameState& game, GameMode gameMode, PackedMove* moves) {
+        const std::vector<Move>& history = game.getMoveHistory();
+        GameState start = game;
+        while (start.canUndo()) {
+            start.undoLastMove();
+        }
+        if (history.size() > 0xFFFF || start.getTurnNumber() > 0xFFFF || start.getTurnNumber() < 0) {
+            throw std::invalid_argument("Game too long for a game archive");
+        }
+        const bool standardStart = start == GameState();
+
+        encoder.encode(static_cast<uint32_t>(gameMode), GAME_MODES);
+        encoder.encode(standardStart ? 0 : 1, 2);
+        FastBoard position = FastBoard::fromGameState(start);
+        if (!standardStart) {
+            for (int square = 0; square < FastBoard::SQUARES; ++square) {
+                encoder.encode(cellOf(position, square), 4);
+            }
+            encoder.encode(position.sideToMove() == Player::BLACK ? 1 : 0, 2);
+            encoder.encode(static_cast<uint32_t>(start.getTurnNumber()) & 0xFF, 256);
+            encoder.encode(static_cast<uint32_t>(start.getTurnNumber()) >> 8, 256);
+        }
+        encoder.encode(static_cast<uint32_t>(history.size()) & 0xFF, 256);
+        encoder.encode(static_cast<uint32_t>(history.size()) >> 8, 256);
+
+        for (const Move& move : history) {
+            // The move's rank by code among the legal moves; no sort needed
+            const PackedMove packed = PackedMove::fromMove(move);
+            const int count = position.generateMoves(moves);
+            uint32_t rank = 0;
+            bool found = false;
+            for (int i = 0; i < count; ++i) {
+                rank += moves[i].code() < packed.code();
+                found = found || moves[i] == packed;
+            }
+            if (!found) {
+                throw std::invalid_argument("Illegal move in game for the archive");
+            }
+            encoder.encode(rank, static_cast<uint32_t>(count));
+            position.makeMove(packed);
+        }
+    }
+
+    GameArchive::Game decodeGame(RangeDecoder& decoder, PackedMove* moves) {
+        const GameMode gameMode = static_cast<GameMode>(decoder.decode(GAME_MODES));
+        FastBoard position = FastBoard::standardPosition();
+        int turnNumber = 1;
+        if (decoder.decode(2)) {
+            uint64_t planes[4] = {0, 0, 0, 0};
+            for (int square = 0; square < FastBoard::SQUARES; ++square) {
+                planes[decoder.decode(4)] |= FastBoard::squareBit(square);
+            }
+            const Player side = decoder.decode(2) ? Player::BLACK : Player::WHITE;
+            turnNumber = static_cast<int>(decoder.decode(256));
+            turnNumber |= static_cast<int>(decoder.decode(256)) << 8;
+            position = FastBoard::fromBitboards(planes[1], planes[2], planes[3], side);
+        }
+        size_t plies = decoder.decode(256);
+        plies |= static_cast<size_t>(decoder.decode(256)) << 8;
+
+        std::vector<Move> history;
+        history.reserve(plies);
+        for (size_t ply = 0; ply < plies; ++ply) {
+            const int count = position.generateMoves(moves);
+            if (count == 0) {
+                throw std::runtime_error("Damaged game archive block");
+            }
+            const uint32_t rank = decoder.decode(static_cast<uint32_t>(count));
+            std::nth_element(moves, moves + rank, moves + count);
+            if (position.sideToMove() == Player::BLACK) {
+                turnNumber++;   // as GameState::makeMove counts turns
+            }
+            position.makeMove(moves[rank]);
+            history.push_back(moves[rank].toMove());
+        }
+        auto game = std::make_unique<GameState>(position.toBoard(), position.sideToMove(), turnNumber,
+                                                std::move(history));
+        return {std::move(game), gameMode};
+    }
+}
+
+struct GameArchive::Writer::Coder {
+    std::string bytes;
+    RangeEncoder encoder{&bytes};
+    uint32_t games = 0;
+    std::vector<PackedMove> moves = std::vector<PackedMove>(FastBoard::MAX_MOVES);
+};
+
+GameArchive::Writer::Writer(const std::string& path, uint32_t gamesPerBlock)
+    : path(path), file(std::fopen(path.c_str(), "wb")), gamesPerBlock(std::max(1u, gamesPerBlock)),
+      coder(std::make_unique<Coder>()) {
+    unsigned char header[HEADER_SIZE] = {};
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    put32(header + 8, this->gamesPerBlock);
+    if (!file || std::fwrite(header, 1, sizeof(header), file) != sizeof(header)) {
+        if (file) {
+            std::fclose(file);
+        }
+        throw std::runtime_error("Could not create game archive " + path);
+    }
+    offset = sizeof(header);
+}
+
+GameArchive::Writer::~Writer() {
+    try {
+        close();
+    } catch (const std::exception&) {
+        // Readers recover every block that made it to disk
+    }
+}
+
+uint64_t GameArchive::Writer::add(const GameState& game, GameMode gameMode) {
+    if (!file) {
+        throw std::logic_error("Game archive " + path + " is closed");
+    }
+    // A game that cannot be coded leaves the block as it was
+    const size_t mark = coder->bytes.size();
+    const RangeEncoder saved = coder->encoder;
+    try {
+        encodeGame(coder->encoder, game, gameMode, coder->moves.data());
+    } catch (...) {
+        coder->bytes.resize(mark);
+        coder->encoder = saved;
+        throw;
+    }
+    const uint64_t id = games++;
+    if (++coder->games == gamesPerBlock) {
+        writeBlock();
+    }
+    return id;
+}
+
+uint64_t GameArchive::Writer::addRecord(const void* data, size_t size) {
+    auto decoded = GameRecord::decode(data, size);
+    return add(*decoded.first, decoded.second);
+}
+
+void GameArchive::Writer::writeBlock() {
+    coder->encoder.finish();
+    unsigned char header[BLOCK_HEADER_SIZE];
+    put32(header, static_cast<uint32_t>(coder->bytes.size()));
+    put32(header + 4, coder->games);
+    put32(header + 8, GameRecord::crc32(coder->bytes.data(), coder->bytes.size()));
+    if (std::fwrite(header, 1, sizeof(header), file) != sizeof(header) ||
+        std::fwrite(coder->bytes.data(), 1, coder->bytes.size(), file) != coder->bytes.size()) {
+        throw std::runtime_error("Failed writing game archive " + path);
+    }
+    blockOffsets.push_back(offset);
+    offset += sizeof(header) + coder->bytes.size();
+    coder->bytes.clear();
+    coder->encoder = RangeEncoder(&coder->bytes);
+    coder->games = 0;
+}
+
+void GameArchive::Writer::close() {
+    if (!file) {
+        return;
+    }
+    bool written = true;
+    try {
+        if (coder->games > 0) {
+            writeBlock();
+        }
+    } catch (const std::runtime_error&) {
+        written = false;
+    }
+    if (written) {
+        std::string index(blockOffsets.size() * 8, '\0');
+        for (size_t i = 0; i < blockOffsets.size(); ++i) {
+            put64(reinterpret_cast<unsigned char*>(&index[i * 8]), blockOffsets[i]);
+        }
+        unsigned char footer[FOOTER_SIZE];
+        put64(footer, offset);
+        put64(footer + 8, games);
+        put32(footer + 16, GameRecord::crc32(index.data(), index.size()));
+        std::memcpy(footer + 20, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+        written = std::fwrite(index.data(), 1, index.size(), file) == index.size() &&
+                  std::fwrite(footer, 1, sizeof(footer), file) == sizeof(footer);
+        offset += index.size() + sizeof(footer);
+    }
+    std::FILE* closing = file;
+    file = nullptr;
+    if (std::fclose(closing) != 0 || !written) {
+        throw std::runtime_error("Failed writing game archive " + path);
+    }
+}
+
+struct GameArchive::Impl {
+    std::string path;
+    MappedFile map;
+    uint32_t gamesPerBlock = 0;
+    uint64_t games = 0;
+    std::vector<uint64_t> blockOffsets;
+
+    // The last block game() decoded; several threads may read games at once
+    mutable std::mutex cacheMutex;
+    mutable size_t cachedBlock = SIZE_MAX;
+    mutable std::vector<Game> cachedGames;
+
+    // Adopts the index written by close(), if it is there and intact
+    bool readIndex() {
+        const size_t size = map.size();
+        if (size < HEADER_SIZE + FOOTER_SIZE) {
+            return false;
+        }
+        const unsigned char* footer = map.data() + size - FOOTER_SIZE;
+        const uint64_t indexOffset = get64(footer);
+        const uint64_t count = get64(footer + 8);
+        if (std::memcmp(footer + 20, INDEX_MAGIC, sizeof(INDEX_MAGIC)) != 0 || indexOffset < HEADER_SIZE ||
+            indexOffset > size - FOOTER_SIZE || (size - FOOTER_SIZE - indexOffset) % 8 != 0) {
+            return false;
+        }
+        const size_t blocks = static_cast<size_t>((size - FOOTER_SIZE - indexOffset) / 8);
+        const unsigned char* index = map.data() + indexOffset;
+        if (get32(footer + 16) != GameRecord::crc32(index, blocks * 8) ||
+            blocks != (count + gamesPerBlock - 1) / gamesPerBlock) {
+            return false;
+        }
+        std::vector<uint64_t> offsets(blocks);
+        for (size_t i = 0; i < blocks; ++i) {
+            offsets[i] = get64(index + i * 8);
+            if (offsets[i] < HEADER_SIZE || offsets[i] + BLOCK_HEADER_SIZE > indexOffset) {
+                return false;
+            }
+        }
+        blockOffsets = std::move(offsets);
+        games = count;
+        return true;
+    }
+
+    // Walks the blocks of an archive that was never closed
+    void scanBlocks() {
+        const size_t size = map.size();
+        const unsigned char* bytes = map.data();
+        uint64_t offset = HEADER_SIZE;
+        while (offset + BLOCK_HEADER_SIZE <= size) {
+            const uint32_t payload = get32(bytes + offset);
+            const uint32_t count = get32(bytes + offset + 4);
+            // Only the last block may be short, or game numbers stop mapping to blocks
+            const bool previousFull = blockOffsets.empty() || games % gamesPerBlock == 0;
+            if (offset + BLOCK_HEADER_SIZE + payload > size || count == 0 || count > gamesPerBlock ||
+                !previousFull ||
+                get32(bytes + offset + 8) != GameRecord::crc32(bytes + offset + BLOCK_HEADER_SIZE, payload)) {
+                break;
+            }
+            blockOffsets.push_back(offset);
+            games += count;
+            offset += BLOCK_HEADER_SIZE + payload;
+        }
+    }
+
+    // Safe from any thread: reads nothing but the mapping
+    std::vector<Game> decodeBlock(size_t index) const {
+        const unsigned char* header = map.data() + blockOffsets[index];
+        const uint32_t payload = get32(header);
+        const uint32_t count = get32(header + 4);
+        const uint64_t expected = std::min<uint64_t>(gamesPerBlock, games - uint64_t(index) * gamesPerBlock);
+        if (blockOffsets[index] + BLOCK_HEADER_SIZE + payload > map.size() || count != expected ||
+            get32(header + 8) != GameRecord::crc32(header + BLOCK_HEADER_SIZE, payload)) {
+            throw std::runtime_error("Damaged block " + std::to_string(index) + " in game archive " + path);
+        }
+        RangeDecoder decoder(header + BLOCK_HEADER_SIZE, payload);
+        std::vector<PackedMove> moves(FastBoard::MAX_MOVES);
+        std::vector<Game> decoded;
+        decoded.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            decoded.push_back(decodeGame(decoder, moves.data()));
+        }
+        return decoded;
+    }
+};
+
+GameArchive::GameArchive(const std::string& path) : impl(std::make_unique<Impl>()) {
+    impl->path = path;
+    std::error_code error;
+    const uint64_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        throw std::runtime_error("Could not open game archive " + path);
+    }
+    if (size < HEADER_SIZE) {
+        throw std::runtime_error("Not a game archive: " + path);
+    }
+    impl->map.map(path, static_cast<size_t>(size));
+    if (!isArchive(impl->map.data(), impl->map.size()) || get32(impl->map.data() + 8) == 0) {
+        throw std::runtime_error("Not a game archive: " + path);
+    }
+    impl->gamesPerBlock = get32(impl->map.data() + 8);
+    if (!impl->readIndex()) {
+        impl->scanBlocks();
+    }
+}
+
+GameArchive::~GameArchive() = default;
+
+uint64_t GameArchive::gameCount() const {
+    return impl->games;
+}
+
+size_t GameArchive::blockCount() const {
+    return impl->blockOffsets.size();
+}
+
+uint32_t GameArchive::gamesPerBlock() const {
+    return impl->gamesPerBlock;
+}
+
+GameArchive::Game GameArchive::game(uint64_t id) const {
+    if (id >= impl->games) {
+        throw std::out_of_range("No game " + std::to_string(id) + " in " + impl->path);
+    }
+    const size_t index = static_cast<size_t>(id / impl->gamesPerBlock);
+    const size_t slot = static_cast<size_t>(id % impl->gamesPerBlock);
+    {
+        std::lock_guard<std::mutex> lock(impl->cacheMutex);
+        if (impl->cachedBlock == index) {
+            const Game& cached = impl->cachedGames[slot];
+            return {std::make_unique<GameState>(*cached.first), cached.second};
+        }
+    }
+    // Decoded without the lock, so readers of other blocks do not queue up behind it
+    std::vector<Game> decoded = impl->decodeBlock(index);
+    Game result{std::make_unique<GameState>(*decoded[slot].first), decoded[slot].second};
+    std::lock_guard<std::mutex> lock(impl->cacheMutex);
+    impl->cachedGames = std::move(decoded);
+    impl->cachedBlock = index;
+    return result;
+}
+
+std::string GameArchive::record(uint64_t id) const {
+    Game decoded = game(id);
+    return GameRecord::encode(*decoded.first, decoded.second);
+}
+
+std::vector<GameArchive::Game> GameArchive::block(size_t index) const {
+    if (index >= impl->blockOffsets.size()) {
+        throw std::out_of_range("No block " + std::to_string(index) + " in " + impl->path);
+    }
+    return impl->decodeBlock(index);
+}
+
+void GameArchive::forEach(unsigned threads,
+                          const std::function<void(uint64_t, const GameState&, GameMode)>& visit) const {
+    std::atomic<size_t> nextBlock{0};
+    std::atomic<bool> stop{false};
+    std::mutex failureMutex;
+    std::exception_ptr failure;
+
+    auto worker = [&]() {
+        try {
+            for (size_t index = nextBlock++; index < impl->blockOffsets.size() && !stop; index = nextBlock++) {
+                std::vector<Game> decoded = impl->decodeBlock(index);
+                const uint64_t first = static_cast<uint64_t>(index) * impl->gamesPerBlock;
+                for (size_t i = 0; i < decoded.size(); ++i) {
+                    visit(first + i, *decoded[i].first, decoded[i].second);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(failureMutex);
+            if (!failure) {
+                failure = std::current_exception();
+            }
+            stop = true;
+        }
+    };
+
+    const size_t workers = std::max<size_t>(1, std::min<size_t>(threads, impl->blockOffsets.size()));
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < workers; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    if (failure) {
+        std::rethrow_exception(failure);
+    }
+}
+
+bool GameArchive::isArchive(const void* data, size_t size) {
+    return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+} // namespace amazons
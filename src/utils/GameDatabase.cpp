@@ -0,0 +1,293 @@
+#include "utils/GameDatabase.hpp"
+#include "core/Symmetry.hpp"
+#include "utils/GameRecord.hpp"
+#include "utils/MappedFile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+namespace amazons {
+
+namespace {
+    const char DATA_MAGIC[8] = {'A', 'M', 'Z', 'G', 'D', 'B', '0', '1'};
+    const char INDEX_MAGIC[8] = {'A', 'M', 'Z', 'I', 'D', 'X', '0', '2'};
+    const size_t INDEX_HEADER_SIZE = 24;
+
+    // Stored as-is in the index file, which is therefore in host byte order
+    // (little endian on everything we build for) and read in place from the mapping
+    struct IndexEntry {
+        uint64_t key;
+        uint32_t game;
+        uint16_t ply;
+        uint16_t reserved;
+
+        bool operator<(const IndexEntry& other) const {
+            if (key != other.key) return key < other.key;
+            if (game != other.game) return game < other.game;
+            return ply < other.ply;
+        }
+    };
+    static_assert(sizeof(IndexEntry) == 16, "index entries are 16 bytes on disk");
+
+    bool keyLess(const IndexEntry& entry, uint64_t key) { return entry.key < key; }
+    bool keyGreater(uint64_t key, const IndexEntry& entry) { return key < entry.key; }
+
+    uint64_t get64(const unsigned char* in) {
+        uint64_t value = 0;
+        for (int i = 7; i >= 0; --i) {
+            value = (value << 8) | in[i];
+        }
+        return value;
+    }
+
+    void put64(unsigned char* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+}
+
+struct GameDatabase::Impl {
+    std::string path;
+    std::string indexPath;
+    std::FILE* appendFile = nullptr;
+
+    mutable MappedFile dataMap;
+    uint64_t dataSize = 0;
+    std::vector<uint64_t> offsets;      // of each game's length prefix
+
+    MappedFile indexMap;
+    const IndexEntry* persisted = nullptr;
+    size_t persistedCount = 0;
+    mutable std::vector<IndexEntry> recent;     // games not yet in the index file
+    mutable bool recentSorted = true;
+    bool dirty = false;
+
+    ~Impl() {
+        if (appendFile) {
+            std::fclose(appendFile);
+        }
+    }
+
+    const unsigned char* recordAt(uint32_t id, uint16_t& length) const {
+        if (dataMap.size() < dataSize) {
+            // Appends since the last read: widen the view to cover them
+            dataMap.map(path, dataSize);
+        }
+        const unsigned char* prefix = dataMap.data() + offsets[id];
+        length = static_cast<uint16_t>(prefix[0] | (prefix[1] << 8));
+        return prefix + 2;
+    }
+
+    void indexGame(uint32_t id, const GameState& game) {
+        GameState start = game;
+        while (start.canUndo()) {
+            start.undoLastMove();
+        }
+        FastBoard position = FastBoard::fromGameState(start);
+        recent.push_back({positionKey(position), id, 0, 0});
+        uint16_t ply = 0;
+        for (const Move& move : game.getMoveHistory()) {
+            position.makeMove(PackedMove::fromMove(move));
+            recent.push_back({positionKey(position), id, ++ply, 0});
+        }
+        recentSorted = false;
+    }
+
+    // Adopts the index file if it describes a prefix of the data; returns the games it covers
+    size_t loadIndex() {
+        std::error_code error;
+        uint64_t size = std::filesystem::file_size(indexPath, error);
+        if (error || size < INDEX_HEADER_SIZE) {
+            return 0;
+        }
+        indexMap.map(indexPath, size);
+        const unsigned char* header = indexMap.data();
+        uint64_t covered = get64(header + 8);
+        uint64_t count = get64(header + 16);
+        auto boundary = std::lower_bound(offsets.begin(), offsets.end(), covered);
+        bool valid = std::memcmp(header, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+                     size == INDEX_HEADER_SIZE + count * sizeof(IndexEntry) &&
+                     (covered == dataSize || (boundary != offsets.end() && *boundary == covered));
+        if (!valid) {
+            indexMap.reset();
+            return 0;
+        }
+        persisted = reinterpret_cast<const IndexEntry*>(header + INDEX_HEADER_SIZE);
+        persistedCount = count;
+        return static_cast<size_t>(boundary - offsets.begin());
+    }
+
+    void sortRecent() const {
+        if (!recentSorted) {
+            std::sort(recent.begin(), recent.end());
+            recentSorted = true;
+        }
+    }
+};
+
+GameDatabase::GameDatabase(const std::string& path) : impl(std::make_unique<Impl>()) {
+    impl->path = path;
+    impl->indexPath = path + ".idx";
+
+    std::error_code error;
+    uint64_t size = std::filesystem::file_size(path, error);
+    if (error || size == 0) {
+        std::FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file || std::fwrite(DATA_MAGIC, 1, sizeof(DATA_MAGIC), file) != sizeof(DATA_MAGIC)) {
+            if (file) {
+                std::fclose(file);
+            }
+            throw std::runtime_error("Could not create game database " + path);
+        }
+        std::fclose(file);
+        size = sizeof(DATA_MAGIC);
+    }
+
+    impl->dataMap.map(path, size);
+    const unsigned char* bytes = impl->dataMap.data();
+    if (size < sizeof(DATA_MAGIC) || std::memcmp(bytes, DATA_MAGIC, sizeof(DATA_MAGIC)) != 0) {
+        throw std::runtime_error("Not a game database: " + path);
+    }
+
+    // Walk the length prefixes; a record running past the end was cut short mid-append
+    uint64_t offset = sizeof(DATA_MAGIC);
+    while (offset + 2 <= size) {
+        uint64_t length = bytes[offset] | (bytes[offset + 1] << 8);
+        if (offset + 2 + length > size) {
+            break;
+        }
+        impl->offsets.push_back(offset);
+        offset += 2 + length;
+    }
+    impl->dataSize = offset;
+    if (offset < size) {
+        impl->dataMap.reset();
+        std::filesystem::resize_file(path, offset);
+        impl->dataMap.map(path, offset);
+        impl->dirty = true;
+    }
+
+    size_t indexed = impl->loadIndex();
+    for (size_t id = indexed; id < impl->offsets.size(); ++id) {
+        impl->indexGame(static_cast<uint32_t>(id), *game(static_cast<uint32_t>(id)).first);
+        impl->dirty = true;
+    }
+
+    impl->appendFile = std::fopen(path.c_str(), "ab");
+    if (!impl->appendFile) {
+        throw std::runtime_error("Could not open game database for appending: " + path);
+    }
+}
+
+GameDatabase::~GameDatabase() {
+    try {
+        flush();
+    } catch (const std::exception&) {
+        // The index is rebuilt from the data file on the next open
+    }
+}
+
+uint32_t GameDatabase::append(const GameState& game, GameMode gameMode) {
+    std::string record = GameRecord::encode(game, gameMode);
+    unsigned char prefix[2] = {static_cast<unsigned char>(record.size() & 0xFF),
+                               static_cast<unsigned char>(record.size() >> 8)};
+    if (std::fwrite(prefix, 1, 2, impl->appendFile) != 2 ||
+        std::fwrite(record.data(), 1, record.size(), impl->appendFile) != record.size() ||
+        std::fflush(impl->appendFile) != 0) {
+        throw std::runtime_error("Failed appending to game database " + impl->path);
+    }
+
+    uint32_t id = static_cast<uint32_t>(impl->offsets.size());
+    impl->offsets.push_back(impl->dataSize);
+    impl->dataSize += 2 + record.size();
+    impl->indexGame(id, game);
+    impl->dirty = true;
+    return id;
+}
+
+size_t GameDatabase::gameCount() const {
+    return impl->offsets.size();
+}
+
+std::pair<std::unique_ptr<GameState>, GameMode> GameDatabase::game(uint32_t id) const {
+    if (id >= impl->offsets.size()) {
+        throw std::out_of_range("No game " + std::to_string(id) + " in " + impl->path);
+    }
+    uint16_t length = 0;
+    const unsigned char* record = impl->recordAt(id, length);
+    return GameRecord::decode(record, length);
+}
+
+std::vector<GameDatabase::Occurrence> GameDatabase::find(const FastBoard& position) const {
+    const uint64_t key = positionKey(position);
+    std::vector<Occurrence> found;
+
+    // Persisted games all precede recent ones, so the two ranges concatenate in order
+    auto first = std::lower_bound(impl->persisted, impl->persisted + impl->persistedCount, key, keyLess);
+    auto last = std::upper_bound(first, impl->persisted + impl->persistedCount, key, keyGreater);
+    for (auto entry = first; entry != last; ++entry) {
+        found.push_back({entry->game, entry->ply});
+    }
+
+    impl->sortRecent();
+    auto range = std::equal_range(impl->recent.begin(), impl->recent.end(), IndexEntry{key, 0, 0, 0},
+                                  [](const IndexEntry& a, const IndexEntry& b) { return a.key < b.key; });
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        found.push_back({entry->game, entry->ply});
+    }
+    return found;
+}
+
+std::vector<GameDatabase::Occurrence> GameDatabase::find(const GameState& position) const {
+    return find(FastBoard::fromGameState(position));
+}
+
+void GameDatabase::flush() {
+    if (!impl->dirty) {
+        return;
+    }
+    impl->sortRecent();
+    std::vector<IndexEntry> merged(impl->persistedCount + impl->recent.size());
+    std::merge(impl->persisted, impl->persisted + impl->persistedCount, impl->recent.begin(), impl->recent.end(),
+               merged.begin());
+
+    unsigned char header[INDEX_HEADER_SIZE];
+    std::memcpy(header, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    put64(header + 8, impl->dataSize);
+    put64(header + 16, merged.size());
+
+    // Written aside and renamed over, so a reader never sees half an index
+    const std::string temporary = impl->indexPath + ".tmp";
+    std::FILE* file = std::fopen(temporary.c_str(), "wb");
+    bool written = file && std::fwrite(header, 1, sizeof(header), file) == sizeof(header) &&
+                   std::fwrite(merged.data(), sizeof(IndexEntry), merged.size(), file) == merged.size();
+    if (file && std::fclose(file) != 0) {
+        written = false;
+    }
+    if (!written) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed writing game index " + impl->indexPath);
+    }
+    impl->persisted = nullptr;
+    impl->persistedCount = 0;
+    impl->indexMap.reset();
+    std::filesystem::rename(temporary, impl->indexPath);
+
+    impl->indexMap.map(impl->indexPath, sizeof(header) + merged.size() * sizeof(IndexEntry));
+    impl->persisted = reinterpret_cast<const IndexEntry*>(impl->indexMap.data() + INDEX_HEADER_SIZE);
+    impl->persistedCount = merged.size();
+    impl->recent.clear();
+    impl->recentSorted = true;
+    impl->dirty = false;
+}
+
+uint64_t GameDatabase::positionKey(const FastBoard& position) {
+    return Symmetry::canonical(position).key;
+}
+
+} // namespace amazons
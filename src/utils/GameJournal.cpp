@@ -0,0 +1,258 @@
+#include "utils/GameJournal.hpp"
+#include "core/FastBoard.hpp"
+#include "utils/GameRecord.hpp"
+#include "utils/Serializer.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _WIN32
+#include <io.h>     // For _commit
+#endif
+
+namespace amazons {
+
+namespace {
+#ifdef O_BINARY
+    const int FILE_FLAGS = O_BINARY;
+#else
+    const int FILE_FLAGS = O_CLOEXEC;
+#endif
+
+    enum RecordKind : uint8_t {
+        RECORD_MOVE = 1,
+        RECORD_UNDO = 2
+    };
+
+    void put32(unsigned char* out, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    uint32_t get32(const unsigned char* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | (static_cast<uint32_t>(in[3]) << 24);
+    }
+
+    // Ties the checksum to the record's place, so a stale record cannot pass for a later one
+    uint32_t recordCheck(uint32_t word, size_t sequence) {
+        unsigned char bytes[8];
+        put32(bytes, word);
+        put32(bytes + 4, static_cast<uint32_t>(sequence));
+        return GameRecord::crc32(bytes, sizeof(bytes));
+    }
+
+    bool syncFile(int fd) {
+#ifdef _WIN32
+        return _commit(fd) == 0;
+#else
+        return fsync(fd) == 0;
+#endif
+    }
+
+    bool readWholeFile(const std::string& path, std::string& content) {
+        int fd = ::open(path.c_str(), O_RDONLY | FILE_FLAGS);
+        if (fd < 0) {
+            return false;
+        }
+        char buffer[1 << 16];
+        while (true) {
+            auto count = ::read(fd, buffer, sizeof(buffer));
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count < 0) {
+                ::close(fd);
+                throw std::runtime_error("Could not read " + path);
+            }
+            if (count == 0) {
+                break;
+            }
+            content.append(buffer, static_cast<size_t>(count));
+        }
+        ::close(fd);
+        return true;
+    }
+}
+
+GameJournal::GameJournal(const std::string& path, const GameState& game, GameMode gameMode)
+    : GameJournal(path, game, gameMode, Options()) {}
+
+GameJournal::GameJournal(const std::string& path, const GameState& game, GameMode gameMode, const Options& options)
+    : path(path), gameMode(gameMode), options(options) {
+    if (options.syncEvery == 0 || options.compactEvery == 0) {
+        throw std::invalid_argument("GameJournal: syncEvery and compactEvery must be positive");
+    }
+    std::error_code ignored;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) {
+        std::filesystem::create_directories(parent, ignored);
+    }
+    compact(game);
+    if (fd < 0) {
+        throw std::runtime_error("Could not start journal " + path);
+    }
+}
+
+GameJournal::~GameJournal() {
+    if (fd >= 0) {
+        sync();
+        ::close(fd);
+    }
+}
+
+void GameJournal::movePlayed(const GameState& state, const Move& move) {
+    append(RECORD_MOVE, PackedMove::fromMove(move).code(), state);
+}
+
+void GameJournal::moveUndone(const GameState& state) {
+    append(RECORD_UNDO, 0, state);
+}
+
+void GameJournal::append(uint8_t kind, uint32_t code, const GameState& state) {
+    if (fd < 0) {
+        return;
+    }
+    if (records >= options.compactEvery) {
+        // The state already includes this record's move, so the snapshot covers it
+        compact(state);
+        return;
+    }
+
+    const uint32_t word = static_cast<uint32_t>(kind) << 24 | code;
+    unsigned char bytes[RECORD_SIZE];
+    put32(bytes, word);
+    put32(bytes + 4, recordCheck(word, records));
+    ssize_t written;
+    do {
+        written = ::write(fd, bytes, sizeof(bytes));
+    } while (written < 0 && errno == EINTR);
+    if (written != static_cast<ssize_t>(sizeof(bytes))) {
+        fail("write failed");
+        return;
+    }
+    records++;
+
+    const auto now = std::chrono::steady_clock::now();
+    if (unsynced++ == 0) {
+        oldestUnsynced = now;
+    }
+    if (unsynced >= options.syncEvery || now - oldestUnsynced >= options.syncInterval) {
+        sync();
+    }
+}
+
+void GameJournal::sync() {
+    if (fd < 0 || unsynced == 0) {
+        return;
+    }
+    unsynced = 0;
+    if (!syncFile(fd)) {
+        fail("fsync failed");
+    }
+}
+
+void GameJournal::compact(const GameState& game) {
+    const std::string snapshot = GameRecord::encode(game, gameMode);
+    std::string content(HEADER_SIZE, '\0');
+    std::memcpy(&content[0], MAGIC, sizeof(MAGIC));
+    content[4] = static_cast<char>(VERSION);
+    content[6] = static_cast<char>(snapshot.size() & 0xFF);
+    content[7] = static_cast<char>(snapshot.size() >> 8);
+    content += snapshot;
+
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    try {
+        // Old journal or new one, never a mix: the records folded in vanish with the rename
+        Serializer::writeFileAtomically(path, content);
+    } catch (const std::exception& e) {
+        fail(e.what());
+        return;
+    }
+    fd = ::open(path.c_str(), O_WRONLY | O_APPEND | FILE_FLAGS);
+    if (fd < 0) {
+        fail("could not reopen");
+        return;
+    }
+    records = 0;
+    unsynced = 0;
+}
+
+void GameJournal::discard() {
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+    remove(path);
+}
+
+void GameJournal::fail(const std::string& what) {
+    std::cerr << "Journal " << path << " stopped: " << what << std::endl;
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+bool GameJournal::exists(const std::string& path) {
+    struct stat info;
+    return stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode);
+}
+
+void GameJournal::remove(const std::string& path) {
+    std::remove(path.c_str());
+}
+
+std::pair<std::unique_ptr<GameState>, GameMode> GameJournal::recover(const std::string& path) {
+    std::string content;
+    if (!readWholeFile(path, content)) {
+        return {nullptr, GameMode::HUMAN_VS_HUMAN};
+    }
+    const auto* bytes = reinterpret_cast<const unsigned char*>(content.data());
+    if (content.size() < HEADER_SIZE || std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::invalid_argument("Not a game journal: " + path);
+    }
+    if (bytes[4] != VERSION) {
+        throw std::invalid_argument("Unsupported journal version " + std::to_string(bytes[4]));
+    }
+    const size_t snapshotSize = bytes[6] | (bytes[7] << 8);
+    if (content.size() < HEADER_SIZE + snapshotSize) {
+        throw std::invalid_argument("Journal snapshot is truncated: " + path);
+    }
+    auto result = GameRecord::decode(bytes + HEADER_SIZE, snapshotSize);
+
+    // Replay up to the first record that is incomplete or fails its check
+    GameState& state = *result.first;
+    size_t sequence = 0;
+    for (size_t offset = HEADER_SIZE + snapshotSize; offset + RECORD_SIZE <= content.size();
+         offset += RECORD_SIZE, ++sequence) {
+        const uint32_t word = get32(bytes + offset);
+        if (get32(bytes + offset + 4) != recordCheck(word, sequence)) {
+            break;
+        }
+        switch (word >> 24) {
+            case RECORD_MOVE:
+                state.makeMove(PackedMove::fromCode(word & 0xFFFFFF).toMove());
+                break;
+            case RECORD_UNDO:
+                if (!state.canUndo()) {
+                    throw std::invalid_argument("Journal undoes past the start of the game");
+                }
+                state.undoLastMove();
+                break;
+            default:
+                throw std::invalid_argument("Unknown journal record kind " + std::to_string(word >> 24));
+        }
+    }
+    return result;
+}
+
+} // namespace amazons
@@ -0,0 +1,198 @@
+#include "utils/GameRecord.hpp"
+#include "core/FastBoard.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+namespace amazons {
+
+namespace {
+    const size_t CHECKSUM_SIZE = 4;
+    const size_t START_SIZE = FastBoard::SQUARES / 4 + 3;   // board, side to move, turn number
+    const int MOVE_BITS = 18;
+
+    void put16(std::string& out, uint32_t value) {
+        out += static_cast<char>(value & 0xFF);
+        out += static_cast<char>((value >> 8) & 0xFF);
+    }
+
+    void put32(std::string& out, uint32_t value) {
+        put16(out, value & 0xFFFF);
+        put16(out, value >> 16);
+    }
+
+    uint32_t get16(const unsigned char* in) {
+        return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8);
+    }
+
+    uint32_t get32(const unsigned char* in) {
+        return get16(in) | (get16(in + 2) << 16);
+    }
+
+    // Two bits per square, in Board::Cell order
+    uint8_t cellCode(Board::Cell cell) {
+        switch (cell) {
+            case Board::Cell::EMPTY: return 0;
+            case Board::Cell::ARROW: return 1;
+            case Board::Cell::WHITE_AMAZON: return 2;
+            case Board::Cell::BLACK_AMAZON: return 3;
+        }
+        return 0;
+    }
+
+    const Board::Cell CELLS[4] = {Board::Cell::EMPTY, Board::Cell::ARROW, Board::Cell::WHITE_AMAZON,
+                                  Board::Cell::BLACK_AMAZON};
+}
+
+uint32_t GameRecord::crc32(const void* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc = table[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+bool GameRecord::isRecord(const void* data, size_t size) {
+    return size >= sizeof(MAGIC) && std::memcmp(data, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::string GameRecord::encode(const GameState& gameState, GameMode gameMode) {
+    const std::vector<Move>& moves = gameState.getMoveHistory();
+    if (moves.size() > 0xFFFF) {
+        throw std::invalid_argument("Game too long for a game record");
+    }
+
+    // Walk back to where the recorded moves began
+    GameState start = gameState;
+    while (start.canUndo()) {
+        start.undoLastMove();
+    }
+    const bool standardStart = start == GameState();
+
+    std::string out(MAGIC, sizeof(MAGIC));
+    out.reserve(HEADER_SIZE + START_SIZE + (moves.size() * MOVE_BITS + 7) / 8 + CHECKSUM_SIZE);
+    out += static_cast<char>(VERSION);
+    out += static_cast<char>(standardStart ? 0 : FLAG_CUSTOM_START);
+    out += static_cast<char>(gameMode);
+    put16(out, static_cast<uint32_t>(moves.size()));
+
+    if (!standardStart) {
+        unsigned char cells[FastBoard::SQUARES / 4] = {};
+        for (int square = 0; square < FastBoard::SQUARES; ++square) {
+            Board::Cell cell = start.getBoard().getCell(square / Board::SIZE, square % Board::SIZE);
+            cells[square / 4] |= static_cast<unsigned char>(cellCode(cell) << ((square % 4) * 2));
+        }
+        out.append(reinterpret_cast<const char*>(cells), sizeof(cells));
+        out += static_cast<char>(start.getCurrentPlayer() == Player::BLACK ? 1 : 0);
+        put16(out, static_cast<uint32_t>(start.getTurnNumber()));
+    }
+
+    uint64_t pending = 0;
+    int pendingBits = 0;
+    for (const Move& move : moves) {
+        pending |= static_cast<uint64_t>(PackedMove::fromMove(move).code()) << pendingBits;
+        pendingBits += MOVE_BITS;
+        while (pendingBits >= 8) {
+            out += static_cast<char>(pending & 0xFF);
+            pending >>= 8;
+            pendingBits -= 8;
+        }
+    }
+    if (pendingBits > 0) {
+        out += static_cast<char>(pending & 0xFF);
+    }
+
+    put32(out, crc32(out.data(), out.size()));
+    return out;
+}
+
+std::pair<std::unique_ptr<GameState>, GameMode> GameRecord::decode(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    if (!isRecord(data, size)) {
+        throw std::invalid_argument("Not a game record");
+    }
+    if (size < HEADER_SIZE + CHECKSUM_SIZE) {
+        throw std::invalid_argument("Game record is truncated");
+    }
+    if (bytes[3] != VERSION) {
+        throw std::invalid_argument("Unsupported game record version " + std::to_string(bytes[3]));
+    }
+    if (crc32(bytes, size - CHECKSUM_SIZE) != get32(bytes + size - CHECKSUM_SIZE)) {
+        throw std::invalid_argument("Game record checksum mismatch");
+    }
+
+    const uint8_t flags = bytes[4];
+    if (bytes[5] > static_cast<uint8_t>(GameMode::AI_VS_AI)) {
+        throw std::invalid_argument("Invalid game mode in game record");
+    }
+    const GameMode gameMode = static_cast<GameMode>(bytes[5]);
+    const size_t plies = get16(bytes + 6);
+    size_t offset = HEADER_SIZE;
+
+    Board board;
+    Player side = Player::BLACK;
+    int turnNumber = 1;
+    if (flags & FLAG_CUSTOM_START) {
+        if (size < offset + START_SIZE + CHECKSUM_SIZE) {
+            throw std::invalid_argument("Game record is truncated");
+        }
+        for (int square = 0; square < FastBoard::SQUARES; ++square) {
+            int code = (bytes[offset + square / 4] >> ((square % 4) * 2)) & 3;
+            board.setCell(square / Board::SIZE, square % Board::SIZE, CELLS[code]);
+        }
+        offset += FastBoard::SQUARES / 4;
+        side = bytes[offset] ? Player::BLACK : Player::WHITE;
+        turnNumber = static_cast<int>(get16(bytes + offset + 1));
+        offset += 3;
+    } else {
+        board.initializeStandardPosition();
+    }
+    if (size != offset + (plies * MOVE_BITS + 7) / 8 + CHECKSUM_SIZE) {
+        throw std::invalid_argument("Game record length does not match its ply count");
+    }
+
+    // Bitboard replay: each move is a few mask tests instead of GameState's
+    // move-list scans, and the history is handed over whole at the end
+    FastBoard position = FastBoard::fromBoard(board, side);
+    std::vector<Move> history;
+    history.reserve(plies);
+    uint64_t pending = 0;
+    int pendingBits = 0;
+    for (size_t ply = 0; ply < plies; ++ply) {
+        while (pendingBits < MOVE_BITS) {
+            pending |= static_cast<uint64_t>(bytes[offset++]) << pendingBits;
+            pendingBits += 8;
+        }
+        PackedMove move = PackedMove::fromCode(static_cast<uint32_t>(pending & ((1u << MOVE_BITS) - 1)));
+        pending >>= MOVE_BITS;
+        pendingBits -= MOVE_BITS;
+
+        if (!position.isLegal(move)) {
+            throw std::invalid_argument("Illegal move at ply " + std::to_string(ply + 1) + " of game record");
+        }
+        if (position.sideToMove() == Player::BLACK) {
+            turnNumber++;   // as GameState::makeMove counts turns
+        }
+        position.makeMove(move);
+        history.push_back(move.toMove());
+    }
+
+    auto gameState = std::make_unique<GameState>(position.toBoard(), position.sideToMove(), turnNumber,
+                                                 std::move(history));
+    return {std::move(gameState), gameMode};
+}
+
+} // namespace amazons
@@ -0,0 +1,172 @@
+#include "utils/JsonReader.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace amazons {
+
+namespace {
+    // Far deeper than any of our files; bounds the recursion in skipValue
+    const int MAX_SKIP_DEPTH = 64;
+
+    bool isDigit(char c) {
+        return c >= '0' && c <= '9';
+    }
+}
+
+char JsonReader::peek() {
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\n' || text[pos] == '\r' || text[pos] == '\t')) {
+        ++pos;
+    }
+    return pos < text.size() ? text[pos] : '\0';
+}
+
+void JsonReader::expect(char c) {
+    if (peek() != c) {
+        fail((std::string("expected '") + c + "'").c_str());
+    }
+    ++pos;
+}
+
+void JsonReader::fail(const char* what) const {
+    throw std::invalid_argument(std::string("JSON: ") + what + " at offset " + std::to_string(pos));
+}
+
+void JsonReader::beginObject() {
+    expect('{');
+    first = true;
+}
+
+bool JsonReader::nextMember(std::string_view& key) {
+    if (peek() == '}') {
+        ++pos;
+        first = false;      // the object was itself a value of its parent
+        return false;
+    }
+    if (!first) {
+        expect(',');
+    }
+    first = false;
+    key = readString();
+    expect(':');
+    return true;
+}
+
+void JsonReader::beginArray() {
+    expect('[');
+    first = true;
+}
+
+bool JsonReader::nextElement() {
+    if (peek() == ']') {
+        ++pos;
+        first = false;
+        return false;
+    }
+    if (!first) {
+        expect(',');
+    }
+    first = false;
+    return true;
+}
+
+std::string_view JsonReader::readString() {
+    if (peek() != '"') {
+        fail("expected a string");
+    }
+    const size_t start = ++pos;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c == '"') {
+            return text.substr(start, pos++ - start);
+        }
+        if (static_cast<unsigned char>(c) < 0x20) {
+            fail("control character in string");
+        }
+        pos += c == '\\' ? 2 : 1;
+    }
+    fail("unterminated string");
+}
+
+int64_t JsonReader::readInteger() {
+    peek();
+    const bool negative = pos < text.size() && text[pos] == '-';
+    if (negative) {
+        ++pos;
+    }
+    if (pos >= text.size() || !isDigit(text[pos])) {
+        fail("expected an integer");
+    }
+    int64_t value = 0;
+    while (pos < text.size() && isDigit(text[pos])) {
+        if (value > (INT64_MAX - 9) / 10) {
+            fail("integer out of range");
+        }
+        value = value * 10 + (text[pos++] - '0');
+    }
+    if (pos < text.size() && (text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E')) {
+        fail("expected an integer");
+    }
+    return negative ? -value : value;
+}
+
+bool JsonReader::readBool() {
+    peek();
+    if (text.substr(pos, 4) == "true") {
+        pos += 4;
+        return true;
+    }
+    if (text.substr(pos, 5) == "false") {
+        pos += 5;
+        return false;
+    }
+    fail("expected true or false");
+}
+
+void JsonReader::skipValue() {
+    skipValue(0);
+}
+
+void JsonReader::skipValue(int depth) {
+    if (depth > MAX_SKIP_DEPTH) {
+        fail("nesting too deep");
+    }
+    const char c = peek();
+    if (c == '{') {
+        beginObject();
+        std::string_view key;
+        while (nextMember(key)) {
+            skipValue(depth + 1);
+        }
+    } else if (c == '[') {
+        beginArray();
+        while (nextElement()) {
+            skipValue(depth + 1);
+        }
+    } else if (c == '"') {
+        readString();
+    } else if (c == 't' || c == 'f') {
+        readBool();
+    } else if (c == 'n' && text.substr(pos, 4) == "null") {
+        pos += 4;
+    } else if (c == '-' || isDigit(c)) {
+        const size_t start = pos;
+        while (pos < text.size() && (isDigit(text[pos]) || text[pos] == '-' || text[pos] == '+' ||
+                                     text[pos] == '.' || text[pos] == 'e' || text[pos] == 'E')) {
+            ++pos;
+        }
+        if (!isDigit(text[pos - 1]) || (text[start] == '-' && pos == start + 1)) {
+            fail("malformed number");
+        }
+    } else {
+        fail("expected a value");
+    }
+}
+
+void JsonReader::expectEnd() {
+    peek();
+    if (pos != text.size()) {
+        fail("unexpected text after the document");
+    }
+}
+
+} // namespace amazons
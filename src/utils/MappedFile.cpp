@@ -0,0 +1,53 @@
+#include "utils/MappedFile.hpp"
+#include <fstream>
+#include <stdexcept>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace amazons {
+
+void MappedFile::map(const std::string& path, size_t size) {
+    reset();
+    if (size == 0) {
+        return;
+    }
+#ifdef _WIN32
+    std::ifstream file(path, std::ios::binary);
+    copy.resize(size);
+    if (!file.read(reinterpret_cast<char*>(copy.data()), static_cast<std::streamsize>(size))) {
+        copy.clear();
+        throw std::runtime_error("Could not read " + path);
+    }
+    bytes = copy.data();
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open " + path);
+    }
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + path);
+    }
+    bytes = static_cast<const unsigned char*>(address);
+#endif
+    length = size;
+}
+
+void MappedFile::reset() {
+#ifdef _WIN32
+    copy.clear();
+#else
+    if (bytes) {
+        ::munmap(const_cast<unsigned char*>(bytes), length);
+    }
+#endif
+    bytes = nullptr;
+    length = 0;
+}
+
+} // namespace amazons
@@ -0,0 +1,195 @@
+#include "utils/OpeningBook.hpp"
+#include "core/Symmetry.hpp"
+#include "utils/MappedFile.hpp"
+#include "utils/Serializer.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <system_error>
+
+namespace amazons {
+
+namespace {
+    const char MAGIC[8] = {'A', 'M', 'Z', 'B', 'O', 'O', 'K', '2'};
+    const size_t HEADER_SIZE = 16;
+
+    // Stored as-is, like the game database index
+    struct Entry {
+        uint64_t key;
+        uint32_t move;      // PackedMove::code() on the canonical form of the position
+        uint16_t weight;    // games, saturating
+        int16_t score;      // mean result for the mover, -1000 (lost) .. 1000 (won)
+    };
+    static_assert(sizeof(Entry) == 16, "book entries are 16 bytes on disk");
+
+    bool keyLess(const Entry& entry, uint64_t key) { return entry.key < key; }
+
+    // Best first within a key: most played, then best scoring
+    bool before(const Entry& a, const Entry& b) {
+        if (a.key != b.key) return a.key < b.key;
+        if (a.weight != b.weight) return a.weight > b.weight;
+        if (a.score != b.score) return a.score > b.score;
+        return a.move < b.move;
+    }
+
+    // First entry with the key, or end. A plain binary search, as in the game
+    // database: canonical keys are the smallest of eight Zobrist keys, so they
+    // crowd the low end of the range and interpolating on them misjudges badly.
+    const Entry* firstWithKey(const Entry* begin, const Entry* end, uint64_t key) {
+        const Entry* found = std::lower_bound(begin, end, key, keyLess);
+        return found != end && found->key == key ? found : end;
+    }
+
+    int16_t toScore(double result) {
+        return static_cast<int16_t>(std::lround((2.0 * result - 1.0) * 1000.0));
+    }
+
+    double fromScore(int16_t score) {
+        return (score / 1000.0 + 1.0) / 2.0;
+    }
+}
+
+bool OpeningBook::Builder::addGame(const GameState& game) {
+    if (!game.isGameOver()) {
+        return false;
+    }
+    GameState start = game;
+    while (start.canUndo()) {
+        start.undoLastMove();
+    }
+    const Player winner = game.getWinner();
+    FastBoard position = FastBoard::fromGameState(start);
+    int ply = 0;
+    for (const Move& move : game.getMoveHistory()) {
+        if (ply++ >= maxPlies) {
+            break;
+        }
+        const PackedMove packed = PackedMove::fromMove(move);
+        add(position, packed, position.sideToMove() == winner ? 1.0 : 0.0);
+        position.makeMove(packed);
+    }
+    return true;
+}
+
+void OpeningBook::Builder::add(const FastBoard& position, PackedMove move, double result) {
+    const Symmetry::Canonical canonical = Symmetry::canonical(position);
+    const FastBoard form = Symmetry::transform(position, canonical.symmetry);
+    const PackedMove turned = Symmetry::transform(move, canonical.symmetry);
+    // A position that is its own mirror image, like the start, has equivalent
+    // moves; count them as one, under the smallest code
+    uint32_t code = turned.code();
+    for (int symmetry = 1; symmetry < Symmetry::COUNT; ++symmetry) {
+        if (Symmetry::transform(form, symmetry) == form) {
+            code = std::min(code, Symmetry::transform(turned, symmetry).code());
+        }
+    }
+    Tally& tally = moves[{canonical.key, code}];
+    tally.games++;
+    tally.results += result;
+}
+
+size_t OpeningBook::Builder::positionCount() const {
+    size_t count = 0;
+    uint64_t previous = 0;
+    for (const auto& [keyAndMove, tally] : moves) {
+        if (count == 0 || keyAndMove.first != previous) {
+            ++count;
+            previous = keyAndMove.first;
+        }
+    }
+    return count;
+}
+
+void OpeningBook::Builder::write(const std::string& path, uint32_t minWeight) const {
+    std::vector<Entry> entries;
+    entries.reserve(moves.size());
+    for (const auto& [keyAndMove, tally] : moves) {
+        if (tally.games < minWeight) {
+            continue;
+        }
+        entries.push_back({keyAndMove.first, keyAndMove.second,
+                           static_cast<uint16_t>(std::min<uint32_t>(tally.games, 0xFFFF)),
+                           toScore(tally.results / tally.games)});
+    }
+    std::sort(entries.begin(), entries.end(), before);
+
+    std::string bytes(HEADER_SIZE + entries.size() * sizeof(Entry), '\0');
+    std::memcpy(&bytes[0], MAGIC, sizeof(MAGIC));
+    const uint64_t count = entries.size();
+    std::memcpy(&bytes[8], &count, sizeof(count));
+    if (!entries.empty()) {
+        std::memcpy(&bytes[HEADER_SIZE], entries.data(), entries.size() * sizeof(Entry));
+    }
+    Serializer::writeFileAtomically(path, bytes);
+}
+
+struct OpeningBook::Impl {
+    MappedFile map;
+    const Entry* entries = nullptr;
+    size_t count = 0;
+};
+
+OpeningBook::OpeningBook(const std::string& path) : impl(std::make_unique<Impl>()) {
+    std::error_code error;
+    const uint64_t size = std::filesystem::file_size(path, error);
+    if (error) {
+        throw std::runtime_error("Could not open opening book " + path);
+    }
+    if (size < HEADER_SIZE) {
+        throw std::runtime_error("Not an opening book: " + path);
+    }
+    impl->map.map(path, size);
+    const unsigned char* bytes = impl->map.data();
+    uint64_t count = 0;
+    std::memcpy(&count, bytes + 8, sizeof(count));
+    if (std::memcmp(bytes, MAGIC, sizeof(MAGIC)) != 0 || (size - HEADER_SIZE) / sizeof(Entry) != count ||
+        (size - HEADER_SIZE) % sizeof(Entry) != 0) {
+        throw std::runtime_error("Not an opening book: " + path);
+    }
+    impl->entries = reinterpret_cast<const Entry*>(bytes + HEADER_SIZE);
+    impl->count = static_cast<size_t>(count);
+}
+
+OpeningBook::~OpeningBook() = default;
+
+size_t OpeningBook::size() const {
+    return impl->count;
+}
+
+std::vector<OpeningBook::BookMove> OpeningBook::lookup(const FastBoard& position) const {
+    std::vector<BookMove> found;
+    const Symmetry::Canonical canonical = Symmetry::canonical(position);
+    const int back = Symmetry::inverse(canonical.symmetry);
+    const uint64_t key = canonical.key;
+    const Entry* end = impl->entries + impl->count;
+    for (const Entry* entry = firstWithKey(impl->entries, end, key); entry != end && entry->key == key; ++entry) {
+        found.push_back({Symmetry::transform(PackedMove::fromCode(entry->move), back), entry->weight,
+                         fromScore(entry->score)});
+    }
+    return found;
+}
+
+bool OpeningBook::probe(const FastBoard& position, PackedMove& move) const {
+    const Symmetry::Canonical canonical = Symmetry::canonical(position);
+    const int back = Symmetry::inverse(canonical.symmetry);
+    const uint64_t key = canonical.key;
+    const Entry* end = impl->entries + impl->count;
+    // Entries are best first, so the first legal one wins. A key collision or
+    // a book built from other rules could offer an illegal move; skip it.
+    for (const Entry* entry = firstWithKey(impl->entries, end, key); entry != end && entry->key == key; ++entry) {
+        const PackedMove candidate = Symmetry::transform(PackedMove::fromCode(entry->move), back);
+        if (position.isLegal(candidate)) {
+            move = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t OpeningBook::positionKey(const FastBoard& position) {
+    return Symmetry::canonical(position).key;
+}
+
+} // namespace amazons
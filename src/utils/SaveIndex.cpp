@@ -0,0 +1,141 @@
+#include "utils/SaveIndex.hpp"
+#include "utils/GameRecord.hpp"
+#include "utils/Serializer.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    const char MAGIC[8] = {'A', 'M', 'Z', 'S', 'I', 'X', '0', '1'};
+
+    // Longest name the u16 length can hold
+    const size_t MAX_NAME = 0xFFFF;
+
+    void putLE(std::string& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+
+    // Little-endian reader over the file; load() checks the bounds
+    struct Input {
+        const std::string& bytes;
+        size_t pos = 0;
+
+        uint64_t get(int count) {
+            uint64_t value = 0;
+            for (int i = 0; i < count; ++i) {
+                value |= static_cast<uint64_t>(static_cast<unsigned char>(bytes[pos++])) << (8 * i);
+            }
+            return value;
+        }
+    };
+
+    bool byName(const SaveInfo& info, const std::string& name) {
+        return info.name < name;
+    }
+}
+
+SaveIndex::SaveIndex(const std::string& directory) : path(directory + FILE_NAME) {}
+
+bool SaveIndex::load() {
+    entries.clear();
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string bytes;
+    try {
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    } catch (const std::ios_base::failure&) {
+        return false;   // e.g. a directory where the file should be
+    }
+    if (bytes.size() < sizeof(MAGIC) + 8 || std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    Input crcInput{bytes, bytes.size() - 4};
+    if (crcInput.get(4) != GameRecord::crc32(bytes.data(), bytes.size() - 4)) {
+        return false;
+    }
+
+    Input in{bytes, sizeof(MAGIC)};
+    const size_t end = bytes.size() - 4;
+    const uint64_t count = in.get(4);
+    std::vector<SaveInfo> loaded;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (in.pos + 2 > end) {
+            return false;
+        }
+        const size_t length = static_cast<size_t>(in.get(2));
+        if (in.pos + length + 18 > end) {
+            return false;
+        }
+        SaveInfo info;
+        info.name = bytes.substr(in.pos, length);
+        in.pos += length;
+        info.savedAt = static_cast<int64_t>(in.get(8));
+        info.turnNumber = static_cast<int>(in.get(4));
+        info.plies = static_cast<uint32_t>(in.get(4));
+        const uint64_t mode = in.get(1);
+        if (mode > static_cast<uint64_t>(GameMode::AI_VS_AI)) {
+            return false;
+        }
+        info.gameMode = static_cast<GameMode>(mode);
+        info.record = in.get(1) != 0;
+        if (!loaded.empty() && !(loaded.back().name < info.name)) {
+            return false;   // out of order or duplicated: not written by us
+        }
+        loaded.push_back(std::move(info));
+    }
+    if (in.pos != end) {
+        return false;
+    }
+    entries = std::move(loaded);
+    return true;
+}
+
+void SaveIndex::store() const {
+    std::string bytes(MAGIC, sizeof(MAGIC));
+    putLE(bytes, entries.size(), 4);
+    for (const SaveInfo& info : entries) {
+        putLE(bytes, info.name.size(), 2);
+        bytes += info.name;
+        putLE(bytes, static_cast<uint64_t>(info.savedAt), 8);
+        putLE(bytes, static_cast<uint32_t>(info.turnNumber), 4);
+        putLE(bytes, info.plies, 4);
+        putLE(bytes, static_cast<uint64_t>(info.gameMode), 1);
+        putLE(bytes, info.record ? 1 : 0, 1);
+    }
+    putLE(bytes, GameRecord::crc32(bytes.data(), bytes.size()), 4);
+    Serializer::writeFileAtomically(path, bytes);
+}
+
+void SaveIndex::put(const SaveInfo& info) {
+    if (info.name.size() > MAX_NAME) {
+        throw std::invalid_argument("Save name too long for the index");
+    }
+    auto at = std::lower_bound(entries.begin(), entries.end(), info.name, byName);
+    if (at != entries.end() && at->name == info.name) {
+        *at = info;
+    } else {
+        entries.insert(at, info);
+    }
+}
+
+void SaveIndex::erase(const std::string& name) {
+    auto at = std::lower_bound(entries.begin(), entries.end(), name, byName);
+    if (at != entries.end() && at->name == name) {
+        entries.erase(at);
+    }
+}
+
+const SaveInfo* SaveIndex::find(const std::string& name) const {
+    auto at = std::lower_bound(entries.begin(), entries.end(), name, byName);
+    return at != entries.end() && at->name == name ? &*at : nullptr;
+}
+
+} // namespace amazons
@@ -1,41 +1,102 @@
 #include "utils/Serializer.hpp"
-#include <fstream>
+#include "utils/GameRecord.hpp"
+#include "utils/JsonReader.hpp"
 #include <iostream>
 #include <sstream>
 #include <vector>
+#include <unordered_map>
 #include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <fcntl.h>
 #include <sys/stat.h> // For mkdir
+#include <unistd.h>
+#ifdef _WIN32
+#include <io.h>     // For _commit
+#endif
 #include <dirent.h>   // For directory operations
 
 namespace amazons {
 
-bool Serializer::saveGame(const GameState& gameState, GameMode gameMode, const std::string& filename) const {
-    try {
-        std::string json = serializeGameState(gameState, gameMode);
-        std::string fullPath = getFullPath(filename);
-        
-        // Create save directory if it doesn't exist
-        std::string saveDir = getSaveDirectory();
+namespace {
+    // Index updates are read-modify-write; saves may come from an AsyncSaver thread
+    std::mutex indexMutex;
+    
+    // Identifies one version of the index file; store() renames a new file
+    // into place, so the inode changes on every write
+    struct IndexStamp {
+        bool exists = false;
+        int64_t modified = 0;       // nanoseconds where the platform has them
+        int64_t size = 0;
+        uint64_t inode = 0;
+        
+        bool operator==(const IndexStamp& other) const {
+            return exists == other.exists && modified == other.modified && size == other.size &&
+                   inode == other.inode;
+        }
+    };
+    
+    IndexStamp stampOf(const std::string& path) {
+        IndexStamp stamp;
         struct stat info;
-        if (stat(saveDir.c_str(), &info) != 0) {
-            // Directory doesn't exist, create it
-            #ifdef _WIN32
-                mkdir(saveDir.c_str());
-            #else
-                mkdir(saveDir.c_str(), 0755);
-            #endif
+        if (stat(path.c_str(), &info) != 0) {
+            return stamp;
         }
-        
-        std::ofstream file(fullPath);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file for writing: " << fullPath << std::endl;
-            return false;
+        stamp.exists = true;
+#ifdef __linux__
+        stamp.modified = static_cast<int64_t>(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec;
+#else
+        stamp.modified = static_cast<int64_t>(info.st_mtime);
+#endif
+        stamp.size = static_cast<int64_t>(info.st_size);
+        stamp.inode = static_cast<uint64_t>(info.st_ino);
+        return stamp;
+    }
+    
+    // The index last read or written in each save directory, reused while the
+    // file on disk is the one it came from; guarded by indexMutex
+    struct CachedIndex {
+        IndexStamp stamp;
+        SaveIndex index;
+    };
+    std::unordered_map<std::string, CachedIndex> indexCache;
+    
+    void remember(const SaveIndex& index, const std::string& directory) {
+        indexCache.insert_or_assign(directory, CachedIndex{stampOf(index.getPath()), index});
+    }
+    
+    bool hasExtension(const std::string& filename, const char* extension) {
+        size_t length = strlen(extension);
+        return filename.length() > length && filename.compare(filename.length() - length, length, extension) == 0;
+    }
+    
+    // Save name without either file extension
+    std::string baseName(const std::string& filename) {
+        for (const char* extension : {".json", ".amzr"}) {
+            if (hasExtension(filename, extension)) {
+                return filename.substr(0, filename.length() - strlen(extension));
+            }
         }
-        
-        file << json;
-        file.close();
-        
-        std::cout << "Game saved to: " << fullPath << std::endl;
+        return filename;
+    }
+}
+
+Serializer::Serializer(const std::string& saveDirectory) : saveDirectoryOverride(saveDirectory) {
+    if (!saveDirectoryOverride.empty() && saveDirectoryOverride.back() != '/') {
+        saveDirectoryOverride += '/';
+    }
+}
+
+bool Serializer::saveGame(const GameState& gameState, GameMode gameMode, const std::string& filename,
+                          SaveFormat format) const {
+    try {
+        writeSave(gameState, gameMode, filename, format);
+        std::cout << "Game saved to: " << (format == SaveFormat::RECORD ? getRecordPath(filename) : getFullPath(filename)) << std::endl;
         return true;
     } catch (const std::exception& e) {
         std::cerr << "Error saving game: " << e.what() << std::endl;
@@ -43,126 +104,279 @@ bool Serializer::saveGame(const GameState& gameState, GameMode gameMode, const s
     }
 }
 
-std::unique_ptr<GameState> Serializer::loadGame(const std::string& filename) const {
+void Serializer::writeSave(const GameState& gameState, GameMode gameMode, const std::string& filename,
+                           SaveFormat format) const {
+    const bool record = format == SaveFormat::RECORD;
+    std::string content = record ? GameRecord::encode(gameState, gameMode) : serializeGameState(gameState, gameMode);
+    std::string fullPath = record ? getRecordPath(filename) : getFullPath(filename);
+    
+    // Create save directory, and data/ above it, if they don't exist
+    std::error_code ignored;
+    std::filesystem::create_directories(getSaveDirectory(), ignored);
+    
+    writeFileAtomically(fullPath, content);
+    
+    // One save per name: a stale copy in the other format would shadow or confuse it
+    std::remove((record ? getFullPath(filename) : getRecordPath(filename)).c_str());
+    
+    // The save is already safe; a stale index only costs a rebuild later
     try {
-        std::string fullPath = getFullPath(filename);
-        
-        // Check if file exists
-        std::ifstream testFile(fullPath);
-        if (!testFile.good()) {
-            std::cerr << "Error: Save file does not exist: " << fullPath << std::endl;
-            return nullptr;
+        const int64_t now = std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        std::lock_guard<std::mutex> lock(indexMutex);
+        SaveIndex index = openIndex();
+        index.put(describeSave(baseName(filename), gameState, gameMode, record, now));
+        storeIndex(index);
+    } catch (const std::exception& e) {
+        std::cerr << "Error updating save index: " << e.what() << std::endl;
+        std::remove(SaveIndex(getSaveDirectory()).getPath().c_str());
+    }
+}
+
+void Serializer::writeFileAtomically(const std::string& path, const std::string& content) {
+    // Written aside, flushed to the device and renamed over the old save, so
+    // a crash leaves either the old file or the new one, never a torn one
+    const std::string temporary = path + ".tmp";
+#ifdef O_BINARY
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+#else
+    int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+#endif
+    if (fd < 0) {
+        throw std::runtime_error("Could not open file for writing: " + temporary);
+    }
+    size_t done = 0;
+    bool written = true;
+    while (done < content.size()) {
+        auto count = ::write(fd, content.data() + done, static_cast<unsigned>(content.size() - done));
+        if (count < 0 && errno == EINTR) {
+            continue;
         }
-        testFile.close();
-        
-        std::ifstream file(fullPath);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file for reading: " << fullPath << std::endl;
-            return nullptr;
+        if (count <= 0) {
+            written = false;
+            break;
         }
-        
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string json = buffer.str();
-        file.close();
-        
-        auto gameState = deserializeGameState(json);
-        if (gameState) {
-            std::cout << "Game loaded from: " << fullPath << std::endl;
+        done += static_cast<size_t>(count);
+    }
+#ifdef _WIN32
+    written = written && _commit(fd) == 0;
+#else
+    written = written && fsync(fd) == 0;
+#endif
+    written = ::close(fd) == 0 && written;
+    if (!written) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Failed writing " + temporary);
+    }
+    
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Could not replace " + path + ": " + error.message());
+    }
+#ifndef _WIN32
+    // The rename itself is durable only once the directory is
+    int dir = ::open(std::filesystem::path(path).parent_path().string().c_str(), O_RDONLY | O_CLOEXEC);
+    if (dir >= 0) {
+        fsync(dir);
+        ::close(dir);
+    }
+#endif
+}
+
+std::unique_ptr<GameState> Serializer::loadGame(const std::string& filename) const {
+    return std::move(loadGameWithMode(filename).first);
+}
+
+std::pair<std::unique_ptr<GameState>, GameMode> Serializer::loadGameWithMode(const std::string& filename) const {
+    try {
+        // Opening is the existence check: no stat or probe open first
+        for (const std::string& fullPath : {getRecordPath(filename), getFullPath(filename)}) {
+            if (!readFile(fullPath)) {
+                continue;
+            }
+            auto result = decodeSave(readBuffer);
+            if (result.first) {
+                std::cout << "Game loaded from: " << fullPath << std::endl;
+            }
+            return result;
         }
-        
-        return gameState;
+        std::cerr << "Error: Save file does not exist: " << getFullPath(filename) << std::endl;
+        return {nullptr, GameMode::HUMAN_VS_HUMAN};
     } catch (const std::exception& e) {
         std::cerr << "Error loading game: " << e.what() << std::endl;
-        return nullptr;
+        return {nullptr, GameMode::HUMAN_VS_HUMAN};
     }
 }
 
-std::pair<std::unique_ptr<GameState>, GameMode> Serializer::loadGameWithMode(const std::string& filename) const {
+std::pair<std::unique_ptr<GameState>, GameMode> Serializer::loadGameFile(const std::string& path) const {
     try {
-        std::string fullPath = getFullPath(filename);
-        
-        // Check if file exists
-        std::ifstream testFile(fullPath);
-        if (!testFile.good()) {
-            std::cerr << "Error: Save file does not exist: " << fullPath << std::endl;
+        if (!readFile(path)) {
+            std::cerr << "Error: Could not open file for reading: " << path << std::endl;
             return {nullptr, GameMode::HUMAN_VS_HUMAN};
         }
-        testFile.close();
-        
-        std::ifstream file(fullPath);
-        if (!file.is_open()) {
-            std::cerr << "Error: Could not open file for reading: " << fullPath << std::endl;
-            return {nullptr, GameMode::HUMAN_VS_HUMAN};
-        }
-        
-        std::stringstream buffer;
-        buffer << file.rdbuf();
-        std::string json = buffer.str();
-        file.close();
-        
-        auto result = deserializeGameStateWithMode(json);
-        if (result.first) {
-            std::cout << "Game loaded from: " << fullPath << std::endl;
-        }
-        
-        return result;
+        return decodeSave(readBuffer);
     } catch (const std::exception& e) {
         std::cerr << "Error loading game: " << e.what() << std::endl;
         return {nullptr, GameMode::HUMAN_VS_HUMAN};
     }
 }
 
+bool Serializer::readFile(const std::string& path) const {
+#ifdef O_BINARY
+    int fd = ::open(path.c_str(), O_RDONLY | O_BINARY);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+#endif
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Could not stat " + path);
+    }
+    // The buffer only ever grows, so a bulk import allocates once
+    readBuffer.resize(static_cast<size_t>(info.st_size));
+    size_t done = 0;
+    while (done < readBuffer.size()) {
+        auto count = ::read(fd, &readBuffer[done], static_cast<unsigned>(readBuffer.size() - done));
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            break;
+        }
+        done += static_cast<size_t>(count);
+    }
+    ::close(fd);
+    // A file that shrank underneath us is read as what was there
+    readBuffer.resize(done);
+    return true;
+}
+
 std::vector<std::string> Serializer::getSavedGames() const {
     std::vector<std::string> savedGames;
-    
+    for (const SaveInfo& info : listSaves()) {
+        savedGames.push_back(info.name);
+    }
+    return savedGames;
+}
+
+std::vector<SaveInfo> Serializer::listSaves() const {
     try {
-        std::string saveDir = getSaveDirectory();
-        
-        DIR* dir = opendir(saveDir.c_str());
-        if (dir == nullptr) {
-            return savedGames; // Directory doesn't exist
-        }
-        
-        struct dirent* entry;
-        while ((entry = readdir(dir)) != nullptr) {
-            std::string filename = entry->d_name;
-            if (filename.length() > 5 && filename.substr(filename.length() - 5) == ".json") {
-                savedGames.push_back(filename.substr(0, filename.length() - 5));
-            }
-        }
-        
-        closedir(dir);
-        
-        // Sort alphabetically
-        std::sort(savedGames.begin(), savedGames.end());
-        
+        std::lock_guard<std::mutex> lock(indexMutex);
+        return openIndex().all();
     } catch (const std::exception& e) {
         std::cerr << "Error listing saved games: " << e.what() << std::endl;
+        return {};
+    }
+}
+
+void Serializer::rebuildSaveIndex() const {
+    std::lock_guard<std::mutex> lock(indexMutex);
+    SaveIndex index(getSaveDirectory());
+    rebuildIndex(index);
+}
+
+SaveIndex Serializer::openIndex() const {
+    const std::string directory = getSaveDirectory();
+    SaveIndex index(directory);
+    auto cached = indexCache.find(directory);
+    if (cached != indexCache.end() && cached->second.stamp == stampOf(index.getPath())) {
+        return cached->second.index;
+    }
+    if (index.load()) {
+        remember(index, directory);
+    } else {
+        rebuildIndex(index);
+    }
+    return index;
+}
+
+void Serializer::storeIndex(const SaveIndex& index) const {
+    index.store();
+    remember(index, getSaveDirectory());
+}
+
+void Serializer::rebuildIndex(SaveIndex& index) const {
+    index.clear();
+    std::string saveDir = getSaveDirectory();
+    DIR* dir = opendir(saveDir.c_str());
+    if (dir == nullptr) {
+        return; // Directory doesn't exist, so neither do saves
     }
     
-    return savedGames;
+    std::vector<std::string> files;
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        files.push_back(entry->d_name);
+    }
+    closedir(dir);
+    
+    for (const std::string& file : files) {
+        const bool record = hasExtension(file, RECORD_EXTENSION);
+        if (!record && !hasExtension(file, JSON_EXTENSION)) {
+            continue;
+        }
+        const std::string name = baseName(file);
+        const SaveInfo* existing = index.find(name);
+        if (existing && existing->record) {
+            continue;   // both formats on disk: loading prefers the record
+        }
+        const std::string path = saveDir + file;
+        struct stat info;
+        if (!readFile(path) || stat(path.c_str(), &info) != 0) {
+            continue;
+        }
+        auto loaded = decodeSave(readBuffer);
+        if (!loaded.first) {
+            continue;
+        }
+        index.put(describeSave(name, *loaded.first, loaded.second, record, static_cast<int64_t>(info.st_mtime)));
+    }
+    try {
+        storeIndex(index);
+    } catch (const std::exception& e) {
+        // A read-only directory still lists its saves; kept against whatever
+        // file is there, so they are not rescanned on every call
+        std::cerr << "Error writing save index: " << e.what() << std::endl;
+        remember(index, saveDir);
+    }
+}
+
+SaveInfo Serializer::describeSave(const std::string& name, const GameState& gameState, GameMode gameMode,
+                                  bool record, int64_t savedAt) {
+    SaveInfo info;
+    info.name = name;
+    info.savedAt = savedAt;
+    info.turnNumber = gameState.getTurnNumber();
+    info.plies = record ? static_cast<uint32_t>(gameState.getMoveHistory().size()) : 0;
+    info.gameMode = gameMode;
+    info.record = record;
+    return info;
 }
 
 bool Serializer::saveExists(const std::string& filename) const {
-    std::string fullPath = getFullPath(filename);
-    std::ifstream file(fullPath);
-    return file.good();
+    return !findSave(filename).empty();
 }
 
 bool Serializer::deleteSave(const std::string& filename) const {
     try {
-        std::string fullPath = getFullPath(filename);
-        
-        // Check if file exists
-        std::ifstream testFile(fullPath);
-        if (!testFile.good()) {
-            std::cerr << "Error: Save file does not exist: " << fullPath << std::endl;
+        if (findSave(filename).empty()) {
+            std::cerr << "Error: Save file does not exist: " << getFullPath(filename) << std::endl;
             return false;
         }
-        testFile.close();
         
-        return std::remove(fullPath.c_str()) == 0;
+        bool removedJson = std::remove(getFullPath(filename).c_str()) == 0;
+        bool removedRecord = std::remove(getRecordPath(filename).c_str()) == 0;
+        
+        std::lock_guard<std::mutex> lock(indexMutex);
+        SaveIndex index = openIndex();
+        index.erase(baseName(filename));
+        storeIndex(index);
+        return removedJson || removedRecord;
     } catch (const std::exception& e) {
         std::cerr << "Error deleting save file: " << e.what() << std::endl;
         return false;
@@ -214,95 +428,68 @@ std::string Serializer::serializeGameState(const GameState& gameState, GameMode
     return ss.str();
 }
 
-std::unique_ptr<GameState> Serializer::deserializeGameState(const std::string& json) const {
+std::unique_ptr<GameState> Serializer::deserializeGameState(std::string_view json) const {
     // For backward compatibility, just parse game state without mode
     auto result = deserializeGameStateWithMode(json);
     return std::move(result.first);
 }
 
-std::pair<std::unique_ptr<GameState>, GameMode> Serializer::deserializeGameStateWithMode(const std::string& json) const {
-    // Simple JSON parsing for our specific format
+std::pair<std::unique_ptr<GameState>, GameMode> Serializer::deserializeGameStateWithMode(std::string_view json) const {
+    // One pass over the text, members in any order; unknown members are skipped
     // We expect format: {"board": "..........BB......BB..........WW......WW..........", "current_player": "white", "turn_number": 1, "game_mode": "human_vs_human"}
     
     try {
-        // Extract board string
-        size_t boardStart = json.find(FIELD_BOARD);
-        if (boardStart == std::string::npos) {
-            throw std::runtime_error("Board field not found in JSON");
-        }
-        
-        boardStart = json.find('"', boardStart + strlen(FIELD_BOARD) + 3); // Skip "board": "
-        if (boardStart == std::string::npos) {
-            throw std::runtime_error("Invalid board field format");
+        std::string_view boardStr;
+        std::string_view playerStr;
+        std::string_view modeStr;
+        int64_t turnNumber = 0;
+        bool haveTurn = false;
+        
+        JsonReader reader(json);
+        reader.beginObject();
+        std::string_view key;
+        while (reader.nextMember(key)) {
+            if (key == FIELD_BOARD) {
+                boardStr = reader.readString();
+            } else if (key == FIELD_CURRENT_PLAYER) {
+                playerStr = reader.readString();
+            } else if (key == FIELD_TURN_NUMBER) {
+                turnNumber = reader.readInteger();
+                haveTurn = true;
+            } else if (key == FIELD_GAME_MODE) {
+                modeStr = reader.readString();
+            } else {
+                reader.skipValue();
+            }
         }
+        reader.expectEnd();
         
-        size_t boardEnd = json.find('"', boardStart + 1);
-        if (boardEnd == std::string::npos) {
-            throw std::runtime_error("Invalid board field format");
+        if (boardStr.data() == nullptr) {
+            throw std::runtime_error("Board field not found in JSON");
         }
-        
-        std::string boardStr = json.substr(boardStart + 1, boardEnd - boardStart - 1);
         if (boardStr.length() != Board::SIZE * Board::SIZE) {
             throw std::runtime_error("Invalid board string length");
         }
-        
-        // Extract current player
-        size_t playerStart = json.find(FIELD_CURRENT_PLAYER);
-        if (playerStart == std::string::npos) {
+        if (playerStr.data() == nullptr) {
             throw std::runtime_error("Current player field not found in JSON");
         }
-        
-        playerStart = json.find('"', playerStart + strlen(FIELD_CURRENT_PLAYER) + 3);
-        if (playerStart == std::string::npos) {
-            throw std::runtime_error("Invalid current player field format");
-        }
-        
-        size_t playerEnd = json.find('"', playerStart + 1);
-        if (playerEnd == std::string::npos) {
-            throw std::runtime_error("Invalid current player field format");
-        }
-        
-        std::string playerStr = json.substr(playerStart + 1, playerEnd - playerStart - 1);
-        Player currentPlayer = (playerStr == "white") ? Player::WHITE : Player::BLACK;
-        
-        // Extract turn number
-        size_t turnStart = json.find(FIELD_TURN_NUMBER);
-        if (turnStart == std::string::npos) {
+        Player currentPlayer = (playerStr == FIELD_PLAYER_WHITE) ? Player::WHITE : Player::BLACK;
+        if (!haveTurn) {
             throw std::runtime_error("Turn number field not found in JSON");
         }
-        
-        turnStart = json.find(':', turnStart) + 1;
-        size_t turnEnd = json.find_first_of(",\n}", turnStart);
-        if (turnEnd == std::string::npos) {
-            throw std::runtime_error("Invalid turn number field format");
+        if (turnNumber < 1 || turnNumber > INT32_MAX) {
+            throw std::runtime_error("Invalid turn number");
         }
         
-        std::string turnStr = json.substr(turnStart, turnEnd - turnStart);
-        int turnNumber = std::stoi(turnStr);
-        
-        // Extract game mode (optional for backward compatibility)
+        // Game mode is optional for backward compatibility
         GameMode gameMode = GameMode::HUMAN_VS_HUMAN; // Default
-        size_t modeStart = json.find(FIELD_GAME_MODE);
-        if (modeStart != std::string::npos) {
-            modeStart = json.find('"', modeStart + strlen(FIELD_GAME_MODE) + 3);
-            if (modeStart != std::string::npos) {
-                size_t modeEnd = json.find('"', modeStart + 1);
-                if (modeEnd != std::string::npos) {
-                    std::string modeStr = json.substr(modeStart + 1, modeEnd - modeStart - 1);
-                    if (modeStr == "human_vs_human") {
-                        gameMode = GameMode::HUMAN_VS_HUMAN;
-                    } else if (modeStr == "human_vs_ai_human_white") {
-                        gameMode = GameMode::HUMAN_VS_AI_HUMAN_WHITE;
-                    } else if (modeStr == "human_vs_ai_human_black") {
-                        gameMode = GameMode::HUMAN_VS_AI_HUMAN_BLACK;
-                    } else if (modeStr == "human_vs_ai") {
-                        // Backward compatibility: old HUMAN_VS_AI maps to HUMAN_VS_AI_HUMAN_BLACK
-                        gameMode = GameMode::HUMAN_VS_AI_HUMAN_BLACK;
-                    } else if (modeStr == "ai_vs_ai") {
-                        gameMode = GameMode::AI_VS_AI;
-                    }
-                }
-            }
+        if (modeStr == "human_vs_ai_human_white") {
+            gameMode = GameMode::HUMAN_VS_AI_HUMAN_WHITE;
+        } else if (modeStr == "human_vs_ai_human_black" || modeStr == "human_vs_ai") {
+            // Backward compatibility: old HUMAN_VS_AI maps to HUMAN_VS_AI_HUMAN_BLACK
+            gameMode = GameMode::HUMAN_VS_AI_HUMAN_BLACK;
+        } else if (modeStr == "ai_vs_ai") {
+            gameMode = GameMode::AI_VS_AI;
         }
         
         // Create board from string
@@ -323,7 +510,7 @@ std::pair<std::unique_ptr<GameState>, GameMode> Serializer::deserializeGameState
         }
         
         // Create game state with restored board, player, and turn number
-        auto gameState = std::make_unique<GameState>(board, currentPlayer, turnNumber);
+        auto gameState = std::make_unique<GameState>(board, currentPlayer, static_cast<int>(turnNumber));
         
         return {std::move(gameState), gameMode};
         
@@ -335,26 +522,59 @@ std::pair<std::unique_ptr<GameState>, GameMode> Serializer::deserializeGameState
 }
 
 std::string Serializer::getSaveDirectory() const {
-    // Try to find the project root directory
-    // First check if data/saves exists in current directory (project root)
-    struct stat info;
-    if (stat("data/saves/", &info) == 0 && S_ISDIR(info.st_mode)) {
-        return "data/saves/";
-    }
-    // If not, try ../data/saves/ (when running from build/ directory)
-    if (stat("../data/saves/", &info) == 0 && S_ISDIR(info.st_mode)) {
-        return "../data/saves/";
+    if (!saveDirectoryOverride.empty()) {
+        return saveDirectoryOverride;
     }
-    // Default to data/saves/ in current directory
-    return "data/saves/";
+    // Resolved once per process instead of two stats on every call
+    static const std::string directory = [] {
+        // Try to find the project root directory
+        // First check if data/saves exists in current directory (project root)
+        struct stat info;
+        if (stat("data/saves/", &info) == 0 && S_ISDIR(info.st_mode)) {
+            return "data/saves/";
+        }
+        // If not, try ../data/saves/ (when running from build/ directory)
+        if (stat("../data/saves/", &info) == 0 && S_ISDIR(info.st_mode)) {
+            return "../data/saves/";
+        }
+        // Default to data/saves/ in current directory
+        return "data/saves/";
+    }();
+    return directory;
 }
 
 std::string Serializer::getFullPath(const std::string& filename) const {
-    std::string baseName = filename;
-    if (baseName.find(".json") == std::string::npos) {
-        baseName += ".json";
+    return getSaveDirectory() + baseName(filename) + JSON_EXTENSION;
+}
+
+std::string Serializer::getRecordPath(const std::string& filename) const {
+    return getSaveDirectory() + baseName(filename) + RECORD_EXTENSION;
+}
+
+std::string Serializer::getJournalPath(const std::string& name) const {
+    return getSaveDirectory() + baseName(name) + JOURNAL_EXTENSION;
+}
+
+std::string Serializer::findSave(const std::string& filename) const {
+    struct stat info;
+    for (const std::string& path : {getRecordPath(filename), getFullPath(filename)}) {
+        if (stat(path.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+            return path;
+        }
+    }
+    return "";
+}
+
+std::pair<std::unique_ptr<GameState>, GameMode> Serializer::decodeSave(std::string_view content) const {
+    if (!GameRecord::isRecord(content.data(), content.size())) {
+        return deserializeGameStateWithMode(content);
+    }
+    try {
+        return GameRecord::decode(content.data(), content.size());
+    } catch (const std::exception& e) {
+        std::cerr << "Error reading game record: " << e.what() << std::endl;
+        return {nullptr, GameMode::HUMAN_VS_HUMAN};
     }
-    return getSaveDirectory() + baseName;
 }
 
 } // namespace amazons
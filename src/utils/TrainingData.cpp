@@ -0,0 +1,187 @@
+#include "utils/TrainingData.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace amazons {
+
+namespace {
+    constexpr uint8_t FLAG_BLACK_TO_MOVE = 1;
+    constexpr uint8_t FLAG_SIDE_TO_MOVE_WON = 2;
+    constexpr uint8_t FLAG_HAS_SCORE = 4;
+
+    // Encoded records are collected into this much memory before each fwrite
+    constexpr size_t WRITE_BUFFER_BYTES = 1 << 20;
+
+    void putU64(unsigned char* out, uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(value >> (8 * i));
+        }
+    }
+
+    uint64_t getU64(const unsigned char* in) {
+        uint64_t value = 0;
+        for (int i = 0; i < 8; ++i) {
+            value |= static_cast<uint64_t>(in[i]) << (8 * i);
+        }
+        return value;
+    }
+}
+
+void TrainingRecord::encode(unsigned char* out) const {
+    putU64(out, arrows);
+    putU64(out + 8, white);
+    putU64(out + 16, black);
+    uint16_t rawScore = static_cast<uint16_t>(score);
+    out[24] = static_cast<unsigned char>(rawScore);
+    out[25] = static_cast<unsigned char>(rawScore >> 8);
+    out[26] = ply;
+    out[27] = static_cast<unsigned char>((blackToMove ? FLAG_BLACK_TO_MOVE : 0) |
+                                         (sideToMoveWon ? FLAG_SIDE_TO_MOVE_WON : 0) |
+                                         (hasScore ? FLAG_HAS_SCORE : 0));
+}
+
+TrainingRecord TrainingRecord::decode(const unsigned char* in) {
+    TrainingRecord record;
+    record.arrows = getU64(in);
+    record.white = getU64(in + 8);
+    record.black = getU64(in + 16);
+    record.score = static_cast<int16_t>(static_cast<uint16_t>(in[24] | (in[25] << 8)));
+    record.ply = in[26];
+    record.blackToMove = (in[27] & FLAG_BLACK_TO_MOVE) != 0;
+    record.sideToMoveWon = (in[27] & FLAG_SIDE_TO_MOVE_WON) != 0;
+    record.hasScore = (in[27] & FLAG_HAS_SCORE) != 0;
+    return record;
+}
+
+bool TrainingRecord::operator==(const TrainingRecord& other) const {
+    return arrows == other.arrows && white == other.white && black == other.black &&
+           score == other.score && ply == other.ply && blackToMove == other.blackToMove &&
+           sideToMoveWon == other.sideToMoveWon && hasScore == other.hasScore;
+}
+
+TrainingDataWriter::TrainingDataWriter(const std::string& path, size_t maxPendingBatches)
+    : file(std::fopen(path.c_str(), "wb")), maxPending(maxPendingBatches ? maxPendingBatches : 1) {
+    if (!file) {
+        throw std::runtime_error("Could not open training data file " + path);
+    }
+    // The writer thread owns all buffering, so stdio's own buffer is not needed
+    std::setvbuf(file, nullptr, _IONBF, 0);
+    if (std::fwrite(MAGIC, 1, sizeof(MAGIC), file) != sizeof(MAGIC)) {
+        std::fclose(file);
+        throw std::runtime_error("Could not write training data header to " + path);
+    }
+    writer = std::thread(&TrainingDataWriter::writerLoop, this);
+}
+
+TrainingDataWriter::~TrainingDataWriter() {
+    try {
+        close();
+    } catch (...) {
+        // Destructors must not throw; call close() to see write errors
+    }
+}
+
+void TrainingDataWriter::submit(std::vector<TrainingRecord> batch) {
+    if (batch.empty()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    notFull.wait(lock, [this]() { return pending.size() < maxPending || closing; });
+    if (closing) {
+        throw std::logic_error("TrainingDataWriter: submit after close");
+    }
+    pending.push_back(std::move(batch));
+    notEmpty.notify_one();
+}
+
+void TrainingDataWriter::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!writer.joinable()) {
+            return;
+        }
+        closing = true;
+    }
+    notEmpty.notify_all();
+    notFull.notify_all();
+    writer.join();
+    bool error = std::fclose(file) != 0 || failed;
+    file = nullptr;
+    if (error) {
+        throw std::runtime_error("Failed writing training data");
+    }
+}
+
+uint64_t TrainingDataWriter::recordsWritten() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return written;
+}
+
+void TrainingDataWriter::writerLoop() {
+    std::vector<unsigned char> buffer;
+    buffer.reserve(WRITE_BUFFER_BYTES + TrainingRecord::RECORD_SIZE);
+    uint64_t buffered = 0;
+
+    auto flush = [&]() {
+        if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+            std::lock_guard<std::mutex> lock(mutex);
+            failed = true;
+        }
+        buffer.clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        written += buffered;
+        buffered = 0;
+    };
+
+    while (true) {
+        std::vector<TrainingRecord> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notEmpty.wait(lock, [this]() { return !pending.empty() || closing; });
+            if (pending.empty()) {
+                break;
+            }
+            batch = std::move(pending.front());
+            pending.pop_front();
+        }
+        notFull.notify_one();
+
+        for (const auto& record : batch) {
+            size_t offset = buffer.size();
+            buffer.resize(offset + TrainingRecord::RECORD_SIZE);
+            record.encode(buffer.data() + offset);
+        }
+        buffered += batch.size();
+        if (buffer.size() >= WRITE_BUFFER_BYTES) {
+            flush();
+        }
+    }
+    flush();
+}
+
+std::vector<TrainingRecord> readTrainingData(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Could not open training data file " + path);
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(TrainingDataWriter::MAGIC) ||
+        std::memcmp(bytes.data(), TrainingDataWriter::MAGIC, sizeof(TrainingDataWriter::MAGIC)) != 0) {
+        throw std::runtime_error("Not a training data file: " + path);
+    }
+    size_t body = bytes.size() - sizeof(TrainingDataWriter::MAGIC);
+    if (body % TrainingRecord::RECORD_SIZE != 0) {
+        throw std::runtime_error("Truncated training data file: " + path);
+    }
+    std::vector<TrainingRecord> records;
+    records.reserve(body / TrainingRecord::RECORD_SIZE);
+    for (size_t offset = sizeof(TrainingDataWriter::MAGIC); offset < bytes.size();
+         offset += TrainingRecord::RECORD_SIZE) {
+        records.push_back(TrainingRecord::decode(bytes.data() + offset));
+    }
+    return records;
+}
+
+} // namespace amazons
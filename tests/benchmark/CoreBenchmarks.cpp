@@ -0,0 +1,283 @@
+#include <benchmark/benchmark.h>
+#include "ai/BasicAI.hpp"
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include "core/Move.hpp"
+#include "core/PositionNotation.hpp"
+#include "core/Symmetry.hpp"
+#include "utils/GameRecord.hpp"
+#include "utils/Serializer.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace amazons;
+
+namespace {
+    enum class Phase { OPENING, MIDGAME, ENDGAME };
+
+    // Plies of random play behind each position in a phase's set
+    constexpr int OPENING_PLIES[] = {0, 2, 4, 6};
+    constexpr int MIDGAME_PLIES[] = {16, 20, 24, 28};
+    constexpr int ENDGAME_PLIES[] = {36, 40, 44, 48};
+
+    GameState playRandomPlies(int plies, uint64_t seed) {
+        GameState state;
+        FastRandom rng(seed);
+        for (int i = 0; i < plies && !state.isGameOver(); ++i) {
+            auto moves = state.getLegalMoves();
+            state.makeMove(moves[rng.below(static_cast<uint32_t>(moves.size()))]);
+        }
+        return state;
+    }
+
+    // Fixed seeds, so every run and every release measures the same positions
+    std::vector<GameState> buildPositions(Phase phase) {
+        const int* plies = phase == Phase::OPENING ? OPENING_PLIES
+                         : phase == Phase::MIDGAME ? MIDGAME_PLIES : ENDGAME_PLIES;
+        std::vector<GameState> positions;
+        for (int i = 0; i < 4; ++i) {
+            GameState state = playRandomPlies(plies[i], 1000 + static_cast<uint64_t>(i));
+            if (!state.isGameOver()) {
+                positions.push_back(state);
+            }
+        }
+        if (positions.empty()) {
+            positions.push_back(GameState());
+        }
+        return positions;
+    }
+
+    // With AMAZONS_BENCH_POSITIONS=DIR, a phase's set comes from DIR/<phase>.txt,
+    // one position per line in PositionNotation, instead of the built-in seeds
+    std::vector<GameState> loadPositions(Phase phase) {
+        const char* directory = std::getenv("AMAZONS_BENCH_POSITIONS");
+        if (!directory) {
+            return buildPositions(phase);
+        }
+        const char* names[] = {"opening", "midgame", "endgame"};
+        std::ifstream file(std::string(directory) + "/" + names[static_cast<int>(phase)] + ".txt");
+        std::vector<GameState> positions;
+        std::string line;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[0] != '#') {
+                positions.push_back(PositionNotation::parseGameState(line));
+            }
+        }
+        return positions.empty() ? buildPositions(phase) : positions;
+    }
+
+    const std::vector<GameState>& positions(Phase phase) {
+        static const std::vector<GameState> sets[] = {
+            loadPositions(Phase::OPENING), loadPositions(Phase::MIDGAME), loadPositions(Phase::ENDGAME)
+        };
+        return sets[static_cast<int>(phase)];
+    }
+
+    std::vector<Position> amazonsOf(const GameState& state, Player player) {
+        Board::Cell piece = player == Player::WHITE ? Board::Cell::WHITE_AMAZON : Board::Cell::BLACK_AMAZON;
+        std::vector<Position> result;
+        for (int r = 0; r < Board::SIZE; ++r) {
+            for (int c = 0; c < Board::SIZE; ++c) {
+                if (state.getBoard().getCell(r, c) == piece) {
+                    result.emplace_back(r, c);
+                }
+            }
+        }
+        return result;
+    }
+}
+
+static void BM_BoardGetLegalMoves(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    std::vector<std::vector<Position>> pieces;
+    for (const auto& state : set) {
+        pieces.push_back(amazonsOf(state, state.getCurrentPlayer()));
+    }
+    size_t i = 0;
+    for (auto _ : bench) {
+        const GameState& state = set[i % set.size()];
+        for (const auto& from : pieces[i % set.size()]) {
+            benchmark::DoNotOptimize(state.getBoard().getLegalMoves(from));
+        }
+        ++i;
+    }
+}
+
+static void BM_GetLegalMovesForPlayer(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    size_t i = 0;
+    size_t moves = 0;
+    for (auto _ : bench) {
+        const GameState& state = set[i++ % set.size()];
+        auto legal = state.getLegalMovesForPlayer(state.getCurrentPlayer());
+        moves += legal.size();
+        benchmark::DoNotOptimize(legal);
+    }
+    bench.counters["moves"] = benchmark::Counter(static_cast<double>(moves), benchmark::Counter::kIsRate);
+}
+
+static void BM_FastBoardGenerateMoves(benchmark::State& bench, Phase phase) {
+    std::vector<FastBoard> boards;
+    for (const auto& state : positions(phase)) {
+        boards.push_back(FastBoard::fromGameState(state));
+    }
+    std::vector<PackedMove> buffer(FastBoard::MAX_MOVES);
+    size_t i = 0;
+    size_t moves = 0;
+    for (auto _ : bench) {
+        moves += static_cast<size_t>(boards[i++ % boards.size()].generateMoves(buffer.data()));
+        benchmark::ClobberMemory();
+    }
+    bench.counters["moves"] = benchmark::Counter(static_cast<double>(moves), benchmark::Counter::kIsRate);
+}
+
+static void BM_IsValidMove(benchmark::State& bench, Phase phase) {
+    // Every legal move of each position, plus the same moves with the arrow shifted (mostly illegal)
+    std::vector<std::pair<const GameState*, Move>> probes;
+    for (const auto& state : positions(phase)) {
+        for (const auto& move : state.getLegalMoves()) {
+            probes.emplace_back(&state, move);
+            Move shifted = move;
+            shifted.arrow.col = static_cast<int8_t>((shifted.arrow.col + 3) % Board::SIZE);
+            probes.emplace_back(&state, shifted);
+        }
+    }
+    size_t i = 0;
+    for (auto _ : bench) {
+        const auto& probe = probes[i++ % probes.size()];
+        benchmark::DoNotOptimize(probe.first->isValidMove(probe.second));
+    }
+}
+
+static void BM_MakeUndoMove(benchmark::State& bench, Phase phase) {
+    std::vector<GameState> states = positions(phase);
+    std::vector<Move> firstMoves;
+    for (const auto& state : states) {
+        firstMoves.push_back(state.getLegalMoves().front());
+    }
+    size_t i = 0;
+    for (auto _ : bench) {
+        size_t k = i++ % states.size();
+        states[k].makeMove(firstMoves[k]);
+        states[k].undoLastMove();
+    }
+}
+
+static void BM_CountReachableSquares(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    size_t i = 0;
+    for (auto _ : bench) {
+        const Board& board = set[i++ % set.size()].getBoard();
+        benchmark::DoNotOptimize(board.countReachableSquares(Player::WHITE));
+        benchmark::DoNotOptimize(board.countReachableSquares(Player::BLACK));
+    }
+}
+
+static void BM_BasicAIGetBestMove(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    BasicAI ai;
+    size_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(ai.getBestMove(set[i++ % set.size()]));
+    }
+}
+
+static void BM_SerializerRoundTrip(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    Serializer serializer;
+    size_t i = 0;
+    for (auto _ : bench) {
+        std::string json = serializer.serializeGameState(set[i++ % set.size()], GameMode::HUMAN_VS_HUMAN);
+        benchmark::DoNotOptimize(serializer.deserializeGameStateWithMode(json));
+    }
+}
+
+static void BM_GameRecordRoundTrip(benchmark::State& bench, Phase phase) {
+    const auto& set = positions(phase);
+    size_t i = 0;
+    for (auto _ : bench) {
+        std::string bytes = GameRecord::encode(set[i++ % set.size()], GameMode::HUMAN_VS_HUMAN);
+        benchmark::DoNotOptimize(GameRecord::decode(bytes));
+    }
+}
+
+static void BM_PositionNotationParse(benchmark::State& bench, Phase phase) {
+    std::vector<std::string> texts;
+    for (const GameState& state : positions(phase)) {
+        texts.push_back(PositionNotation::format(state));
+    }
+    FastBoard board;
+    int turn = 0;
+    size_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(PositionNotation::tryParse(texts[i++ % texts.size()], board, turn));
+        benchmark::DoNotOptimize(board);
+    }
+}
+
+static void BM_CanonicalKey(benchmark::State& bench, Phase phase) {
+    std::vector<FastBoard> boards;
+    for (const GameState& state : positions(phase)) {
+        boards.push_back(FastBoard::fromGameState(state));
+    }
+    size_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(Symmetry::canonical(boards[i++ % boards.size()]));
+    }
+}
+
+static void BM_MoveFromString(benchmark::State& bench) {
+    std::vector<std::string> texts;
+    for (const auto& move : GameState().getLegalMoves()) {
+        texts.push_back(move.toString());
+    }
+    size_t i = 0;
+    for (auto _ : bench) {
+        benchmark::DoNotOptimize(Move::fromString(texts[i++ % texts.size()]));
+    }
+}
+
+#define AMAZONS_PHASE_BENCHMARK(name)                            \
+    BENCHMARK_CAPTURE(name, opening, Phase::OPENING);            \
+    BENCHMARK_CAPTURE(name, midgame, Phase::MIDGAME);            \
+    BENCHMARK_CAPTURE(name, endgame, Phase::ENDGAME)
+
+AMAZONS_PHASE_BENCHMARK(BM_BoardGetLegalMoves);
+AMAZONS_PHASE_BENCHMARK(BM_GetLegalMovesForPlayer);
+AMAZONS_PHASE_BENCHMARK(BM_FastBoardGenerateMoves);
+AMAZONS_PHASE_BENCHMARK(BM_IsValidMove);
+AMAZONS_PHASE_BENCHMARK(BM_MakeUndoMove);
+AMAZONS_PHASE_BENCHMARK(BM_CountReachableSquares);
+BENCHMARK_CAPTURE(BM_BasicAIGetBestMove, opening, Phase::OPENING)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BasicAIGetBestMove, midgame, Phase::MIDGAME)->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(BM_BasicAIGetBestMove, endgame, Phase::ENDGAME)->Unit(benchmark::kMillisecond);
+AMAZONS_PHASE_BENCHMARK(BM_SerializerRoundTrip);
+AMAZONS_PHASE_BENCHMARK(BM_GameRecordRoundTrip);
+AMAZONS_PHASE_BENCHMARK(BM_PositionNotationParse);
+AMAZONS_PHASE_BENCHMARK(BM_CanonicalKey);
+BENCHMARK(BM_MoveFromString);
+
+// Same as BENCHMARK_MAIN(), but JSON is the default output so results can be diffed
+// release over release; pass --benchmark_format=console for a readable table
+int main(int argc, char** argv) {
+    static char jsonFormat[] = "--benchmark_format=json";
+    std::vector<char*> args(argv, argv + argc);
+    bool formatGiven = false;
+    for (int i = 1; i < argc; ++i) {
+        formatGiven = formatGiven || std::strncmp(argv[i], "--benchmark_format", 18) == 0;
+    }
+    if (!formatGiven) {
+        args.push_back(jsonFormat);
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <gtest/gtest.h>
+#include "utils/AsyncSaver.hpp"
+#include "TestHelpers.hpp"
+#include <filesystem>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+TEST(AsyncSaverTest, LastSnapshotOfASlotWins) {
+    TempDirectory directory("amazons_async_saver_slot_test");
+    const std::string name = "async_saver_test_slot";
+    const GameState game = randomGame(11, 30);
+    const size_t plies = game.getMoveHistory().size();
+    {
+        AsyncSaver saver(directory.path);
+        for (size_t ply = 1; ply <= plies; ++ply) {
+            saver.save(prefix(game, ply), GameMode::AI_VS_AI, name);
+        }
+        EXPECT_TRUE(saver.isPending(name) || !saver.takeFinished().empty());
+        saver.flush();
+        EXPECT_FALSE(saver.isPending(name));
+
+        // Coalesced: at most one write per save call, every one of them good
+        auto finished = saver.takeFinished();
+        EXPECT_LE(finished.size(), plies);
+        for (const auto& outcome : finished) {
+            EXPECT_EQ(outcome.name, name);
+            EXPECT_TRUE(outcome.saved) << outcome.error;
+        }
+        EXPECT_TRUE(saver.takeFinished().empty());
+    }
+
+    Serializer serializer(directory.path);
+    auto [loaded, mode] = serializer.loadGameWithMode(name);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(*loaded, game);
+    EXPECT_EQ(loaded->getMoveHistory(), game.getMoveHistory());
+    EXPECT_EQ(mode, GameMode::AI_VS_AI);
+    EXPECT_TRUE(serializer.deleteSave(name));
+}
+
+TEST(AsyncSaverTest, DestructorFinishesQueuedSaves) {
+    TempDirectory directory("amazons_async_saver_queue_test");
+    const GameState game = randomGame(12, 10);
+    const int slots = 5;
+    {
+        AsyncSaver saver(directory.path);
+        for (int i = 0; i < slots; ++i) {
+            saver.save(prefix(game, i + 1), GameMode::HUMAN_VS_HUMAN, "async_saver_test_" + std::to_string(i),
+                       i % 2 ? Serializer::SaveFormat::JSON : Serializer::SaveFormat::RECORD);
+        }
+    }
+
+    Serializer serializer(directory.path);
+    for (int i = 0; i < slots; ++i) {
+        const std::string name = "async_saver_test_" + std::to_string(i);
+        auto loaded = serializer.loadGame(name);
+        ASSERT_TRUE(loaded) << name;
+        EXPECT_EQ(*loaded, prefix(game, i + 1));
+        EXPECT_TRUE(serializer.deleteSave(name));
+    }
+}
+
+TEST(AsyncSaverTest, WriteLeavesNoTemporaryFile) {
+    TempDirectory directory("amazons_async_saver_atomic_test");
+    const std::string name = "async_saver_test_atomic";
+    Serializer serializer(directory.path);
+    GameState state;
+    serializer.writeSave(state, GameMode::HUMAN_VS_HUMAN, name, Serializer::SaveFormat::RECORD);
+    serializer.writeSave(randomGame(13, 4), GameMode::HUMAN_VS_HUMAN, name, Serializer::SaveFormat::RECORD);
+
+    for (const auto& entry : std::filesystem::directory_iterator(directory.path)) {
+        EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+    }
+    auto loaded = serializer.loadGame(name);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->getMoveHistory().size(), 4u);
+    EXPECT_TRUE(serializer.deleteSave(name));
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "ai/BotProcessPool.hpp"
+#include "ai/BotzoneAI.hpp"
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+using namespace amazons;
+
+#ifndef _WIN32
+namespace {
+    // Waits for the background thread to top the pool up
+    bool waitForIdle(const BotProcessPool& pool, size_t count) {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (pool.idleCount() < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return true;
+    }
+}
+
+TEST(BotProcessPoolTest, KeepsIdleProcessesReady) {
+    BotProcessPool pool("/bin/cat", 2);
+    ASSERT_TRUE(waitForIdle(pool, 2));
+    EXPECT_EQ(pool.processesStarted(), 2u);
+
+    std::unique_ptr<BotProcess> bot = pool.acquire();
+    ASSERT_TRUE(bot->isRunning());
+    ASSERT_TRUE(bot->sendFirstTurn({"2 0 5 3 2 6"}));
+    EXPECT_EQ(bot->readMove(5.0), "1");
+    EXPECT_EQ(bot->readMove(5.0), "2 0 5 3 2 6");
+
+    // The handed-out process is replaced in the background
+    ASSERT_TRUE(waitForIdle(pool, 2));
+    EXPECT_EQ(pool.processesStarted(), 3u);
+}
+
+TEST(BotProcessPoolTest, AcquireStartsOneWhenEmpty) {
+    BotProcessPool pool("/bin/cat", 0);
+    std::unique_ptr<BotProcess> bot = pool.acquire();
+    EXPECT_TRUE(bot->isRunning());
+    EXPECT_EQ(pool.idleCount(), 0u);
+}
+
+TEST(BotProcessPoolTest, SkipsProcessesThatDiedWhileIdle) {
+    // Exits as soon as it starts
+    BotProcessPool pool("/bin/true", 1);
+    ASSERT_TRUE(waitForIdle(pool, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    pool.acquire();
+    EXPECT_GE(pool.processesDiscarded(), 1u);
+}
+
+TEST(BotProcessPoolTest, BotzoneAIUsesPool) {
+    auto pool = std::make_shared<BotProcessPool>("/bin/cat", 1);
+    BotzoneAI ai(pool);
+    EXPECT_TRUE(ai.isBotAvailable());
+    EXPECT_EQ(ai.getBotPath(), "/bin/cat");
+    ai.setProcessPool(nullptr);
+    EXPECT_FALSE(ai.isBotAvailable());
+}
+#endif
+
+TEST(BotProcessPoolTest, RejectsEmptyPath) {
+    EXPECT_THROW(BotProcessPool(""), std::invalid_argument);
+}
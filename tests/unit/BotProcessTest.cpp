@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "ai/BotProcess.hpp"
+#include "utils/LineBuffer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/stat.h>
+#endif
+
+using namespace amazons;
+
+namespace {
+    // Every test in the binary that talks to bots needs what the tools do in main()
+    class IgnoreSigpipe : public ::testing::Environment {
+    public:
+        void SetUp() override {
+#ifndef _WIN32
+            signal(SIGPIPE, SIG_IGN);
+#endif
+        }
+    };
+
+    ::testing::Environment* const ignoreSigpipe = ::testing::AddGlobalTestEnvironment(new IgnoreSigpipe);
+}
+
+TEST(BotProcessTest, LineBufferSplitsLinesAcrossWrites) {
+    LineBuffer buffer(8);
+    std::string line;
+    buffer.append("2 0 5", 5);
+    EXPECT_FALSE(buffer.popLine(line));
+    buffer.append(" 3 2 6\r\nabc\n", 12);
+    ASSERT_TRUE(buffer.popLine(line));
+    EXPECT_EQ(line, "2 0 5 3 2 6");
+    ASSERT_TRUE(buffer.popLine(line));
+    EXPECT_EQ(line, "abc");
+    EXPECT_FALSE(buffer.popLine(line));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(BotProcessTest, LineBufferWrapsAround) {
+    LineBuffer buffer(8);
+    std::string line;
+    for (int i = 0; i < 100; ++i) {
+        std::string text = std::to_string(i) + "\n";
+        buffer.append(text.data(), text.size());
+        ASSERT_TRUE(buffer.popLine(line));
+        EXPECT_EQ(line, std::to_string(i));
+    }
+    buffer.append("tail", 4);
+    EXPECT_EQ(buffer.takeAll(), "tail");
+}
+
+#ifndef _WIN32
+// /bin/cat echoes every request back, which makes it a zero-work bot
+TEST(BotProcessTest, EchoRoundTripsAreFast) {
+    BotProcess bot("/bin/cat");
+    ASSERT_TRUE(bot.start());
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 500; ++i) {
+        ASSERT_TRUE(bot.sendFirstTurn({"2 0 5 3 2 6"}));
+        ASSERT_EQ(bot.readMove(5.0), "1");
+        ASSERT_EQ(bot.readMove(5.0), "2 0 5 3 2 6");
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // Polling with 10 ms sleeps needed several seconds for this
+    EXPECT_LT(seconds, 2.0);
+}
+
+TEST(BotProcessTest, ReadTimesOutAtDeadline) {
+    BotProcess bot("/bin/cat");
+    ASSERT_TRUE(bot.start());
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(bot.readMove(0.05), "");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    EXPECT_GE(seconds, 0.05);
+    EXPECT_LT(seconds, 0.5);
+}
+
+TEST(BotProcessTest, KeepRunningMarkerEnablesTurns) {
+    BotProcess bot("/bin/cat");
+    ASSERT_TRUE(bot.start());
+    EXPECT_FALSE(bot.sendTurn("2 0 5 3 2 6"));
+    ASSERT_TRUE(bot.sendFirstTurn({">>>BOTZONE_REQUEST_KEEP_RUNNING<<<"}));
+    EXPECT_EQ(bot.readMove(5.0), "1");
+    EXPECT_EQ(bot.readKeepRunning(5.0), ">>>BOTZONE_REQUEST_KEEP_RUNNING<<<");
+    EXPECT_TRUE(bot.isKeepRunning());
+    ASSERT_TRUE(bot.sendTurn("2 0 5 3 2 6"));
+    EXPECT_EQ(bot.readMove(5.0), "2 0 5 3 2 6");
+}
+
+TEST(BotProcessTest, MissingExecutableFailsToStart) {
+    BotProcess bot("/nonexistent/bot");
+    EXPECT_FALSE(bot.start());
+    EXPECT_FALSE(bot.isRunning());
+    EXPECT_EQ(bot.readMove(0.01), "");
+}
+
+TEST(BotProcessTest, ReportsPerMoveCost) {
+    BotProcess bot("/bin/cat");
+    ASSERT_TRUE(bot.start());
+    ASSERT_TRUE(bot.sendFirstTurn({"2 0 5 3 2 6"}));
+    ASSERT_EQ(bot.readMove(5.0), "1");
+    const BotProcess::MoveStats& stats = bot.getLastMoveStats();
+    EXPECT_GT(stats.wallSeconds, 0.0);
+    EXPECT_LT(stats.wallSeconds, 5.0);
+    EXPECT_GE(stats.userSeconds, 0.0);
+    EXPECT_GE(stats.systemSeconds, 0.0);
+#ifdef __linux__
+    EXPECT_GT(stats.peakRssBytes, 0u);
+#endif
+
+    // Final figures come from wait4 after the bot is gone
+    bot.stop();
+    EXPECT_GT(bot.getUsage().peakRssBytes, 0u);
+}
+
+#ifdef __linux__
+TEST(BotProcessTest, CpuLimitStopsSpinningBot) {
+    const std::string path = "botprocess_spin_test.sh";
+    {
+        std::ofstream script(path);
+        script << "#!/bin/sh\nwhile :; do :; done\n";
+    }
+    ::chmod(path.c_str(), 0755);
+
+    BotProcess bot("./" + path);
+    bot.setLimits({1.0, 0});
+    ASSERT_TRUE(bot.start());
+    auto start = std::chrono::steady_clock::now();
+    while (bot.isRunning() && std::chrono::steady_clock::now() - start < std::chrono::seconds(10)) {
+        bot.readMove(0.1);
+    }
+    EXPECT_FALSE(bot.isRunning());
+    EXPECT_GE(bot.getUsage().userSeconds + bot.getUsage().systemSeconds, 0.9);
+    std::remove(path.c_str());
+}
+#endif
+#endif
@@ -0,0 +1,135 @@
+#include <gtest/gtest.h>
+#include "ai/BotServer.hpp"
+#include "utils/TimerWheel.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace amazons;
+
+namespace {
+    using Clock = TimerWheel::Clock;
+    using std::chrono::milliseconds;
+
+    std::vector<uint64_t> expire(TimerWheel& wheel, Clock::time_point now) {
+        std::vector<uint64_t> keys;
+        wheel.advance(now, [&](uint64_t key) { keys.push_back(key); });
+        return keys;
+    }
+}
+
+TEST(BotServerTest, TimerWheelFiresAtDeadlineNotBefore) {
+    Clock::time_point origin;
+    TimerWheel wheel(milliseconds(10), 8, origin);
+    wheel.schedule(1, origin + milliseconds(25));
+    wheel.schedule(2, origin + milliseconds(5));
+    wheel.schedule(3, origin + milliseconds(200));   // more than one revolution away
+
+    EXPECT_TRUE(expire(wheel, origin + milliseconds(9)).empty());
+    EXPECT_EQ(expire(wheel, origin + milliseconds(10)), std::vector<uint64_t>{2});
+    EXPECT_TRUE(expire(wheel, origin + milliseconds(29)).empty());
+    EXPECT_EQ(expire(wheel, origin + milliseconds(30)), std::vector<uint64_t>{1});
+    EXPECT_EQ(*wheel.timeUntilNext(origin + milliseconds(30)), milliseconds(170));
+    EXPECT_TRUE(expire(wheel, origin + milliseconds(199)).empty());
+    EXPECT_EQ(expire(wheel, origin + milliseconds(200)), std::vector<uint64_t>{3});
+    EXPECT_TRUE(wheel.empty());
+    EXPECT_FALSE(wheel.timeUntilNext(origin + milliseconds(200)));
+}
+
+TEST(BotServerTest, TimerWheelFiresOverdueTimersOnNextAdvance) {
+    Clock::time_point origin;
+    TimerWheel wheel(milliseconds(10), 8, origin);
+    expire(wheel, origin + milliseconds(100));
+    wheel.schedule(7, origin + milliseconds(50));
+    // Already due, so it goes into the next tick
+    EXPECT_EQ(*wheel.timeUntilNext(origin + milliseconds(100)), milliseconds(10));
+    EXPECT_EQ(expire(wheel, origin + milliseconds(110)), std::vector<uint64_t>{7});
+}
+
+#if !defined(_WIN32) && defined(AMAZONS_BOT_PATH)
+namespace {
+    // Executable shell script in the working directory, removed afterwards
+    struct Script {
+        std::string path;
+        Script(const std::string& name, const std::string& body) : path("./" + name) {
+            std::ofstream(path) << "#!/bin/sh\n" << body << "\n";
+            ::chmod(path.c_str(), 0755);
+        }
+        ~Script() { std::remove(path.c_str()); }
+    };
+
+    const std::string QUICK_BOT = std::string("exec ") + AMAZONS_BOT_PATH + " --time 0.02 --margin 0 --seed $$";
+}
+
+TEST(BotServerTest, PlaysRoundRobinBetweenRealBots) {
+    Script keepRunning("botserver_keep.sh", QUICK_BOT);
+    // Answers every turn from a fresh process with the full history
+    Script oneShot("botserver_oneshot.sh", QUICK_BOT + " --no-keep-running");
+    const std::string resultsPath = "botserver_results_test.csv";
+
+    BotServer::Options options;
+    options.bots = {keepRunning.path, oneShot.path};
+    options.gamesPerPair = 2;
+    options.turnSeconds = 2.0;
+    options.resultsPath = resultsPath;
+    BotServer::Result result = BotServer::run(options);
+
+    ASSERT_EQ(result.games.size(), 2u);
+    for (const auto& game : result.games) {
+        EXPECT_EQ(game.reason, BotServer::EndReason::NO_MOVES) << game.moves;
+        EXPECT_GT(game.plies, 10);
+        EXPECT_TRUE(game.winner == game.black || game.winner == game.white);
+        // Whoever moved last won: Black on odd ply counts
+        EXPECT_EQ(game.winner, game.plies % 2 == 1 ? game.black : game.white);
+    }
+    EXPECT_EQ(result.played, (std::vector<int>{2, 2}));
+    EXPECT_EQ(result.wins[0] + result.wins[1], 2);
+
+    std::ifstream csv(resultsPath);
+    std::string line;
+    int lines = 0;
+    while (std::getline(csv, line)) {
+        lines++;
+    }
+    EXPECT_EQ(lines, 3);
+    std::remove(resultsPath.c_str());
+}
+
+TEST(BotServerTest, SilentAndCrashingBotsLose) {
+    Script good("botserver_good.sh", QUICK_BOT);
+    Script silent("botserver_silent.sh", "exec sleep 30");
+    Script crashing("botserver_crash.sh", "exit 3");
+
+    BotServer::Options options;
+    options.bots = {good.path, silent.path, crashing.path};
+    options.gamesPerPair = 2;
+    options.turnSeconds = 0.3;
+    options.startupSeconds = 0.5;
+    BotServer::Result result = BotServer::run(options);
+
+    ASSERT_EQ(result.games.size(), 6u);
+    EXPECT_EQ(result.wins[0], 4);
+    for (const auto& game : result.games) {
+        bool silentPlays = game.black == 1 || game.white == 1;
+        bool crashPlays = game.black == 2 || game.white == 2;
+        if (silentPlays && !crashPlays) {
+            EXPECT_EQ(game.reason, BotServer::EndReason::TIMEOUT);
+            EXPECT_EQ(game.winner, 0);
+        } else if (crashPlays && !silentPlays) {
+            EXPECT_EQ(game.reason, BotServer::EndReason::CRASH);
+            EXPECT_EQ(game.winner, 0);
+        }
+    }
+}
+#endif
+
+TEST(BotServerTest, NeedsTwoBots) {
+    BotServer::Options options;
+    options.bots = {"./only"};
+    EXPECT_THROW(BotServer::run(options), std::invalid_argument);
+}
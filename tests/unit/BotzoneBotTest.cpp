@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+#include "ai/BotzoneBot.hpp"
+#include "ai/BotzoneProtocol.hpp"
+#include "core/FastBoard.hpp"
+#include <sstream>
+#include <string>
+
+using namespace amazons;
+
+namespace {
+    BotzoneBot::Options quickOptions(uint64_t seed) {
+        BotzoneBot::Options options;
+        options.mcts.maxPlayouts = 40;
+        options.mcts.seed = seed;
+        return options;
+    }
+
+    // Feeds one chunk of input and returns the move line, checking the marker after it
+    std::string answer(BotzoneBot& bot, const std::string& input) {
+        std::istringstream in(input);
+        std::ostringstream out;
+        EXPECT_EQ(bot.run(in, out), 1);
+        std::istringstream lines(out.str());
+        std::string move, marker, extra;
+        std::getline(lines, move);
+        std::getline(lines, marker);
+        EXPECT_EQ(marker, BotzoneProtocol::KEEP_RUNNING);
+        EXPECT_FALSE(std::getline(lines, extra));
+        return move;
+    }
+}
+
+TEST(BotzoneBotTest, MoveTextUsesColumnThenRow) {
+    Move move(Position(0, 2), Position(3, 5), Position(6, 2));
+    EXPECT_EQ(BotzoneProtocol::formatMove(move), "2 0 5 3 2 6");
+    EXPECT_EQ(BotzoneProtocol::parseMove("2 0 5 3 2 6"), move);
+    EXPECT_EQ(BotzoneProtocol::formatMove(std::nullopt), "-1 -1 -1 -1 -1 -1");
+    EXPECT_FALSE(BotzoneProtocol::parseMove("-1 -1 -1 -1 -1 -1"));
+    EXPECT_THROW(BotzoneProtocol::parseMove("2 0 5"), std::invalid_argument);
+}
+
+TEST(BotzoneBotTest, PlaysAWholeGameInKeepRunningMode) {
+    BotzoneBot black(quickOptions(1));
+    BotzoneBot white(quickOptions(2));
+
+    std::string move = answer(black, "1\n-1 -1 -1 -1 -1 -1\n");
+    move = answer(white, "1\n" + move + "\n");
+    bool blackToMove = true;
+    int plies = 2;
+    while (move != "-1 -1 -1 -1 -1 -1") {
+        move = answer(blackToMove ? black : white, move + "\n");
+        blackToMove = !blackToMove;
+        ASSERT_LE(++plies, 100);
+    }
+    // Both processes followed the same game; the one that answered -1 had no move left
+    FastBoard blackView = FastBoard::fromGameState(black.getGameState());
+    FastBoard whiteView = FastBoard::fromGameState(white.getGameState());
+    EXPECT_EQ(blackView.hash(), whiteView.hash());
+    EXPECT_TRUE(black.getGameState().isGameOver());
+}
+
+TEST(BotzoneBotTest, ReplaysFullHistoryAsBlack) {
+    BotzoneBot black(quickOptions(3));
+    answer(black, "2\n-1 -1 -1 -1 -1 -1\n2 0 2 3 5 6\n7 5 6 5 6 4\n");
+    const Board& board = black.getGameState().getBoard();
+    EXPECT_EQ(board.getCell(3, 2), Board::Cell::BLACK_AMAZON);
+    EXPECT_EQ(board.getCell(5, 6), Board::Cell::WHITE_AMAZON);
+    EXPECT_EQ(board.getCell(4, 6), Board::Cell::ARROW);
+    // Our reply has been played as well
+    EXPECT_EQ(black.getGameState().getCurrentPlayer(), Player::WHITE);
+}
+
+TEST(BotzoneBotTest, AcceptsFullHistoryAsWhite) {
+    BotzoneBot white(quickOptions(4));
+    std::string reply = answer(white, "1\n2 0 2 3 5 6\n");
+    const GameState& state = white.getGameState();
+    EXPECT_EQ(state.getCurrentPlayer(), Player::BLACK);
+    EXPECT_EQ(state.getBoard().getCell(3, 2), Board::Cell::BLACK_AMAZON);
+    EXPECT_EQ(state.getBoard().getCell(6, 5), Board::Cell::ARROW);
+    EXPECT_NE(reply, "-1 -1 -1 -1 -1 -1");
+}
+
+TEST(BotzoneBotTest, RejectsIllegalHistory) {
+    BotzoneBot bot(quickOptions(5));
+    std::istringstream in("1\n0 0 1 1 2 2\n");
+    std::ostringstream out;
+    EXPECT_THROW(bot.run(in, out), std::invalid_argument);
+}
+
+TEST(BotzoneBotTest, AnswersInJsonWhenSpokenTo) {
+    BotzoneBot white(quickOptions(6));
+    std::string reply = answer(white, R"({"requests":[{"x0":2,"y0":0,"x1":2,"y1":3,"x2":5,"y2":6}],"responses":[]})" "\n");
+    std::optional<Move> first = BotzoneProtocol::parseJsonOutput(reply).move;
+    ASSERT_TRUE(first);
+    EXPECT_EQ(white.getGameState().getMoveHistory().back(), *first);
+
+    // Keep-running turns carry only the opponent's move
+    GameState state = white.getGameState();
+    Move reply2 = state.getLegalMoves().front();
+    std::string next = answer(white, BotzoneProtocol::jsonMove(reply2) + "\n");
+    EXPECT_TRUE(BotzoneProtocol::parseJsonOutput(next).move);
+    EXPECT_EQ(white.getGameState().getMoveHistory().size(), 4u);
+}
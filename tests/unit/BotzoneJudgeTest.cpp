@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include "ai/BotzoneAI.hpp"
+#include "ai/BotzoneJudge.hpp"
+#include "ai/BotzoneProtocol.hpp"
+#include "core/GameState.hpp"
+#include "TestHelpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+using namespace amazons;
+using namespace amazons::test;
+
+TEST(BotzoneJudgeTest, SimpleInputStartsBlackWithPlaceholder) {
+    EXPECT_EQ(BotzoneProtocol::simpleInput({}), "1\n-1 -1 -1 -1 -1 -1\n");
+
+    GameState state;
+    Move first = state.getLegalMoves().front();
+    EXPECT_EQ(BotzoneProtocol::simpleInput({first}), "1\n" + BotzoneProtocol::formatMove(first) + "\n");
+    state.makeMove(first);
+    Move second = state.getLegalMoves().front();
+    EXPECT_EQ(BotzoneProtocol::simpleInput({first, second}),
+              "2\n-1 -1 -1 -1 -1 -1\n" + BotzoneProtocol::formatMove(first) + "\n" +
+              BotzoneProtocol::formatMove(second) + "\n");
+}
+
+TEST(BotzoneJudgeTest, JsonRoundTripsMovesAndData) {
+    Move move(Position(0, 2), Position(3, 5), Position(6, 2));
+    EXPECT_EQ(BotzoneProtocol::jsonMove(move), R"({"x0":2,"y0":0,"x1":5,"y1":3,"x2":2,"y2":6})");
+    EXPECT_EQ(BotzoneProtocol::parseJsonMove(BotzoneProtocol::jsonMove(move)), move);
+    EXPECT_FALSE(BotzoneProtocol::parseJsonMove(BotzoneProtocol::jsonMove(std::nullopt)));
+
+    std::string input = BotzoneProtocol::jsonInput({move}, R"({"seen":[1,2]})", "\"x\"");
+    BotzoneProtocol::JsonInput parsed = BotzoneProtocol::parseJsonInput(input);
+    ASSERT_EQ(parsed.requests.size(), 1u);
+    EXPECT_EQ(parsed.requests[0], move);
+    EXPECT_TRUE(parsed.responses.empty());
+    EXPECT_EQ(*BotzoneProtocol::jsonField(input, "data"), R"({"seen":[1,2]})");
+    EXPECT_EQ(*BotzoneProtocol::jsonField(input, "globaldata"), "\"x\"");
+
+    BotzoneProtocol::JsonOutput output = BotzoneProtocol::parseJsonOutput(
+        R"({"response": {"x0":2,"y0":0,"x1":5,"y1":3,"x2":2,"y2":6}, "data": [3, "a}"]})");
+    EXPECT_EQ(output.move, move);
+    EXPECT_EQ(output.data, R"([3, "a}"])");
+    EXPECT_TRUE(output.globalData.empty());
+    EXPECT_THROW(BotzoneProtocol::parseJsonOutput(R"({"response": {"x0":2)"), std::invalid_argument);
+}
+
+#if !defined(_WIN32) && defined(AMAZONS_BOT_PATH)
+namespace {
+    // Executable shell script in the working directory, removed afterwards
+    struct Script {
+        std::string path;
+        Script(const std::string& name, const std::string& body) : path("./" + name) {
+            std::ofstream(path) << "#!/bin/sh\n" << body << "\n";
+            ::chmod(path.c_str(), 0755);
+        }
+        ~Script() { std::remove(path.c_str()); }
+    };
+
+    const std::string QUICK_BOT = std::string("exec ") + AMAZONS_BOT_PATH + " --time 0.02 --margin 0 --seed $$";
+}
+
+TEST(BotzoneJudgeTest, PlaysJsonKeepRunningAgainstSimpleRestartingBot) {
+    Script keepRunning("judge_keep.sh", QUICK_BOT);
+    Script oneShot("judge_oneshot.sh", QUICK_BOT + " --no-keep-running");
+    const std::string transcriptPath = "judge_transcript_test.txt";
+
+    BotzoneJudge::Options options;
+    options.black = {keepRunning.path, BotzoneJudge::Protocol::JSON};
+    options.white = {oneShot.path, BotzoneJudge::Protocol::SIMPLE};
+    options.turnSeconds = 2.0;
+    options.transcriptPath = transcriptPath;
+    BotzoneJudge::Result result = BotzoneJudge::play(options);
+
+    EXPECT_EQ(result.reason, BotServer::EndReason::NO_MOVES);
+    // The loser is not asked when it has no move left
+    ASSERT_EQ(result.turns.size(), result.moves.size());
+    // The JSON bot is started once, the other one every turn
+    for (size_t i = 0; i < result.moves.size(); ++i) {
+        const BotzoneJudge::TurnRecord& turn = result.turns[i];
+        EXPECT_EQ(turn.restarted, turn.player == Player::WHITE || i == 0) << "turn " << i;
+        EXPECT_EQ(turn.output[0] == '{', turn.player == Player::BLACK);
+    }
+    GameState replay;
+    for (const Move& move : result.moves) {
+        replay.makeMove(move);
+    }
+    EXPECT_TRUE(replay.isGameOver());
+    EXPECT_EQ(replay.getWinner(), result.winner);
+
+    std::ifstream transcript(transcriptPath);
+    std::stringstream text;
+    text << transcript.rdbuf();
+    EXPECT_NE(text.str().find("> {\"requests\":[{\"x0\":-1"), std::string::npos);
+    EXPECT_NE(text.str().find(BotServer::reasonName(result.reason)), std::string::npos);
+    std::remove(transcriptPath.c_str());
+}
+
+TEST(BotzoneJudgeTest, LateAndIllegalMovesLose) {
+    Script quick("judge_quick.sh", QUICK_BOT);
+    Script silent("judge_silent.sh", "sleep 10");
+    Script cheat("judge_cheat.sh", "read n; read line; echo 0 0 0 0 0 0");
+
+    BotzoneJudge::Options options;
+    options.black = {silent.path, BotzoneJudge::Protocol::SIMPLE};
+    options.white = {quick.path, BotzoneJudge::Protocol::SIMPLE};
+    options.turnSeconds = 0.2;
+    options.startupSeconds = 0.0;
+    BotzoneJudge::Result result = BotzoneJudge::play(options);
+    EXPECT_EQ(result.reason, BotServer::EndReason::TIMEOUT);
+    EXPECT_EQ(result.winner, Player::WHITE);
+    EXPECT_TRUE(result.moves.empty());
+
+    options.black = {cheat.path, BotzoneJudge::Protocol::SIMPLE};
+    options.turnSeconds = 2.0;
+    result = BotzoneJudge::play(options);
+    EXPECT_EQ(result.reason, BotServer::EndReason::ILLEGAL_MOVE);
+    EXPECT_EQ(result.winner, Player::WHITE);
+    EXPECT_EQ(result.turns[0].output, "0 0 0 0 0 0");
+}
+
+TEST(BotzoneJudgeTest, BotzoneAIRestartsTheBotForANewGame) {
+    TempFile starts("botzone_ai_starts.txt");
+    Script bot("botzone_ai_bot.sh", "echo start >> " + starts.path + "\n" + QUICK_BOT);
+    BotzoneAI ai(bot.path);
+    auto startCount = [&] {
+        std::ifstream file(starts.path);
+        int count = 0;
+        for (std::string line; std::getline(file, line);) {
+            ++count;
+        }
+        return count;
+    };
+
+    // One process carries a game from move to move
+    GameState game;
+    for (int turn = 0; turn < 3; ++turn) {
+        Move move = ai.getBestMove(game);
+        ASSERT_TRUE(game.isValidMove(move)) << turn;
+        game.makeMove(move);
+        game.makeMove(game.getLegalMoves().back());
+    }
+    EXPECT_EQ(startCount(), 1);
+
+    // A new game is not one move on from what the bot saw, so it is replayed to a new process
+    GameState fresh = randomGame(3, 1);
+    Move move = ai.getBestMove(fresh);
+    EXPECT_TRUE(fresh.isValidMove(move));
+    EXPECT_EQ(startCount(), 2);
+
+    // Nor is a game taken back
+    Move again = ai.getBestMove(prefix(game, 2));
+    EXPECT_TRUE(prefix(game, 2).isValidMove(again));
+    EXPECT_EQ(startCount(), 3);
+}
+#endif
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <algorithm>
+#include <vector>
+
+using namespace amazons;
+
+namespace {
+    // Plays a fixed sequence of moves so positions further into the game are covered
+    GameState playedGame(int plies) {
+        GameState state;
+        for (int i = 0; i < plies && !state.isGameOver(); ++i) {
+            auto moves = state.getLegalMoves();
+            state.makeMove(moves[(i * 37 + 11) % moves.size()]);
+        }
+        return state;
+    }
+
+    std::vector<uint32_t> sortedCodes(const FastBoard& board) {
+        std::vector<PackedMove> buffer(FastBoard::MAX_MOVES);
+        int count = board.generateMoves(buffer.data());
+        std::vector<uint32_t> codes;
+        for (int i = 0; i < count; ++i) {
+            codes.push_back(buffer[i].code());
+        }
+        std::sort(codes.begin(), codes.end());
+        return codes;
+    }
+}
+
+TEST(FastBoardTest, StandardPositionMatchesBoard) {
+    FastBoard board = FastBoard::standardPosition();
+    Board reference;
+    reference.initializeStandardPosition();
+
+    EXPECT_EQ(board.toBoard(), reference);
+    EXPECT_EQ(board.sideToMove(), Player::BLACK);
+    EXPECT_EQ(popCount(board.amazons(Player::WHITE)), 4);
+    EXPECT_EQ(popCount(board.amazons(Player::BLACK)), 4);
+    EXPECT_EQ(board.arrows(), 0u);
+}
+
+TEST(FastBoardTest, PackedMoveRoundTrip) {
+    Move move(Position(0, 2), Position(3, 5), Position(0, 2));
+    PackedMove packed = PackedMove::fromMove(move);
+
+    EXPECT_EQ(packed.toMove(), move);
+    EXPECT_EQ(PackedMove::fromCode(packed.code()), packed);
+}
+
+TEST(FastBoardTest, MoveGenerationMatchesGameState) {
+    for (int plies : {0, 1, 6, 15, 25}) {
+        GameState state = playedGame(plies);
+        FastBoard board = FastBoard::fromGameState(state);
+
+        std::vector<uint32_t> expected;
+        for (const auto& move : state.getLegalMoves()) {
+            expected.push_back(PackedMove::fromMove(move).code());
+        }
+        std::sort(expected.begin(), expected.end());
+
+        EXPECT_EQ(sortedCodes(board), expected) << "after " << plies << " plies";
+        EXPECT_EQ(board.countMoves(), static_cast<int>(expected.size()));
+        EXPECT_EQ(board.hasMoves(), !expected.empty());
+    }
+}
+
+TEST(FastBoardTest, IsLegalAgreesWithGameState) {
+    GameState state = playedGame(4);
+    FastBoard board = FastBoard::fromGameState(state);
+
+    for (const auto& move : state.getLegalMoves()) {
+        EXPECT_TRUE(board.isLegal(PackedMove::fromMove(move)));
+    }
+    // Arrow blocked by the amazon's own destination square
+    EXPECT_FALSE(board.isLegal(PackedMove(0, 0, 0)));
+}
+
+TEST(FastBoardTest, MakeUnmakeRestoresPositionAndHash) {
+    FastBoard board = FastBoard::fromGameState(playedGame(3));
+    FastBoard original = board;
+    std::vector<PackedMove> buffer(FastBoard::MAX_MOVES);
+    int count = board.generateMoves(buffer.data());
+    ASSERT_GT(count, 0);
+
+    for (int i = 0; i < count; i += 17) {
+        board.makeMove(buffer[i]);
+        // Incremental hash must equal a hash computed from scratch
+        FastBoard rebuilt = FastBoard::fromBoard(board.toBoard(), board.sideToMove());
+        EXPECT_EQ(board.hash(), rebuilt.hash());
+        board.unmakeMove(buffer[i]);
+        EXPECT_EQ(board, original);
+        EXPECT_EQ(board.hash(), original.hash());
+    }
+}
+
+TEST(FastBoardTest, RandomMoveIsLegal) {
+    FastBoard board = FastBoard::standardPosition();
+    FastRandom rng(42);
+    PackedMove move;
+    int plies = 0;
+    while (board.randomMove(rng, move)) {
+        ASSERT_TRUE(board.isLegal(move));
+        board.makeMove(move);
+        ++plies;
+    }
+    // Every ply places an arrow, so a game cannot outlast the empty squares
+    EXPECT_LE(plies, FastBoard::SQUARES - 8);
+    EXPECT_FALSE(board.hasMoves());
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include "utils/GameArchive.hpp"
+#include "utils/GameRecord.hpp"
+#include "core/FastBoard.hpp"
+#include "core/PositionNotation.hpp"
+#include "TestHelpers.hpp"
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    GameMode modeOf(uint64_t seed) {
+        return static_cast<GameMode>(seed % 4);
+    }
+}
+
+TEST(GameArchiveTest, RoundTripsGamesInBlocks) {
+    TempFile temp("game_archive_test.amza");
+    const int games = 300;
+    size_t recordBytes = 0;
+    {
+        GameArchive::Writer writer(temp.path, 64);
+        for (int seed = 0; seed < games; ++seed) {
+            GameState game = randomGame(seed + 1, seed % 7 == 0 ? seed % 20 : INT_MAX);
+            recordBytes += GameRecord::encode(game, modeOf(seed)).size();
+            EXPECT_EQ(writer.add(game, modeOf(seed)), static_cast<uint64_t>(seed));
+        }
+        writer.close();
+        // Legal-move ranks take well under half the bits of raw move codes
+        EXPECT_LT(writer.bytesWritten() * 2, recordBytes);
+    }
+
+    GameArchive archive(temp.path);
+    EXPECT_EQ(archive.gameCount(), static_cast<uint64_t>(games));
+    EXPECT_EQ(archive.blockCount(), 5u);
+    EXPECT_EQ(archive.gamesPerBlock(), 64u);
+    for (int seed : {0, 1, 63, 64, 200, 7, 299}) {
+        auto [game, mode] = archive.game(seed);
+        const GameState expected = randomGame(seed + 1, seed % 7 == 0 ? seed % 20 : INT_MAX);
+        EXPECT_EQ(mode, modeOf(seed));
+        EXPECT_EQ(*game, expected) << seed;
+        EXPECT_EQ(game->getMoveHistory(), expected.getMoveHistory()) << seed;
+    }
+    EXPECT_EQ(archive.block(4).size(), 300u - 4 * 64);
+    EXPECT_THROW(archive.game(games), std::out_of_range);
+    EXPECT_THROW(archive.block(5), std::out_of_range);
+
+    // The binary save path reads the same game back
+    auto viaRecord = GameRecord::decode(archive.record(12));
+    EXPECT_EQ(*viaRecord.first, randomGame(13));
+}
+
+TEST(GameArchiveTest, KeepsCustomStartsAndRecords) {
+    TempFile temp("game_archive_custom_test.amza");
+    GameState custom = PositionNotation::parseGameState("2B2W2/8/B6W/2XXXX2/8/B6W/8/2B2W2 w 17");
+    FastRandom rng(5);
+    PackedMove move;
+    for (int ply = 0; ply < 12 && FastBoard::fromGameState(custom).randomMove(rng, move); ++ply) {
+        custom.makeMove(move.toMove());
+    }
+    const std::string record = GameRecord::encode(randomGame(77), GameMode::HUMAN_VS_HUMAN);
+    {
+        GameArchive::Writer writer(temp.path);
+        writer.add(custom, GameMode::HUMAN_VS_AI_HUMAN_WHITE);
+        writer.addRecord(record.data(), record.size());
+        writer.add(GameState(), GameMode::HUMAN_VS_HUMAN);
+        EXPECT_THROW(writer.addRecord("AMZ", 3), std::invalid_argument);
+    }
+
+    GameArchive archive(temp.path);
+    ASSERT_EQ(archive.gameCount(), 3u);
+    auto [game, mode] = archive.game(0);
+    EXPECT_EQ(mode, GameMode::HUMAN_VS_AI_HUMAN_WHITE);
+    EXPECT_EQ(*game, custom);
+    while (game->canUndo()) {
+        game->undoLastMove();
+    }
+    EXPECT_EQ(PositionNotation::format(*game), "2B2W2/8/B6W/2XXXX2/8/B6W/8/2B2W2 w 17");
+    EXPECT_EQ(archive.record(1), record);
+    EXPECT_EQ(*archive.game(2).first, GameState());
+}
+
+TEST(GameArchiveTest, DecodesOnManyThreads) {
+    TempFile temp("game_archive_threads_test.amza");
+    const int games = 100;
+    {
+        GameArchive::Writer writer(temp.path, 8);
+        for (int seed = 0; seed < games; ++seed) {
+            writer.add(randomGame(seed + 100), modeOf(seed));
+        }
+    }
+
+    GameArchive archive(temp.path);
+    std::vector<std::atomic<int>> seen(games);
+    std::atomic<int> wrong{0};
+    archive.forEach(4, [&](uint64_t id, const GameState& game, GameMode mode) {
+        seen[id]++;
+        if (!(game == randomGame(id + 100)) || mode != modeOf(id)) {
+            wrong++;
+        }
+    });
+    EXPECT_EQ(wrong, 0);
+    for (int id = 0; id < games; ++id) {
+        EXPECT_EQ(seen[id], 1) << id;
+    }
+
+    // Single games read on several threads share the cached block
+    std::vector<std::thread> readers;
+    for (int reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&, reader] {
+            for (int i = 0; i < 50; ++i) {
+                const uint64_t id = (i * 7 + reader * 13) % games;
+                if (!(*archive.game(id).first == randomGame(id + 100))) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    EXPECT_EQ(wrong, 0);
+
+    EXPECT_THROW(archive.forEach(3, [](uint64_t id, const GameState&, GameMode) {
+        if (id == 50) {
+            throw std::runtime_error("stop");
+        }
+    }), std::runtime_error);
+}
+
+TEST(GameArchiveTest, RecoversBlocksOfAnUnclosedArchive) {
+    TempFile temp("game_archive_torn_test.amza");
+    uint64_t twoBlocks = 0;
+    {
+        GameArchive::Writer writer(temp.path, 10);
+        for (int seed = 0; seed < 25; ++seed) {
+            writer.add(randomGame(seed + 200));
+            if (writer.gameCount() == 20) {
+                twoBlocks = writer.bytesWritten();
+            }
+        }
+    }
+    // The writer died part way through the third block
+    std::filesystem::resize_file(temp.path, twoBlocks + 20);
+
+    GameArchive archive(temp.path);
+    EXPECT_EQ(archive.gameCount(), 20u);
+    EXPECT_EQ(archive.blockCount(), 2u);
+    EXPECT_EQ(*archive.game(19).first, randomGame(219));
+}
+
+TEST(GameArchiveTest, DamageStaysInItsBlock) {
+    TempFile temp("game_archive_damage_test.amza");
+    {
+        GameArchive::Writer writer(temp.path, 4);
+        for (int seed = 0; seed < 12; ++seed) {
+            writer.add(randomGame(seed + 300));
+        }
+    }
+    {
+        // A byte inside the first block's payload
+        std::fstream file(temp.path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(40);
+        file.put('\x5A');
+    }
+    GameArchive archive(temp.path);
+    EXPECT_EQ(archive.gameCount(), 12u);
+    EXPECT_THROW(archive.game(1), std::runtime_error);
+    EXPECT_EQ(*archive.game(4).first, randomGame(304));
+}
+
+TEST(GameArchiveTest, RejectsOtherFiles) {
+    EXPECT_THROW(GameArchive("game_archive_missing.amza"), std::runtime_error);
+    TempFile temp("game_archive_foreign_test.amza");
+    {
+        std::ofstream file(temp.path, std::ios::binary);
+        file << "AMZGDB01 not an archive";
+    }
+    EXPECT_THROW(GameArchive{temp.path}, std::runtime_error);
+}
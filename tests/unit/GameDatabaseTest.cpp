@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include "utils/GameDatabase.hpp"
+#include "core/FastBoard.hpp"
+#include "core/Symmetry.hpp"
+#include "TestHelpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace amazons;
+using namespace amazons::test;
+
+TEST(GameDatabaseTest, FindsEveryGameThatReachedAPosition) {
+    TempFile temp("gamedb_find_test.amzdb");
+    TempFile tempIndex(temp.path + ".idx");
+    GameDatabase database(temp.path);
+    std::vector<GameState> games;
+    for (uint64_t seed = 1; seed <= 10; ++seed) {
+        games.push_back(randomGame(seed));
+        EXPECT_EQ(database.append(games.back(), GameMode::AI_VS_AI), seed - 1);
+    }
+    // Game 10 repeats the opening of game 3 and then stops
+    GameState shared = prefix(games[3], 5);
+    database.append(shared);
+
+    EXPECT_EQ(database.find(GameState()).size(), 11u);
+    std::vector<GameDatabase::Occurrence> expected = {{3, 5}, {10, 5}};
+    EXPECT_EQ(database.find(shared), expected);
+
+    auto loaded = database.game(7);
+    EXPECT_EQ(loaded.second, GameMode::AI_VS_AI);
+    EXPECT_EQ(loaded.first->getMoveHistory(), games[7].getMoveHistory());
+    EXPECT_THROW(database.game(11), std::out_of_range);
+}
+
+TEST(GameDatabaseTest, FindsMirroredGames) {
+    TempFile temp("gamedb_mirror_test.amzdb");
+    TempFile tempIndex(temp.path + ".idx");
+    GameDatabase database(temp.path);
+    // The start is its own top-bottom mirror, so any game can be played upside down
+    const GameState original = randomGame(41);
+    GameState mirrored;
+    for (const Move& move : original.getMoveHistory()) {
+        mirrored.makeMove(Symmetry::transform(PackedMove::fromMove(move), 2).toMove());
+    }
+    database.append(original);
+    database.append(mirrored);
+
+    std::vector<GameDatabase::Occurrence> expected = {{0, 6}, {1, 6}};
+    EXPECT_EQ(database.find(prefix(original, 6)), expected);
+    EXPECT_EQ(database.find(prefix(mirrored, 6)), expected);
+    EXPECT_EQ(GameDatabase::positionKey(FastBoard::fromGameState(prefix(original, 6))),
+              GameDatabase::positionKey(FastBoard::fromGameState(prefix(mirrored, 6))));
+}
+
+TEST(GameDatabaseTest, IndexSurvivesReopenAndCatchesUp) {
+    TempFile temp("gamedb_reopen_test.amzdb");
+    TempFile tempIndex(temp.path + ".idx");
+    GameState first = randomGame(21);
+    GameState second = randomGame(22);
+    GameState midgame = prefix(second, 8);
+    {
+        GameDatabase database(temp.path);
+        database.append(first);
+        database.flush();
+        database.append(second);
+    }
+    {
+        GameDatabase database(temp.path);
+        EXPECT_EQ(database.gameCount(), 2u);
+        std::vector<GameDatabase::Occurrence> expected = {{1, 8}};
+        EXPECT_EQ(database.find(midgame), expected);
+    }
+
+    // Without its index the database rebuilds one from the games
+    std::remove((temp.path + ".idx").c_str());
+    GameDatabase database(temp.path);
+    EXPECT_EQ(database.find(GameState()).size(), 2u);
+    EXPECT_EQ(database.find(midgame).size(), 1u);
+}
+
+TEST(GameDatabaseTest, DropsGameCutShortMidAppend) {
+    TempFile temp("gamedb_torn_test.amzdb");
+    TempFile tempIndex(temp.path + ".idx");
+    {
+        GameDatabase database(temp.path);
+        database.append(randomGame(31));
+        database.append(randomGame(32));
+    }
+    // A crash halfway through the length prefix and record of a third game
+    std::ofstream(temp.path, std::ios::binary | std::ios::app).write("\x60\x00" "AMZ", 5);
+
+    GameDatabase database(temp.path);
+    EXPECT_EQ(database.gameCount(), 2u);
+    EXPECT_EQ(database.append(randomGame(33)), 2u);
+    EXPECT_EQ(database.game(2).first->getMoveHistory(), randomGame(33).getMoveHistory());
+    EXPECT_EQ(database.find(GameState()).size(), 3u);
+}
+
+TEST(GameDatabaseTest, RejectsForeignFiles) {
+    TempFile temp("gamedb_foreign_test.amzdb");
+    TempFile tempIndex(temp.path + ".idx");
+    std::ofstream(temp.path) << "{\"board\": \"\"}";
+    EXPECT_THROW(GameDatabase database(temp.path), std::runtime_error);
+}
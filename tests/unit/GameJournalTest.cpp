@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "utils/GameJournal.hpp"
+#include "core/FastBoard.hpp"
+#include "TestHelpers.hpp"
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    // One random legal move on state; false if there is none
+    bool playRandom(GameState& state, FastRandom& rng) {
+        FastBoard board = FastBoard::fromGameState(state);
+        PackedMove move;
+        if (!board.randomMove(rng, move)) {
+            return false;
+        }
+        state.makeMove(move.toMove());
+        return true;
+    }
+}
+
+TEST(GameJournalTest, RecoversMovesAndUndosAcrossCompactions) {
+    TempFile file("journal_test_game.amzj");
+    GameJournal::Options options;
+    options.compactEvery = 7;
+    GameState state;
+    FastRandom rng(5);
+    {
+        GameJournal journal(file.path, state, GameMode::HUMAN_VS_AI_HUMAN_WHITE, options);
+        state.setListener(&journal);
+        for (int ply = 0; ply < 40 && playRandom(state, rng); ++ply) {
+            if (ply % 5 == 4) {
+                state.undoLastMove();
+            }
+        }
+        EXPECT_LT(journal.recordsSinceSnapshot(), options.compactEvery);
+        state.setListener(nullptr);
+    }
+
+    auto [recovered, mode] = GameJournal::recover(file.path);
+    ASSERT_TRUE(recovered);
+    EXPECT_EQ(mode, GameMode::HUMAN_VS_AI_HUMAN_WHITE);
+    EXPECT_EQ(*recovered, state);
+    EXPECT_EQ(recovered->getMoveHistory(), state.getMoveHistory());
+}
+
+TEST(GameJournalTest, TornTailEndsReplay) {
+    TempFile file("journal_test_torn.amzj");
+    GameState state;
+    GameState beforeLast;
+    FastRandom rng(6);
+    {
+        GameJournal journal(file.path, state, GameMode::HUMAN_VS_HUMAN);
+        state.setListener(&journal);
+        for (int ply = 0; ply < 6; ++ply) {
+            beforeLast = state;
+            ASSERT_TRUE(playRandom(state, rng));
+        }
+        state.setListener(nullptr);
+    }
+    // Crash halfway through the next record
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::app);
+        out.write("\x01\x02\x03", 3);
+    }
+    EXPECT_EQ(*GameJournal::recover(file.path).first, state);
+
+    // Power cut: the last whole record reached the disk as garbage
+    std::filesystem::resize_file(file.path, std::filesystem::file_size(file.path) - 3 - 1);
+    {
+        std::ofstream out(file.path, std::ios::binary | std::ios::app);
+        out.put('\x7f');
+    }
+    auto recovered = GameJournal::recover(file.path).first;
+    ASSERT_TRUE(recovered);
+    EXPECT_EQ(*recovered, beforeLast);
+}
+
+TEST(GameJournalTest, CopiesDoNotInheritTheListener) {
+    TempFile file("journal_test_copy.amzj");
+    GameState state;
+    GameJournal journal(file.path, state, GameMode::HUMAN_VS_HUMAN);
+    state.setListener(&journal);
+
+    FastRandom rng(7);
+    GameState copy = state;
+    ASSERT_TRUE(playRandom(copy, rng));
+    EXPECT_EQ(journal.recordsSinceSnapshot(), 0u);
+
+    ASSERT_TRUE(playRandom(state, rng));
+    EXPECT_EQ(journal.recordsSinceSnapshot(), 1u);
+    state.setListener(nullptr);
+}
+
+TEST(GameJournalTest, MissingAndForeignFiles) {
+    TempFile file("journal_test_foreign.amzj");
+    EXPECT_FALSE(GameJournal::exists(file.path));
+    EXPECT_FALSE(GameJournal::recover(file.path).first);
+
+    {
+        std::ofstream out(file.path, std::ios::binary);
+        out << "{\"board\": \"not a journal\"}";
+    }
+    EXPECT_TRUE(GameJournal::exists(file.path));
+    EXPECT_THROW(GameJournal::recover(file.path), std::invalid_argument);
+
+    GameJournal journal(file.path, GameState(), GameMode::AI_VS_AI);
+    journal.discard();
+    EXPECT_FALSE(GameJournal::exists(file.path));
+}
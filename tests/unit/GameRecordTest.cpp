@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "utils/GameRecord.hpp"
+#include "TestHelpers.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+TEST(GameRecordTest, RoundTripsWholeGameAndUndo) {
+    GameState original = randomGame(7, 1000);
+    std::string bytes = GameRecord::encode(original, GameMode::AI_VS_AI);
+    size_t plies = original.getMoveHistory().size();
+    EXPECT_EQ(bytes.size(), GameRecord::HEADER_SIZE + (plies * 18 + 7) / 8 + 4);
+
+    auto [loaded, mode] = GameRecord::decode(bytes);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(mode, GameMode::AI_VS_AI);
+    EXPECT_EQ(*loaded, original);
+    EXPECT_EQ(loaded->getMoveHistory(), original.getMoveHistory());
+
+    // The history came back, so undo walks all the way to the start
+    while (loaded->canUndo()) {
+        loaded->undoLastMove();
+    }
+    EXPECT_EQ(*loaded, GameState());
+}
+
+TEST(GameRecordTest, PlayedOutGamesFitInUnder200Bytes) {
+    for (uint64_t seed = 1; seed <= 20; ++seed) {
+        GameState state = randomGame(seed, 1000);
+        ASSERT_TRUE(state.isGameOver());
+        EXPECT_LT(GameRecord::encode(state, GameMode::HUMAN_VS_HUMAN).size(), 200u) << "seed " << seed;
+    }
+}
+
+TEST(GameRecordTest, KeepsCustomStartOfPositionOnlySaves) {
+    // What a JSON save restores: a position without the moves that led to it
+    GameState played = randomGame(11, 9);
+    GameState position(played.getBoard(), played.getCurrentPlayer(), played.getTurnNumber());
+    GameState continued = position;
+    continued.makeMove(continued.getLegalMoves().front());
+
+    auto loaded = GameRecord::decode(GameRecord::encode(continued, GameMode::HUMAN_VS_AI_HUMAN_WHITE)).first;
+    EXPECT_EQ(*loaded, continued);
+    loaded->undoLastMove();
+    EXPECT_EQ(*loaded, position);
+    EXPECT_FALSE(loaded->canUndo());
+}
+
+TEST(GameRecordTest, RejectsCorruptRecords) {
+    std::string bytes = GameRecord::encode(randomGame(5, 20), GameMode::HUMAN_VS_HUMAN);
+
+    std::string flipped = bytes;
+    flipped[GameRecord::HEADER_SIZE + 3] ^= 0x10;
+    EXPECT_THROW(GameRecord::decode(flipped), std::invalid_argument);
+    EXPECT_THROW(GameRecord::decode(bytes.substr(0, bytes.size() - 1)), std::invalid_argument);
+    EXPECT_THROW(GameRecord::decode(std::string("{\"board\": \"\"}")), std::invalid_argument);
+
+    // A checksum cannot vouch for moves that were wrong when written
+    std::string illegal = bytes;
+    illegal[GameRecord::HEADER_SIZE] ^= 0x01;
+    illegal.resize(illegal.size() - 4);
+    uint32_t crc = GameRecord::crc32(illegal.data(), illegal.size());
+    for (int i = 0; i < 4; ++i) {
+        illegal += static_cast<char>((crc >> (8 * i)) & 0xFF);
+    }
+    EXPECT_THROW(GameRecord::decode(illegal), std::invalid_argument);
+}
+
+TEST(GameRecordTest, CrcMatchesStandardCheckValue) {
+    EXPECT_EQ(GameRecord::crc32("123456789", 9), 0xCBF43926u);
+}
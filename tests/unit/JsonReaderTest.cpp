@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "utils/JsonReader.hpp"
+#include "utils/Serializer.hpp"
+#include "TestHelpers.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+TEST(JsonReaderTest, WalksNestedDocument) {
+    JsonReader reader(R"( {"a": -12, "skip": {"x": [1, 2.5e3, "s\"q", null, true]}, "b": "hi", "c": false} )");
+    reader.beginObject();
+    std::string_view key;
+
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "a");
+    EXPECT_EQ(reader.readInteger(), -12);
+
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "skip");
+    reader.skipValue();
+
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "b");
+    EXPECT_EQ(reader.readString(), "hi");
+
+    ASSERT_TRUE(reader.nextMember(key));
+    EXPECT_EQ(key, "c");
+    EXPECT_FALSE(reader.readBool());
+
+    EXPECT_FALSE(reader.nextMember(key));
+    EXPECT_NO_THROW(reader.expectEnd());
+}
+
+TEST(JsonReaderTest, ReadsArrays) {
+    JsonReader reader("[3, 4, 5]");
+    reader.beginArray();
+    int64_t sum = 0;
+    while (reader.nextElement()) {
+        sum += reader.readInteger();
+    }
+    EXPECT_EQ(sum, 12);
+    reader.expectEnd();
+}
+
+TEST(JsonReaderTest, RejectsMalformedInput) {
+    for (const char* text : {"{\"a\" 1}", "{\"a\": 1", "{\"a\": 1,}", "{\"a\": \"open}", "{\"a\": 1.5}",
+                             "{\"a\": 99999999999999999999}", "{\"a\": 1} x", "{\"a\": tru}"}) {
+        JsonReader reader(text);
+        EXPECT_THROW({
+            reader.beginObject();
+            std::string_view key;
+            while (reader.nextMember(key)) {
+                reader.readInteger();
+            }
+            reader.expectEnd();
+        }, std::invalid_argument) << text;
+    }
+
+    std::string deep(100, '[');
+    JsonReader reader(deep);
+    EXPECT_THROW(reader.skipValue(), std::invalid_argument);
+}
+
+TEST(JsonReaderTest, SerializerRoundTripsThroughReader) {
+    const GameState state = randomGame(3, 5);
+    Serializer serializer;
+    std::string json = serializer.serializeGameState(state, GameMode::AI_VS_AI);
+
+    auto [loaded, mode] = serializer.deserializeGameStateWithMode(json);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(*loaded, state);
+    EXPECT_EQ(mode, GameMode::AI_VS_AI);
+}
+
+TEST(JsonReaderTest, SerializerAcceptsAnyMemberOrder) {
+    std::string board = "...B..B.........................................................";
+    board.replace(59, 1, "W");
+    std::string json = "{\"turn_number\": 4, \"note\": [1, {\"k\": \"v\"}], \"game_mode\": \"human_vs_ai\","
+                       " \"current_player\": \"white\", \"board\": \"" + board + "\"}";
+
+    auto [loaded, mode] = Serializer().deserializeGameStateWithMode(json);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->getCurrentPlayer(), Player::WHITE);
+    EXPECT_EQ(loaded->getTurnNumber(), 4);
+    EXPECT_EQ(loaded->getBoard().getCell(7, 3), Board::Cell::WHITE_AMAZON);
+    EXPECT_EQ(mode, GameMode::HUMAN_VS_AI_HUMAN_BLACK);
+
+    // Missing fields, a short board and trailing garbage all fail cleanly
+    EXPECT_FALSE(Serializer().deserializeGameStateWithMode("{\"board\": \"" + board + "\"}").first);
+    EXPECT_FALSE(Serializer().deserializeGameStateWithMode(
+        "{\"board\": \"...\", \"current_player\": \"black\", \"turn_number\": 1}").first);
+    EXPECT_FALSE(Serializer().deserializeGameStateWithMode(json + "}").first);
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "ai/Engine.hpp"
+#include "ai/Match.hpp"
+#include <cmath>
+
+using namespace amazons;
+
+TEST(MatchTest, EloFromScore) {
+    EXPECT_DOUBLE_EQ(Match::eloFromScore(0.5), 0.0);
+    EXPECT_NEAR(Match::eloFromScore(0.75), 190.85, 0.01);
+    EXPECT_NEAR(Match::eloFromScore(0.25), -190.85, 0.01);
+    EXPECT_TRUE(std::isinf(Match::eloFromScore(1.0)));
+}
+
+TEST(MatchTest, EloErrorShrinksWithGames) {
+    EXPECT_GT(Match::eloError(30, 30), Match::eloError(300, 300));
+    EXPECT_TRUE(std::isinf(Match::eloError(10, 0)));
+}
+
+TEST(MatchTest, SprtLlrFollowsResults) {
+    EXPECT_GT(Match::sprtLlr(70, 30, 0.0, 10.0), 0.0);
+    EXPECT_LT(Match::sprtLlr(30, 70, 0.0, 10.0), 0.0);
+}
+
+TEST(MatchTest, CreateEngineParsesSpecs) {
+    EXPECT_EQ(createEngine("basic")->getName(), "basic");
+    EXPECT_EQ(createEngine("random:seed=3")->getName(), "random");
+    EXPECT_EQ(createEngine("mcts:playouts=10,rule=puct")->getName(), "mcts:playouts=10,rule=puct");
+    EXPECT_THROW(createEngine("alphabeta"), std::invalid_argument);
+    EXPECT_THROW(createEngine("mcts:depth=3"), std::invalid_argument);
+    EXPECT_THROW(createEngine("random:seed"), std::invalid_argument);
+}
+
+TEST(MatchTest, PlaysAllGamesConcurrently) {
+    Match::Options options;
+    options.engineA = "random";
+    options.engineB = "random";
+    options.games = 8;
+    options.concurrency = 3;
+    Match::Result result = Match::run(options);
+
+    EXPECT_EQ(result.games, 8);
+    EXPECT_EQ(result.winsA + result.winsB, 8);
+    EXPECT_EQ(result.illegalMoves, 0);
+}
+
+TEST(MatchTest, SprtStopsEarlyOnClearResult) {
+    // A searching engine beats random play every time, so H1 is accepted long before 200 games
+    Match::Options options;
+    options.engineA = "mcts:time=0,playouts=50,seed=1";
+    options.engineB = "random:seed=5";
+    options.games = 200;
+    options.concurrency = 2;
+    options.sprt = true;
+    options.elo0 = 0;
+    options.elo1 = 200;
+    Match::Result result = Match::run(options);
+
+    EXPECT_EQ(result.sprtOutcome, Match::SprtOutcome::ACCEPT_H1);
+    EXPECT_LT(result.games, 200);
+}
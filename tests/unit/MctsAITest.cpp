@@ -0,0 +1,242 @@
+#include <gtest/gtest.h>
+#include "ai/MctsAI.hpp"
+#include "core/GameState.hpp"
+#include <chrono>
+#include <thread>
+
+using namespace amazons;
+
+namespace {
+    MctsAI::Config quickConfig() {
+        MctsAI::Config config;
+        config.timeLimitSeconds = 0;
+        config.maxPlayouts = 300;
+        config.arenaNodes = 4096;
+        config.seed = 7;
+        return config;
+    }
+
+    // Black must seal White's last two squares (1,0) and (1,1); any other reply loses
+    GameState sealingPosition() {
+        Board board;
+        for (int r = 0; r < Board::SIZE; ++r) {
+            for (int c = 0; c < Board::SIZE; ++c) {
+                board.setCell(r, c, Board::Cell::ARROW);
+            }
+        }
+        board.setCell(0, 0, Board::Cell::WHITE_AMAZON);
+        board.setCell(1, 0, Board::Cell::EMPTY);
+        board.setCell(1, 1, Board::Cell::EMPTY);
+        board.setCell(2, 0, Board::Cell::BLACK_AMAZON);
+        return GameState(board, Player::BLACK, 10);
+    }
+}
+
+TEST(MctsAITest, ReturnsLegalMove) {
+    GameState state;
+    MctsAI ai(quickConfig());
+
+    Move move = ai.getBestMove(state);
+    EXPECT_TRUE(state.isValidMove(move));
+    EXPECT_EQ(ai.getLastStats().playouts, 300u);
+    EXPECT_GT(ai.getLastStats().nodes, 1u);
+}
+
+TEST(MctsAITest, PuctReturnsLegalMove) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.rule = MctsAI::SelectionRule::PUCT;
+    MctsAI ai(config);
+
+    EXPECT_TRUE(state.isValidMove(ai.getBestMove(state)));
+}
+
+TEST(MctsAITest, StopsWhenArenaIsFull) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.arenaNodes = 16;
+    MctsAI ai(config);
+
+    EXPECT_TRUE(state.isValidMove(ai.getBestMove(state)));
+    EXPECT_LE(ai.getLastStats().nodes, 16u);
+
+    // A tree that fills the arena is not reused: the search would have no room
+    ai.getBestMove(state);
+    EXPECT_EQ(ai.getLastStats().reusedNodes, 0u);
+    EXPECT_GT(ai.getLastStats().playouts, 0u);
+
+    // Threads stopping part way through their chunks leave slots no node uses
+    config.arenaNodes = 600;
+    config.maxPlayouts = 0;
+    config.timeLimitSeconds = 5;
+    config.threads = 4;
+    MctsAI parallel(config);
+    EXPECT_TRUE(state.isValidMove(parallel.getBestMove(state)));
+    EXPECT_LE(parallel.getLastStats().nodes, 600u);
+    EXPECT_GT(parallel.getLastStats().nodes, 1u);
+}
+
+TEST(MctsAITest, FindsImmobilisingMove) {
+    GameState state = sealingPosition();
+
+    MctsAI ai(quickConfig());
+    Move move = ai.getBestMove(state);
+    GameState after = state;
+    after.makeMove(move);
+    EXPECT_TRUE(after.isGameOver());
+    EXPECT_EQ(after.getWinner(), Player::BLACK);
+}
+
+TEST(MctsAITest, ReusesSubtreeOfPlayedMove) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.maxPlayouts = 1000;
+    config.arenaNodes = 1 << 14;
+    MctsAI ai(config);
+
+    Move first = ai.getBestMove(state);
+    EXPECT_EQ(ai.getLastStats().reusedNodes, 0u);
+    state.makeMove(first);
+
+    // Playing both sides: the chosen move is always an expanded child of the old root
+    ai.getBestMove(state);
+    EXPECT_GT(ai.getLastStats().reusedNodes, 0u);
+    EXPECT_GT(ai.getLastStats().reusedVisits, 0u);
+
+    // Searching the same position again keeps the whole tree
+    size_t nodesBefore = ai.getLastStats().nodes;
+    ai.getBestMove(state);
+    EXPECT_EQ(ai.getLastStats().reusedNodes, nodesBefore);
+
+    ai.reset();
+    ai.getBestMove(state);
+    EXPECT_EQ(ai.getLastStats().reusedNodes, 0u);
+}
+
+TEST(MctsAITest, TreeParallelSearchSharesOneArena) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.maxPlayouts = 2000;
+    config.arenaNodes = 1 << 14;
+    config.threads = 4;
+    MctsAI ai(config);
+
+    EXPECT_TRUE(state.isValidMove(ai.getBestMove(state)));
+    EXPECT_EQ(ai.getLastStats().playouts, 2000u);
+    EXPECT_EQ(ai.getLastStats().threads, 4u);
+
+    // Tree reuse still works when the tree was grown by several threads
+    state.makeMove(ai.getBestMove(state));
+    ai.getBestMove(state);
+    EXPECT_GT(ai.getLastStats().reusedNodes, 0u);
+}
+
+TEST(MctsAITest, RootParallelSearchReturnsLegalMove) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.maxPlayouts = 2000;
+    config.arenaNodes = 1 << 14;
+    config.threads = 4;
+    config.parallelMode = MctsAI::ParallelMode::ROOT;
+    MctsAI ai(config);
+
+    EXPECT_TRUE(state.isValidMove(ai.getBestMove(state)));
+    EXPECT_EQ(ai.getLastStats().playouts, 2000u);
+}
+
+TEST(MctsAITest, ParallelSearchFindsImmobilisingMove) {
+    GameState state = sealingPosition();
+
+    MctsAI::Config config = quickConfig();
+    config.threads = 4;
+    MctsAI ai(config);
+    GameState after = state;
+    after.makeMove(ai.getBestMove(state));
+    EXPECT_TRUE(after.isGameOver());
+    EXPECT_EQ(after.getWinner(), Player::BLACK);
+}
+
+TEST(MctsAITest, PonderingGrowsTreeForNextSearch) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.arenaNodes = 1 << 14;
+    MctsAI ai(config);
+
+    ai.startPondering(state);
+    EXPECT_TRUE(ai.isPondering());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // getBestMove stops the ponder search and starts from its tree
+    EXPECT_TRUE(state.isValidMove(ai.getBestMove(state)));
+    EXPECT_FALSE(ai.isPondering());
+    EXPECT_GT(ai.getLastStats().ponderPlayouts, 0u);
+    EXPECT_GT(ai.getLastStats().reusedNodes, 0u);
+}
+
+TEST(MctsAITest, ResetStopsPondering) {
+    GameState state;
+    MctsAI ai(quickConfig());
+
+    ai.startPondering(state);
+    ai.reset();
+    EXPECT_FALSE(ai.isPondering());
+
+    ai.startPondering(state);
+    ai.stopPondering();
+    EXPECT_FALSE(ai.isPondering());
+}
+
+TEST(MctsAITest, BackgroundSearchHonoursLimits) {
+    GameState state;
+    MctsAI ai(quickConfig());
+
+    MctsAI::SearchHandle handle = ai.startSearch(state);
+    ASSERT_TRUE(handle.valid());
+    Move move = handle.result().get();
+    EXPECT_TRUE(handle.isReady());
+    EXPECT_TRUE(state.isValidMove(move));
+    EXPECT_EQ(ai.getLastStats().playouts, 300u);
+    ASSERT_TRUE(handle.bestSoFar().has_value());
+    EXPECT_EQ(handle.bestSoFar()->toString(), move.toString());
+}
+
+TEST(MctsAITest, StopEndsUnlimitedSearchWithBestSoFar) {
+    GameState state;
+    MctsAI::Config config = quickConfig();
+    config.arenaNodes = 1 << 16;
+    MctsAI ai(config);
+
+    // No time or playout limit: only stop() ends it
+    MctsAI::SearchHandle handle = ai.startSearch(state, MctsAI::SearchLimits());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(handle.isReady());
+    handle.stop();
+    EXPECT_TRUE(state.isValidMove(handle.result().get()));
+    EXPECT_GT(ai.getLastStats().playouts, 0u);
+}
+
+TEST(MctsAITest, CancelTokenEndsSearch) {
+    GameState state;
+    MctsAI ai(quickConfig());
+    StopSource cancel;
+
+    MctsAI::SearchHandle handle = ai.startSearch(state, MctsAI::SearchLimits(), cancel.getToken());
+    EXPECT_TRUE(cancel.requestStop());
+    EXPECT_FALSE(cancel.requestStop());
+    EXPECT_TRUE(state.isValidMove(handle.result().get()));
+}
+
+TEST(MctsAITest, BackgroundSearchReportsNoLegalMoves) {
+    Board board;
+    for (int r = 0; r < Board::SIZE; ++r) {
+        for (int c = 0; c < Board::SIZE; ++c) {
+            board.setCell(r, c, Board::Cell::ARROW);
+        }
+    }
+    board.setCell(0, 0, Board::Cell::WHITE_AMAZON);
+    board.setCell(7, 7, Board::Cell::BLACK_AMAZON);
+    MctsAI ai(quickConfig());
+
+    MctsAI::SearchHandle handle = ai.startSearch(GameState(board, Player::BLACK, 10));
+    EXPECT_THROW(handle.result().get(), std::runtime_error);
+}
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+#include "ai/Engine.hpp"
+#include "core/Symmetry.hpp"
+#include "utils/OpeningBook.hpp"
+#include "TestHelpers.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    // The book keeps one of a set of moves that a symmetry of the position
+    // turns into each other
+    bool sameMoveUpToSymmetry(const FastBoard& position, PackedMove a, PackedMove b) {
+        for (int symmetry = 0; symmetry < Symmetry::COUNT; ++symmetry) {
+            if (Symmetry::transform(position, symmetry) == position && Symmetry::transform(a, symmetry) == b) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+TEST(OpeningBookTest, AggregatesGamesBestFirst) {
+    TempFile temp("opening_book_test.amzb");
+    const std::string& path = temp.path;
+    OpeningBook::Builder builder(2);
+    const int games = 40;
+    for (uint64_t seed = 1; seed <= games; ++seed) {
+        EXPECT_TRUE(builder.addGame(randomGame(seed)));
+    }
+    EXPECT_FALSE(builder.addGame(GameState()));
+    // The same first move, twice more and always winning, goes to the top
+    const GameState first = randomGame(1);
+    const PackedMove favourite = PackedMove::fromMove(first.getMoveHistory()[0]);
+    builder.add(FastBoard::standardPosition(), favourite, 1.0);
+    builder.add(FastBoard::standardPosition(), favourite, 1.0);
+    builder.write(path);
+
+    OpeningBook book(path);
+    EXPECT_EQ(book.size(), builder.moveCount());
+    auto moves = book.lookup(FastBoard::standardPosition());
+    ASSERT_FALSE(moves.empty());
+    EXPECT_TRUE(sameMoveUpToSymmetry(FastBoard::standardPosition(), moves[0].move, favourite));
+    uint32_t total = 0;
+    for (size_t i = 0; i < moves.size(); ++i) {
+        total += moves[i].weight;
+        EXPECT_GE(moves[i].score, 0.0);
+        EXPECT_LE(moves[i].score, 1.0);
+        if (i > 0) {
+            EXPECT_GE(moves[i - 1].weight, moves[i].weight);
+        }
+    }
+    EXPECT_EQ(total, static_cast<uint32_t>(games + 2));
+
+    PackedMove move;
+    ASSERT_TRUE(book.probe(FastBoard::standardPosition(), move));
+    EXPECT_EQ(move, moves[0].move);
+    // Second plies are in the book, third plies are not
+    FastBoard board = FastBoard::standardPosition();
+    board.makeMove(PackedMove::fromMove(first.getMoveHistory()[0]));
+    EXPECT_TRUE(book.probe(board, move));
+    board.makeMove(PackedMove::fromMove(first.getMoveHistory()[1]));
+    EXPECT_FALSE(book.probe(board, move));
+    EXPECT_TRUE(book.lookup(board).empty());
+
+    // A minimum weight drops the moves played once
+    builder.write(path, 3);
+    OpeningBook filtered(path);
+    ASSERT_EQ(filtered.size(), 1u);
+    EXPECT_EQ(filtered.lookup(FastBoard::standardPosition())[0].weight, 3u);
+}
+
+TEST(OpeningBookTest, FindsEveryKeyInALargeBook) {
+    TempFile temp("opening_book_large_test.amzb");
+    const std::string& path = temp.path;
+    OpeningBook::Builder builder(1000);
+    std::vector<std::pair<FastBoard, PackedMove>> added;
+    FastRandom rng(7);
+    for (int game = 0; game < 40; ++game) {
+        FastBoard board = FastBoard::standardPosition();
+        PackedMove move;
+        while (board.randomMove(rng, move)) {
+            builder.add(board, move, game % 2);
+            added.push_back({board, move});
+            board.makeMove(move);
+        }
+    }
+    builder.write(path);
+
+    OpeningBook book(path);
+    EXPECT_GT(book.size(), 1000u);
+    for (const auto& [position, move] : added) {
+        // Transpositions and the shared start hold several moves
+        auto moves = book.lookup(position);
+        ASSERT_FALSE(moves.empty());
+        EXPECT_TRUE(std::any_of(moves.begin(), moves.end(), [&](const OpeningBook::BookMove& entry) {
+            return sameMoveUpToSymmetry(position, entry.move, move);
+        }));
+    }
+    // A position no game reached
+    FastBoard empty = FastBoard::fromBitboards(0, 0x0F, 0xF000000000000000ULL, Player::BLACK);
+    EXPECT_TRUE(book.lookup(empty).empty());
+}
+
+TEST(OpeningBookTest, EnginesPlayFromTheBook) {
+    TempFile temp("opening_book_engine_test.amzb");
+    const std::string& path = temp.path;
+    OpeningBook::Builder builder;
+    const GameState game = randomGame(3);
+    builder.addGame(game);
+    builder.write(path);
+
+    auto engine = createEngine("random:seed=5,book=" + path);
+    GameState state;
+    GameState played;
+    for (int ply = 0; ply < 8; ++ply) {
+        Move move = engine->getBestMove(state);
+        ASSERT_TRUE(engine->getLastWinRate()) << ply;
+        state.makeMove(move);
+        // The book line, or its mirror image if the book turned the first move
+        played.makeMove(game.getMoveHistory()[ply]);
+        EXPECT_EQ(OpeningBook::positionKey(FastBoard::fromGameState(state)),
+                  OpeningBook::positionKey(FastBoard::fromGameState(played))) << ply;
+    }
+    // Out of the book the wrapped engine answers
+    state.makeMove(engine->getBestMove(state));
+    EXPECT_FALSE(engine->getLastWinRate());
+    EXPECT_NO_THROW(createEngine("basic:book=" + path));
+}
+
+TEST(OpeningBookTest, SharesEntriesBetweenReflections) {
+    TempFile temp("opening_book_symmetry_test.amzb");
+    const std::string& path = temp.path;
+    OpeningBook::Builder builder(6);
+    const GameState game = randomGame(9);
+    // Played as is and upside down: the start is its own top-bottom mirror
+    GameState mirrored;
+    for (const Move& move : game.getMoveHistory()) {
+        mirrored.makeMove(Symmetry::transform(PackedMove::fromMove(move), 2).toMove());
+    }
+    builder.addGame(game);
+    builder.addGame(mirrored);
+    builder.write(path);
+    EXPECT_EQ(builder.moveCount(), 6u);
+
+    OpeningBook book(path);
+    FastBoard board = FastBoard::standardPosition();
+    FastBoard flipped = FastBoard::standardPosition();
+    for (int ply = 0; ply < 6; ++ply) {
+        const PackedMove move = PackedMove::fromMove(game.getMoveHistory()[ply]);
+        const PackedMove mirror = Symmetry::transform(move, 2);
+        auto moves = book.lookup(board);
+        ASSERT_EQ(moves.size(), 1u) << ply;
+        EXPECT_EQ(moves[0].weight, 2u);
+        EXPECT_TRUE(sameMoveUpToSymmetry(board, moves[0].move, move)) << ply;
+        auto flippedMoves = book.lookup(flipped);
+        ASSERT_EQ(flippedMoves.size(), 1u);
+        EXPECT_TRUE(sameMoveUpToSymmetry(flipped, flippedMoves[0].move, mirror)) << ply;
+        board.makeMove(move);
+        flipped.makeMove(mirror);
+    }
+}
+
+TEST(OpeningBookTest, RejectsOtherFiles) {
+    EXPECT_THROW(OpeningBook("opening_book_missing.amzb"), std::runtime_error);
+    EXPECT_THROW(createEngine("basic:book=opening_book_missing.amzb"), std::runtime_error);
+    TempFile temp("opening_book_bad_test.amzb");
+    const std::string& path = temp.path;
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "AMZBOOK1" << std::string(8, '\x01');
+    }
+    EXPECT_THROW(OpeningBook{path}, std::runtime_error);
+}
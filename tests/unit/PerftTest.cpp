@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "core/Perft.hpp"
+#include "core/GameState.hpp"
+
+using namespace amazons;
+
+namespace {
+    // Same count through the reference GameState generator
+    uint64_t slowPerft(GameState& state, int depth) {
+        auto moves = state.getLegalMoves();
+        if (depth == 1) {
+            return moves.size();
+        }
+        uint64_t nodes = 0;
+        for (const auto& move : moves) {
+            state.makeMove(move);
+            nodes += slowPerft(state, depth - 1);
+            state.undoLastMove();
+        }
+        return nodes;
+    }
+}
+
+TEST(PerftTest, MatchesReferenceCounts) {
+    FastBoard board = FastBoard::standardPosition();
+    EXPECT_EQ(Perft::count(board, 0), 1u);
+    EXPECT_EQ(Perft::count(board, 1), Perft::referenceCount(1));
+    EXPECT_EQ(Perft::count(board, 2), Perft::referenceCount(2));
+    EXPECT_EQ(board, FastBoard::standardPosition());
+}
+
+TEST(PerftTest, ReferenceCountsAgreeWithGameState) {
+    GameState state;
+    EXPECT_EQ(slowPerft(state, 1), Perft::referenceCount(1));
+    EXPECT_EQ(slowPerft(state, 2), Perft::referenceCount(2));
+}
+
+TEST(PerftTest, BulkAndFullCountingAgree) {
+    FastBoard board = FastBoard::standardPosition();
+    EXPECT_EQ(Perft::count(board, 2, false), Perft::count(board, 2, true));
+}
+
+TEST(PerftTest, ThreadedDivideSumsToTotal) {
+    Perft::Options options;
+    options.depth = 2;
+    options.threads = 4;
+    options.divide = true;
+    Perft::Result result = Perft::run(FastBoard::standardPosition(), options);
+
+    EXPECT_EQ(result.nodes, Perft::referenceCount(2));
+    ASSERT_EQ(result.divide.size(), Perft::referenceCount(1));
+    uint64_t sum = 0;
+    for (size_t i = 0; i < result.divide.size(); ++i) {
+        sum += result.divide[i].nodes;
+        if (i > 0) {
+            EXPECT_LT(result.divide[i - 1].move, result.divide[i].move);
+        }
+    }
+    EXPECT_EQ(sum, result.nodes);
+}
+
+TEST(PerftTest, RejectsInvalidDepth) {
+    Perft::Options options;
+    options.depth = 0;
+    EXPECT_THROW(Perft::run(FastBoard::standardPosition(), options), std::invalid_argument);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "core/PositionNotation.hpp"
+#include "TestHelpers.hpp"
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    const char* const START = "2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 1";
+}
+
+TEST(PositionNotationTest, StandardPosition) {
+    EXPECT_EQ(PositionNotation::format(FastBoard::standardPosition()), START);
+    EXPECT_EQ(PositionNotation::format(GameState()), START);
+
+    int turn = 0;
+    FastBoard board = PositionNotation::parse(START, &turn);
+    EXPECT_EQ(board, FastBoard::standardPosition());
+    EXPECT_EQ(board.hash(), FastBoard::standardPosition().hash());
+    EXPECT_EQ(turn, 1);
+    EXPECT_EQ(PositionNotation::parseGameState(START), GameState());
+}
+
+TEST(PositionNotationTest, RoundTripsPlayedGames) {
+    for (uint64_t seed = 1; seed <= 10; ++seed) {
+        const GameState game = randomGame(seed);
+        GameState state;
+        FastBoard board;
+        for (const Move& move : game.getMoveHistory()) {
+            state.makeMove(move);
+
+            const std::string text = PositionNotation::format(state);
+            GameState parsed = PositionNotation::parseGameState(text);
+            ASSERT_EQ(parsed, state) << text;
+            int turn = 0;
+            ASSERT_TRUE(PositionNotation::tryParse(text, board, turn));
+            EXPECT_EQ(board.hash(), FastBoard::fromGameState(state).hash());
+        }
+    }
+}
+
+TEST(PositionNotationTest, OptionalTurnAndTrailingSpace) {
+    int turn = 0;
+    EXPECT_EQ(PositionNotation::parse("2B2W2/8/B6W/8/8/B6W/8/2B2W2 w", &turn).sideToMove(), Player::WHITE);
+    EXPECT_EQ(turn, 1);
+    PositionNotation::parse("2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 37\r\n", &turn);
+    EXPECT_EQ(turn, 37);
+}
+
+TEST(PositionNotationTest, RejectsMalformedPositions) {
+    for (const char* text : {
+             "",
+             "2B2W2/8/B6W/8/8/B6W/8 b 1",               // seven rows
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2/8 b 1",       // nine rows
+             "2B2W2/9/B6W/8/8/B6W/8/2B2W2 b 1",         // 9 is not a run
+             "2B2W2/44/B6W/8/8/B6W/8/2B2W2 b 1",        // runs must be merged
+             "2B2W3/7/B6W/8/8/B6W/8/2B2W2 b 1",         // row too long
+             "2B2W1/9/B6W/8/8/B6W/8/2B2W2 b 1",         // row too short
+             "2B2W2/8/B6W/8/8/B6W/8/2B2B2 b 1",         // five black, three white
+             "2B2W2/8/B6W/8/8/B6W/8/2B2X2 b 1",         // three white
+             "2B2W2/8/B6W/8/8/B6W/8/2b2w2 b 1",         // lower-case cells
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2",             // no side
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2 x 1",         // bad side
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 0",         // turns count from 1
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 99999999",  // absurd turn
+             "2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 1 extra",
+         }) {
+        FastBoard board;
+        int turn = 0;
+        EXPECT_FALSE(PositionNotation::tryParse(text, board, turn)) << text;
+        EXPECT_THROW(PositionNotation::parse(text), std::invalid_argument) << text;
+    }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "utils/SaveIndex.hpp"
+#include "utils/Serializer.hpp"
+#include "TestHelpers.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    const SaveInfo* findSave(const std::vector<SaveInfo>& saves, const std::string& name) {
+        auto found = std::find_if(saves.begin(), saves.end(), [&](const SaveInfo& info) { return info.name == name; });
+        return found == saves.end() ? nullptr : &*found;
+    }
+}
+
+TEST(SaveIndexTest, StoresSortedAndDetectsDamage) {
+    TempDirectory directory("amazons_save_index_file_test");
+    SaveIndex index(directory.path);
+    index.put({"zeta", 1700000000, 12, 23, GameMode::AI_VS_AI, true});
+    index.put({"alpha", -5, 1, 0, GameMode::HUMAN_VS_AI_HUMAN_WHITE, false});
+    index.put({"mid", 42, 3, 4, GameMode::HUMAN_VS_HUMAN, true});
+    index.put({"mid", 43, 4, 6, GameMode::HUMAN_VS_HUMAN, true});
+    index.erase("missing");
+    index.store();
+
+    SaveIndex loaded(directory.path);
+    ASSERT_TRUE(loaded.load());
+    ASSERT_EQ(loaded.all().size(), 3u);
+    EXPECT_EQ(loaded.all()[0].name, "alpha");
+    EXPECT_EQ(loaded.all()[0].savedAt, -5);
+    EXPECT_EQ(*loaded.find("mid"), index.all()[1]);
+    EXPECT_EQ(loaded.find("mid")->turnNumber, 4);
+    EXPECT_EQ(*loaded.find("zeta"), index.all()[2]);
+
+    // One flipped byte fails the checksum
+    {
+        std::fstream file(index.getPath(), std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(14);
+        file.put('\x55');
+    }
+    EXPECT_FALSE(loaded.load());
+    EXPECT_TRUE(loaded.all().empty());
+    std::remove(index.getPath().c_str());
+    EXPECT_FALSE(loaded.load());
+}
+
+TEST(SaveIndexTest, SerializerKeepsIndexInStep) {
+    TempDirectory directory("amazons_save_index_test");
+    Serializer serializer(directory.path);
+    const GameState game = randomGame(21, 9);
+    serializer.writeSave(game, GameMode::HUMAN_VS_AI_HUMAN_BLACK, "save_index_test_record", Serializer::SaveFormat::RECORD);
+    serializer.writeSave(GameState(), GameMode::HUMAN_VS_HUMAN, "save_index_test_json");
+
+    auto saves = serializer.listSaves();
+    ASSERT_TRUE(findSave(saves, "save_index_test_record"));
+    const SaveInfo record = *findSave(saves, "save_index_test_record");
+    EXPECT_TRUE(record.record);
+    EXPECT_EQ(record.plies, 9u);
+    EXPECT_EQ(record.turnNumber, game.getTurnNumber());
+    EXPECT_EQ(record.gameMode, GameMode::HUMAN_VS_AI_HUMAN_BLACK);
+    EXPECT_GT(record.savedAt, 0);
+    ASSERT_TRUE(findSave(saves, "save_index_test_json"));
+    EXPECT_FALSE(findSave(saves, "save_index_test_json")->record);
+
+    EXPECT_TRUE(serializer.deleteSave("save_index_test_json"));
+    EXPECT_FALSE(findSave(serializer.listSaves(), "save_index_test_json"));
+
+    // A save dropped in by hand shows up once the index is rebuilt
+    {
+        std::ofstream file(directory.path + "save_index_test_copied.json");
+        file << serializer.serializeGameState(game, GameMode::AI_VS_AI);
+    }
+    EXPECT_FALSE(findSave(serializer.listSaves(), "save_index_test_copied"));
+    serializer.rebuildSaveIndex();
+    saves = serializer.listSaves();
+    ASSERT_TRUE(findSave(saves, "save_index_test_copied"));
+    EXPECT_EQ(findSave(saves, "save_index_test_copied")->gameMode, GameMode::AI_VS_AI);
+    // Rebuilt entries take the file's mtime, which may fall in the next second
+    ASSERT_TRUE(findSave(saves, "save_index_test_record"));
+    SaveInfo rebuilt = *findSave(saves, "save_index_test_record");
+    EXPECT_LE(rebuilt.savedAt - record.savedAt, 1);
+    rebuilt.savedAt = record.savedAt;
+    EXPECT_EQ(rebuilt, record);
+
+    // A lost index is rebuilt from the files on first use
+    std::remove(SaveIndex(directory.path).getPath().c_str());
+    saves = serializer.listSaves();
+    EXPECT_TRUE(findSave(saves, "save_index_test_copied"));
+    EXPECT_TRUE(findSave(saves, "save_index_test_record"));
+
+    EXPECT_TRUE(serializer.deleteSave("save_index_test_copied"));
+    EXPECT_TRUE(serializer.deleteSave("save_index_test_record"));
+    EXPECT_TRUE(serializer.listSaves().empty());
+}
+
+TEST(SaveIndexTest, SerializerSeesIndexChangesOnDisk) {
+    TempDirectory directory("amazons_save_index_cache_test");
+    Serializer serializer(directory.path);
+    serializer.writeSave(randomGame(5, 3), GameMode::AI_VS_AI, "cached", Serializer::SaveFormat::RECORD);
+    ASSERT_EQ(serializer.listSaves().size(), 1u);
+
+    // Another process rewriting the index replaces the parsed copy
+    SaveIndex index(directory.path);
+    ASSERT_TRUE(index.load());
+    index.put({"elsewhere", 7, 2, 1, GameMode::HUMAN_VS_HUMAN, true});
+    index.store();
+    auto saves = serializer.listSaves();
+    ASSERT_EQ(saves.size(), 2u);
+    EXPECT_EQ(saves[0], index.all()[0]);
+
+    // An index that cannot be written back still lists what the rebuild found
+    std::remove(index.getPath().c_str());
+    std::filesystem::create_directory(index.getPath());
+    saves = serializer.listSaves();
+    ASSERT_EQ(saves.size(), 1u);
+    EXPECT_EQ(saves[0].name, "cached");
+    EXPECT_EQ(serializer.getSavedGames(), std::vector<std::string>{"cached"});
+}
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include "ai/SelfPlay.hpp"
+#include "utils/TrainingData.hpp"
+#include "TestHelpers.hpp"
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    TrainingRecord sampleRecord(int i) {
+        TrainingRecord record;
+        record.arrows = 0x8000000000000001ULL << (i % 3);
+        record.white = 0x0000000000240081ULL;
+        record.black = 0x8100240000000000ULL;
+        record.score = static_cast<int16_t>(-1000 + 37 * i);
+        record.ply = static_cast<uint8_t>(i);
+        record.blackToMove = i % 2 == 0;
+        record.sideToMoveWon = i % 3 == 0;
+        record.hasScore = i % 5 != 0;
+        return record;
+    }
+}
+
+TEST(SelfPlayTest, RecordEncodingRoundTrips) {
+    for (int i = 0; i < 60; ++i) {
+        TrainingRecord record = sampleRecord(i);
+        unsigned char bytes[TrainingRecord::RECORD_SIZE];
+        record.encode(bytes);
+        EXPECT_EQ(TrainingRecord::decode(bytes), record);
+    }
+}
+
+TEST(SelfPlayTest, WriterKeepsEveryBatch) {
+    TempFile file("selfplay_writer_test.bin");
+    std::vector<TrainingRecord> expected;
+    {
+        TrainingDataWriter writer(file.path, 2);
+        for (int batch = 0; batch < 10; ++batch) {
+            std::vector<TrainingRecord> records;
+            for (int i = 0; i < 7; ++i) {
+                records.push_back(sampleRecord(batch * 7 + i));
+            }
+            expected.insert(expected.end(), records.begin(), records.end());
+            writer.submit(std::move(records));
+        }
+        writer.close();
+        EXPECT_EQ(writer.recordsWritten(), expected.size());
+        EXPECT_THROW(writer.submit({sampleRecord(0)}), std::logic_error);
+    }
+    EXPECT_EQ(readTrainingData(file.path), expected);
+}
+
+TEST(SelfPlayTest, RejectsForeignFiles) {
+    TempFile file("selfplay_foreign_test.bin");
+    std::FILE* out = std::fopen(file.path.c_str(), "wb");
+    ASSERT_NE(out, nullptr);
+    std::fputs("not training data", out);
+    std::fclose(out);
+    EXPECT_THROW(readTrainingData(file.path), std::runtime_error);
+}
+
+TEST(SelfPlayTest, RecordsEverySearchedPosition) {
+    TempFile file("selfplay_run_test.bin");
+    SelfPlay::Options options;
+    options.engine = "mcts:time=0,playouts=30,seed=5";
+    options.games = 3;
+    options.threads = 2;
+    options.randomPlies = 4;
+    options.seed = 11;
+
+    SelfPlay::Stats stats;
+    {
+        TrainingDataWriter writer(file.path);
+        stats = SelfPlay::run(options, writer);
+        writer.close();
+        EXPECT_EQ(writer.recordsWritten(), stats.positions);
+    }
+    EXPECT_EQ(stats.games, 3);
+
+    std::vector<TrainingRecord> records = readTrainingData(file.path);
+    ASSERT_EQ(records.size(), stats.positions);
+    size_t scored = 0;
+    for (const auto& record : records) {
+        EXPECT_GE(record.ply, options.randomPlies);
+        EXPECT_EQ(__builtin_popcountll(record.white), 4);
+        EXPECT_EQ(__builtin_popcountll(record.black), 4);
+        EXPECT_EQ(record.arrows & (record.white | record.black), 0u);
+        EXPECT_EQ(__builtin_popcountll(record.arrows), record.ply);
+        EXPECT_EQ(record.blackToMove, record.ply % 2 == 0);
+        EXPECT_GE(record.score, -1000);
+        EXPECT_LE(record.score, 1000);
+        scored += record.hasScore;
+    }
+    // Forced moves are played without a search and carry no score
+    EXPECT_GT(scored, records.size() / 2);
+}
+
+TEST(SelfPlayTest, EnginesWithoutScoreStillLabelResults) {
+    TempFile file("selfplay_random_test.bin");
+    SelfPlay::Options options;
+    options.engine = "random:seed=2";
+    options.games = 4;
+    options.randomPlies = 0;
+    options.seed = 3;
+
+    TrainingDataWriter writer(file.path);
+    SelfPlay::Stats stats = SelfPlay::run(options, writer);
+    writer.close();
+
+    std::vector<TrainingRecord> records = readTrainingData(file.path);
+    ASSERT_EQ(records.size(), stats.positions);
+    for (const auto& record : records) {
+        EXPECT_FALSE(record.hasScore);
+    }
+    // The last position of each game belongs to the winner, who made the final move
+    int winnersToMove = 0;
+    for (size_t i = 0; i < records.size(); ++i) {
+        bool lastOfGame = i + 1 == records.size() || records[i + 1].ply == 0;
+        if (lastOfGame) {
+            EXPECT_TRUE(records[i].sideToMoveWon);
+            winnersToMove++;
+        }
+    }
+    EXPECT_EQ(winnersToMove, options.games);
+}
+
+TEST(SelfPlayTest, RejectsUnknownEngine) {
+    TempFile file("selfplay_bad_engine_test.bin");
+    TrainingDataWriter writer(file.path);
+    SelfPlay::Options options;
+    options.engine = "alphabeta";
+    EXPECT_THROW(SelfPlay::run(options, writer), std::invalid_argument);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include "core/Symmetry.hpp"
+#include "TestHelpers.hpp"
+#include <set>
+#include <vector>
+
+using namespace amazons;
+using namespace amazons::test;
+
+namespace {
+    // Every position of random games, from the given seed on, until there are count of them
+    std::vector<FastBoard> randomPositions(uint64_t seed, int count) {
+        std::vector<FastBoard> positions;
+        while (static_cast<int>(positions.size()) < count) {
+            const GameState game = randomGame(seed++);
+            FastBoard board = FastBoard::standardPosition();
+            for (const Move& move : game.getMoveHistory()) {
+                board.makeMove(PackedMove::fromMove(move));
+                positions.push_back(board);
+            }
+        }
+        positions.resize(count);
+        return positions;
+    }
+}
+
+TEST(SymmetryTest, BitboardsMatchSquareBySquare) {
+    FastRandom rng(3);
+    for (int round = 0; round < 100; ++round) {
+        const uint64_t bits = rng.next();
+        for (int symmetry = 0; symmetry < Symmetry::COUNT; ++symmetry) {
+            uint64_t expected = 0;
+            for (int square = 0; square < FastBoard::SQUARES; ++square) {
+                if (bits & FastBoard::squareBit(square)) {
+                    expected |= FastBoard::squareBit(Symmetry::transformSquare(square, symmetry));
+                }
+            }
+            ASSERT_EQ(Symmetry::transform(bits, symmetry), expected) << symmetry;
+            EXPECT_EQ(Symmetry::transform(Symmetry::transform(bits, symmetry), Symmetry::inverse(symmetry)), bits);
+        }
+    }
+    // Eight distinct images of an asymmetric pattern
+    std::set<uint64_t> images;
+    for (int symmetry = 0; symmetry < Symmetry::COUNT; ++symmetry) {
+        images.insert(Symmetry::transform(FastBoard::squareBit(FastBoard::squareOf(0, 1)), symmetry));
+    }
+    EXPECT_EQ(images.size(), 8u);
+}
+
+TEST(SymmetryTest, StartIsItsOwnTopBottomMirror) {
+    const FastBoard start = FastBoard::standardPosition();
+    EXPECT_EQ(Symmetry::transform(start, 2), start);
+    EXPECT_NE(Symmetry::transform(start, 1), start);
+    EXPECT_EQ(Symmetry::canonical(start).key, Symmetry::canonical(Symmetry::transform(start, 5)).key);
+}
+
+TEST(SymmetryTest, EquivalentPositionsShareOneKey) {
+    for (const FastBoard& position : randomPositions(11, 200)) {
+        const Symmetry::Canonical canonical = Symmetry::canonical(position);
+        const FastBoard form = Symmetry::transform(position, canonical.symmetry);
+        EXPECT_EQ(form.hash(), canonical.key);
+        for (int symmetry = 0; symmetry < Symmetry::COUNT; ++symmetry) {
+            const FastBoard image = Symmetry::transform(position, symmetry);
+            ASSERT_EQ(Symmetry::canonical(image).key, canonical.key);
+            EXPECT_EQ(Symmetry::transform(image, Symmetry::inverse(symmetry)), position);
+        }
+
+        // A move turned onto the canonical form and back is the same legal move
+        PackedMove moves[FastBoard::MAX_MOVES];
+        const int count = position.generateMoves(moves);
+        for (int i = 0; i < count; i += 37) {
+            const PackedMove turned = Symmetry::transform(moves[i], canonical.symmetry);
+            EXPECT_TRUE(form.isLegal(turned));
+            EXPECT_EQ(Symmetry::transform(turned, Symmetry::inverse(canonical.symmetry)), moves[i]);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "core/FastBoard.hpp"
+#include "core/GameState.hpp"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+// Fixtures shared by the unit tests
+namespace amazons::test {
+
+// Random legal moves from the standard start until the game ends or maxPlies is reached
+inline GameState randomGame(uint64_t seed, int maxPlies = INT_MAX) {
+    GameState state;
+    FastRandom rng(seed);
+    FastBoard board = FastBoard::standardPosition();
+    PackedMove move;
+    for (int ply = 0; ply < maxPlies && board.randomMove(rng, move); ++ply) {
+        board.makeMove(move);
+        state.makeMove(move.toMove());
+    }
+    return state;
+}
+
+// The position after the first plies moves of a game, with those moves as its history
+inline GameState prefix(const GameState& game, size_t plies) {
+    GameState state;
+    for (size_t i = 0; i < plies; ++i) {
+        state.makeMove(game.getMoveHistory()[i]);
+    }
+    return state;
+}
+
+// Removes the file when the test ends, whatever the outcome, and any leftover
+// of an interrupted run when it starts
+struct TempFile {
+    std::string path;
+    explicit TempFile(const std::string& name) : path(name) { std::remove(path.c_str()); }
+    ~TempFile() { std::remove(path.c_str()); }
+
+    TempFile(const TempFile&) = delete;
+    TempFile& operator=(const TempFile&) = delete;
+};
+
+// The same for a directory under the system temp dir and everything in it;
+// path ends in a slash
+struct TempDirectory {
+    std::string path;
+    explicit TempDirectory(const std::string& name)
+        : path((std::filesystem::temp_directory_path() / name).string() + "/") {
+        std::filesystem::remove_all(path);
+        std::filesystem::create_directories(path);
+    }
+    ~TempDirectory() {
+        std::error_code ignored;
+        std::filesystem::remove_all(path, ignored);
+    }
+
+    TempDirectory(const TempDirectory&) = delete;
+    TempDirectory& operator=(const TempDirectory&) = delete;
+};
+
+} // namespace amazons::test
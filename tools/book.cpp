@@ -0,0 +1,171 @@
+#include "ai/Engine.hpp"
+#include "core/PositionNotation.hpp"
+#include "utils/GameDatabase.hpp"
+#include "utils/OpeningBook.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " BOOK COMMAND [ARGS]\n"
+                  << "Opening book: the moves engines chose in the first plies of many games.\n"
+                  << "Commands:\n"
+                  << "  build [options]            Let an engine play itself and write the book\n"
+                  << "  import DB [options]        Write the book from the finished games of a game database\n"
+                  << "  probe [POSITION]           Book moves for a position (default: the start)\n"
+                  << "  stats                      Number of entries\n"
+                  << "Options for build and import:\n"
+                  << "  --engine SPEC       Engine spec as for amazons_match (default mcts:time=0,playouts=2000)\n"
+                  << "  --games N           Number of self-play games (default 100)\n"
+                  << "  --threads N         Games played at once (default: all cores)\n"
+                  << "  --plies N           Opening plies taken from each game (default 8)\n"
+                  << "  --min-games N       Leave out moves played fewer times (default 1)\n"
+                  << "Engines read a book through the spec key book=PATH, amazons_bot through --book.\n";
+    }
+
+    struct BuildOptions {
+        std::string engine = "mcts:time=0,playouts=2000";
+        int games = 100;
+        unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+        int plies = 8;
+        uint32_t minGames = 1;
+    };
+
+    BuildOptions parseBuildOptions(int argc, char* argv[], int first) {
+        BuildOptions options;
+        for (int i = first; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--engine") {
+                options.engine = value();
+            } else if (arg == "--games") {
+                options.games = std::stoi(value());
+            } else if (arg == "--threads" || arg == "-j") {
+                options.threads = std::max(1u, static_cast<unsigned>(std::stoul(value())));
+            } else if (arg == "--plies") {
+                options.plies = std::stoi(value());
+            } else if (arg == "--min-games") {
+                options.minGames = static_cast<uint32_t>(std::stoul(value()));
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+        return options;
+    }
+
+    // Every worker owns its engine; only the builder is shared
+    void playGames(const BuildOptions& options, OpeningBook::Builder& builder) {
+        createEngine(options.engine);   // fail fast on a bad spec
+        std::atomic<int> nextGame{0};
+        std::mutex builderMutex;
+        std::exception_ptr failure;
+        int finished = 0;
+        const int reportEvery = std::max(1, options.games / 20);
+        auto start = std::chrono::steady_clock::now();
+
+        auto worker = [&]() {
+            try {
+                auto engine = createEngine(options.engine);
+                for (int game = nextGame++; game < options.games; game = nextGame++) {
+                    GameState state;
+                    engine->newGame();
+                    while (!state.isGameOver()) {
+                        state.makeMove(engine->getBestMove(state));
+                    }
+                    std::lock_guard<std::mutex> lock(builderMutex);
+                    builder.addGame(state);
+                    if (++finished % reportEvery == 0) {
+                        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                        std::cout << "Games " << finished << "  positions " << builder.positionCount() << "  "
+                                  << std::fixed << std::setprecision(1) << seconds << " s\n";
+                    }
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(builderMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+                nextGame = options.games;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned i = 1; i < options.threads; ++i) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& thread : pool) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            printUsage(argv[0]);
+            return argc == 2 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") ? 0 : 1;
+        }
+        const std::string bookPath = argv[1];
+        const std::string command = argv[2];
+
+        if (command == "build") {
+            BuildOptions options = parseBuildOptions(argc, argv, 3);
+            std::cout << options.engine << ", " << options.games << " games, "
+                      << options.threads << " threads -> " << bookPath << "\n";
+            OpeningBook::Builder builder(options.plies);
+            playGames(options, builder);
+            builder.write(bookPath, options.minGames);
+            std::cout << builder.positionCount() << " positions, " << builder.moveCount() << " moves\n";
+        } else if (command == "import" && argc >= 4) {
+            BuildOptions options = parseBuildOptions(argc, argv, 4);
+            GameDatabase database(argv[3]);
+            OpeningBook::Builder builder(options.plies);
+            size_t taken = 0;
+            for (uint32_t id = 0; id < database.gameCount(); ++id) {
+                taken += builder.addGame(*database.game(id).first);
+            }
+            builder.write(bookPath, options.minGames);
+            std::cout << "Took " << taken << " of " << database.gameCount() << " games: "
+                      << builder.positionCount() << " positions, " << builder.moveCount() << " moves\n";
+        } else if (command == "probe") {
+            OpeningBook book(bookPath);
+            FastBoard position = argc >= 4 ? PositionNotation::parse(argv[3]) : FastBoard::standardPosition();
+            auto start = std::chrono::steady_clock::now();
+            auto moves = book.lookup(position);
+            double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            for (const auto& entry : moves) {
+                std::cout << entry.move.toMove().toString() << "  games " << entry.weight << "  score "
+                          << std::fixed << std::setprecision(3) << entry.score << "\n";
+            }
+            std::cout << moves.size() << " book moves (" << std::setprecision(1) << us << " us)\n";
+        } else if (command == "stats") {
+            std::cout << OpeningBook(bookPath).size() << " entries\n";
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
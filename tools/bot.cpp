@@ -0,0 +1,65 @@
+#include "ai/BotzoneBot.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "Botzone bot speaking the simple-interaction protocol on stdin/stdout.\n"
+                  << "Stays alive between turns (keep-running mode) so the search tree is reused.\n"
+                  << "Options:\n"
+                  << "  --time S            Wall-clock budget per turn in seconds (default 3)\n"
+                  << "  --margin S          Part of the budget kept back for overhead (default 0.2)\n"
+                  << "  --threads N         Search threads (default 1)\n"
+                  << "  --seed N            Search seed (default: from the clock)\n"
+                  << "  --book FILE         Opening book from amazons_book, played without searching\n"
+                  << "  --no-keep-running   Answer one turn per process\n"
+                  << "  --help, -h          Show this help message\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        BotzoneBot::Options options;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--time") {
+                options.turnSeconds = std::stod(value());
+            } else if (arg == "--margin") {
+                options.safetyMarginSeconds = std::stod(value());
+            } else if (arg == "--threads") {
+                options.mcts.threads = static_cast<unsigned>(std::stoul(value()));
+            } else if (arg == "--seed") {
+                options.mcts.seed = std::stoull(value());
+            } else if (arg == "--book") {
+                options.bookPath = value();
+            } else if (arg == "--no-keep-running") {
+                options.keepRunning = false;
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+
+        std::ios::sync_with_stdio(false);
+        std::cin.tie(nullptr);
+        BotzoneBot bot(options);
+        bot.run(std::cin, std::cout);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,101 @@
+#include "ai/BotServer.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options] BOT BOT [BOT...]\n"
+                  << "Round robin between Botzone-protocol bot executables, all games driven\n"
+                  << "from one event loop.\n"
+                  << "Options:\n"
+                  << "  --games-per-pair N  Games per pairing, colours alternating (default 2)\n"
+                  << "  --concurrency N     Games running at once (default 64)\n"
+                  << "  --time S            Wall-clock limit per move in seconds (default 3)\n"
+                  << "  --startup S         Extra time on a process's first move (default 1)\n"
+                  << "  --cpu-limit S       CPU-time cap per bot process\n"
+                  << "  --memory-limit MB   Address-space cap per bot process\n"
+                  << "  --results FILE      Append-as-you-go CSV of finished games\n"
+                  << "  --help, -h          Show this help message\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+#ifndef _WIN32
+    // A bot that dies mid-write must show up as a failed write, not kill us
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    try {
+        BotServer::Options options;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--games-per-pair") {
+                options.gamesPerPair = std::stoi(value());
+            } else if (arg == "--concurrency") {
+                options.maxConcurrentGames = std::stoul(value());
+            } else if (arg == "--time") {
+                options.turnSeconds = std::stod(value());
+            } else if (arg == "--startup") {
+                options.startupSeconds = std::stod(value());
+            } else if (arg == "--cpu-limit") {
+                options.limits.cpuSeconds = std::stod(value());
+            } else if (arg == "--memory-limit") {
+                options.limits.memoryBytes = std::stoull(value()) * 1024 * 1024;
+            } else if (arg == "--results") {
+                options.resultsPath = value();
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::invalid_argument("Unknown option " + arg);
+            } else {
+                options.bots.push_back(arg);
+            }
+        }
+        if (options.bots.size() < 2) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        size_t total = options.bots.size() * (options.bots.size() - 1) / 2 * options.gamesPerPair;
+        std::cout << options.bots.size() << " bots, " << total << " games, up to "
+                  << options.maxConcurrentGames << " at once\n";
+        BotServer::Result result = BotServer::run(options, [&](const BotServer::GameResult& game) {
+            std::cout << options.bots[game.black] << " vs " << options.bots[game.white] << ": "
+                      << options.bots[game.winner] << " wins (" << BotServer::reasonName(game.reason)
+                      << ", " << game.plies << " plies)\n";
+        });
+
+        std::vector<size_t> order(options.bots.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return result.wins[a] > result.wins[b]; });
+        std::cout << "\nStandings after " << result.games.size() << " games, " << std::fixed
+                  << std::setprecision(1) << result.elapsedSeconds << " s\n";
+        for (size_t index : order) {
+            std::cout << std::setw(5) << result.wins[index] << " / " << std::setw(5) << std::left
+                      << result.played[index] << std::right << "  " << options.bots[index] << "\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,106 @@
+#include "core/PositionNotation.hpp"
+#include "utils/GameArchive.hpp"
+#include "utils/GameDatabase.hpp"
+#include "utils/Serializer.hpp"
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " DB COMMAND [ARGS]\n"
+                  << "Archive of whole games with an index of every position they reached.\n"
+                  << "Commands:\n"
+                  << "  import FILE...             Append saved games (.amzr records or .json saves)\n"
+                  << "                             or every game of a game archive\n"
+                  << "  find POSITION              Games that reached a position, in notation such as\n"
+                  << "                             \"2B2W2/8/B6W/8/8/B6W/8/2B2W2 b\"\n"
+                  << "  show ID                    Moves and final position of one game\n"
+                  << "  export ARCHIVE             Write all games to a compressed game archive\n"
+                  << "  stats                      Number of games\n";
+    }
+
+    bool isArchiveFile(const char* path) {
+        char head[8] = {};
+        std::ifstream file(path, std::ios::binary);
+        return file.read(head, sizeof(head)) && GameArchive::isArchive(head, sizeof(head));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) {
+            printUsage(argv[0]);
+            return argc == 2 && (std::string(argv[1]) == "--help" || std::string(argv[1]) == "-h") ? 0 : 1;
+        }
+        GameDatabase database(argv[1]);
+        const std::string command = argv[2];
+
+        if (command == "import") {
+            int imported = 0;
+            Serializer serializer;      // one read buffer for the whole import
+            for (int i = 3; i < argc; ++i) {
+                if (isArchiveFile(argv[i])) {
+                    GameArchive archive(argv[i]);
+                    for (uint64_t id = 0; id < archive.gameCount(); ++id) {
+                        auto game = archive.game(id);
+                        database.append(*game.first, game.second);
+                        imported++;
+                    }
+                    continue;
+                }
+                auto save = serializer.loadGameFile(argv[i]);
+                if (!save.first) {
+                    std::cerr << "Skipping " << argv[i] << ": not a readable save\n";
+                    continue;
+                }
+                database.append(*save.first, save.second);
+                imported++;
+            }
+            database.flush();
+            std::cout << "Imported " << imported << " games, " << database.gameCount() << " in total\n";
+        } else if (command == "find" && argc >= 4) {
+            FastBoard position = PositionNotation::parse(argv[3]);
+            auto start = std::chrono::steady_clock::now();
+            auto found = database.find(position);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            for (const auto& occurrence : found) {
+                std::cout << "game " << occurrence.game << " ply " << occurrence.ply << "\n";
+            }
+            std::cout << found.size() << " occurrences in " << database.gameCount() << " games (" << ms << " ms)\n";
+        } else if (command == "show" && argc >= 4) {
+            auto game = database.game(static_cast<uint32_t>(std::stoul(argv[3])));
+            int ply = 0;
+            for (const Move& move : game.first->getMoveHistory()) {
+                std::cout << ++ply << ". " << move.toString() << "\n";
+            }
+            std::cout << PositionNotation::format(*game.first) << "\n";
+            if (game.first->isGameOver()) {
+                std::cout << playerToString(game.first->getWinner()) << " wins\n";
+            } else {
+                std::cout << "unfinished\n";
+            }
+        } else if (command == "export" && argc >= 4) {
+            GameArchive::Writer writer(argv[3]);
+            for (uint32_t id = 0; id < database.gameCount(); ++id) {
+                auto game = database.game(id);
+                writer.add(*game.first, game.second);
+            }
+            writer.close();
+            std::cout << "Exported " << writer.gameCount() << " games in " << writer.bytesWritten() << " bytes\n";
+        } else if (command == "stats") {
+            std::cout << database.gameCount() << " games\n";
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
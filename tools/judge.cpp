@@ -0,0 +1,120 @@
+#include "ai/BotzoneJudge.hpp"
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifndef _WIN32
+#include <signal.h>
+#endif
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options] BOT_A BOT_B\n"
+                  << "Plays Botzone-protocol bots against each other under Botzone's rules,\n"
+                  << "colours alternating between games, BOT_A is Black in the first game.\n"
+                  << "Options:\n"
+                  << "  --games N           Games to play (default 2)\n"
+                  << "  --json-a, --json-b  Talk to that bot in the JSON protocol (default simple)\n"
+                  << "  --time S            Wall-clock limit per move in seconds (default 3)\n"
+                  << "  --startup S         Extra time whenever a bot is (re)started (default 1)\n"
+                  << "  --cpu-limit S       CPU-time cap per bot process\n"
+                  << "  --memory-limit MB   Address-space cap per bot process\n"
+                  << "  --transcript FILE   Full transcript; FILE.N per game when playing several\n"
+                  << "  --help, -h          Show this help message\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+#ifndef _WIN32
+    // A bot that dies mid-write must show up as a failed write, not kill us
+    signal(SIGPIPE, SIG_IGN);
+#endif
+    try {
+        BotzoneJudge::BotSpec bots[2];
+        BotzoneJudge::Options options;
+        int games = 2;
+        std::string transcript;
+        int positional = 0;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--games") {
+                games = std::stoi(value());
+            } else if (arg == "--json-a") {
+                bots[0].protocol = BotzoneJudge::Protocol::JSON;
+            } else if (arg == "--json-b") {
+                bots[1].protocol = BotzoneJudge::Protocol::JSON;
+            } else if (arg == "--time") {
+                options.turnSeconds = std::stod(value());
+            } else if (arg == "--startup") {
+                options.startupSeconds = std::stod(value());
+            } else if (arg == "--cpu-limit") {
+                options.limits.cpuSeconds = std::stod(value());
+            } else if (arg == "--memory-limit") {
+                options.limits.memoryBytes = std::stoull(value()) * 1024 * 1024;
+            } else if (arg == "--transcript") {
+                transcript = value();
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else if (!arg.empty() && arg[0] == '-') {
+                throw std::invalid_argument("Unknown option " + arg);
+            } else if (positional < 2) {
+                bots[positional++].path = arg;
+            } else {
+                throw std::invalid_argument("Too many bots: " + arg);
+            }
+        }
+        if (positional < 2 || games < 1) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        int wins[2] = {0, 0};
+        double wall[2] = {0.0, 0.0};
+        double cpu[2] = {0.0, 0.0};
+        int turns[2] = {0, 0};
+        for (int game = 0; game < games; ++game) {
+            const int black = game % 2;
+            options.black = bots[black];
+            options.white = bots[1 - black];
+            if (!transcript.empty()) {
+                options.transcriptPath = games > 1 ? transcript + "." + std::to_string(game + 1) : transcript;
+            }
+            BotzoneJudge::Result result = BotzoneJudge::play(options);
+
+            for (const auto& turn : result.turns) {
+                int bot = (turn.player == Player::BLACK) == (black == 0) ? 0 : 1;
+                wall[bot] += turn.wallSeconds;
+                cpu[bot] += turn.cpuSeconds;
+                turns[bot]++;
+            }
+            int winner = (result.winner == Player::BLACK) == (black == 0) ? 0 : 1;
+            wins[winner]++;
+            std::cout << "Game " << game + 1 << ": " << bots[winner].path << " wins as "
+                      << playerToString(result.winner) << " (" << BotServer::reasonName(result.reason) << ", "
+                      << result.moves.size() << " plies)\n";
+        }
+
+        std::cout << "\n" << std::fixed << std::setprecision(3);
+        for (int bot = 0; bot < 2; ++bot) {
+            std::cout << wins[bot] << " / " << games << "  " << bots[bot].path << "  ("
+                      << BotzoneJudge::protocolName(bots[bot].protocol) << ", avg wall "
+                      << (turns[bot] ? wall[bot] / turns[bot] : 0.0) << " s, avg cpu "
+                      << (turns[bot] ? cpu[bot] / turns[bot] : 0.0) << " s per move)\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,127 @@
+#include "ai/Match.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " --engine1 SPEC --engine2 SPEC [options]\n"
+                  << "Plays engine1 against engine2 with alternating colours and reports Elo of engine1.\n"
+                  << "Engine specs: basic | random[:seed=N] |\n"
+                  << "  mcts[:time=S,playouts=N,threads=N,rule=uct|puct,c=X,widening=X,reuse=0|1,seed=N]\n"
+                  << "Options:\n"
+                  << "  --games N           Number of games (default 100)\n"
+                  << "  --concurrency N     Games played at once (default: all cores)\n"
+                  << "  --openings FILE     Opening suite, one line of ';'-separated moves per opening\n"
+                  << "  --sprt ELO0,ELO1    Stop early once the SPRT accepts H0 (elo0) or H1 (elo1)\n"
+                  << "  --alpha X           SPRT type I error (default 0.05)\n"
+                  << "  --beta X            SPRT type II error (default 0.05)\n"
+                  << "  --help, -h          Show this help message\n";
+    }
+
+    std::string formatElo(double elo, double error) {
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(1) << elo << " +/- ";
+        if (std::isinf(error)) {
+            out << "inf";
+        } else {
+            out << error;
+        }
+        return out.str();
+    }
+
+    void printSummary(const Match::Result& result) {
+        std::cout << "Games " << result.games << ": " << result.winsA << " - " << result.winsB
+                  << "  Elo " << formatElo(result.elo, result.eloError)
+                  << "  LLR " << std::fixed << std::setprecision(2) << result.llr
+                  << " [" << result.lowerBound << ", " << result.upperBound << "]"
+                  << "  " << std::setprecision(1) << result.elapsedSeconds << " s\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        Match::Options options;
+        options.concurrency = std::max(1u, std::thread::hardware_concurrency());
+        std::string openingsPath;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--engine1") {
+                options.engineA = value();
+            } else if (arg == "--engine2") {
+                options.engineB = value();
+            } else if (arg == "--games") {
+                options.games = std::stoi(value());
+            } else if (arg == "--concurrency") {
+                options.concurrency = static_cast<unsigned>(std::stoul(value()));
+            } else if (arg == "--openings") {
+                openingsPath = value();
+            } else if (arg == "--sprt") {
+                std::string bounds = value();
+                size_t comma = bounds.find(',');
+                if (comma == std::string::npos) {
+                    throw std::invalid_argument("--sprt needs ELO0,ELO1");
+                }
+                options.sprt = true;
+                options.elo0 = std::stod(bounds.substr(0, comma));
+                options.elo1 = std::stod(bounds.substr(comma + 1));
+            } else if (arg == "--alpha") {
+                options.alpha = std::stod(value());
+            } else if (arg == "--beta") {
+                options.beta = std::stod(value());
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+        if (options.engineA.empty() || options.engineB.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        if (!openingsPath.empty()) {
+            options.openings = Match::loadOpenings(openingsPath);
+        }
+
+        std::cout << options.engineA << " vs " << options.engineB << ", " << options.games << " games, "
+                  << options.concurrency << " concurrent\n";
+        const int reportEvery = std::max(1, options.games / 20);
+        Match::Result result = Match::run(options, [&](const Match::Result& progress) {
+            if (progress.games % reportEvery == 0) {
+                printSummary(progress);
+            }
+        });
+
+        std::cout << "\nFinal\n";
+        printSummary(result);
+        if (result.illegalMoves > 0) {
+            std::cout << "Games lost on illegal moves: " << result.illegalMoves << "\n";
+        }
+        if (options.sprt) {
+            switch (result.sprtOutcome) {
+                case Match::SprtOutcome::ACCEPT_H1: std::cout << "SPRT: H1 accepted (engine1 is stronger)\n"; break;
+                case Match::SprtOutcome::ACCEPT_H0: std::cout << "SPRT: H0 accepted\n"; break;
+                case Match::SprtOutcome::CONTINUE: std::cout << "SPRT: inconclusive\n"; break;
+            }
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
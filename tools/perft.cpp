@@ -0,0 +1,174 @@
+#include "core/FastBoard.hpp"
+#include "core/Perft.hpp"
+#include "core/PositionNotation.hpp"
+#include "utils/Serializer.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "Counts leaf positions to a fixed depth to verify and time move generation.\n"
+                  << "Options:\n"
+                  << "  --depth N, -d N     Search depth (default 2)\n"
+                  << "  --threads N, -j N   Split root moves over N threads (default: all cores)\n"
+                  << "  --divide            Print the count below every root move\n"
+                  << "  --no-bulk           Make every last-ply move instead of counting them\n"
+                  << "  --position TEXT     Start from a position in notation, e.g.\n"
+                  << "                      \"2B2W2/8/B6W/8/8/B6W/8/2B2W2 b 1\"\n"
+                  << "  --load NAME         Start from a saved game\n"
+                  << "  --suite FILE        Count every position in FILE, one per line in notation\n"
+                  << "  --help, -h          Show this help message\n"
+                  << "Without --position, --load or --suite the standard position is used and the count is\n"
+                  << "checked against the stored reference; a mismatch exits with status 2.\n";
+    }
+
+    // Positions of a suite file; blank lines and lines starting with # are skipped
+    std::vector<FastBoard> readSuite(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Could not open " + path);
+        }
+        std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        std::vector<FastBoard> positions;
+        std::string_view rest(content);
+        int lineNumber = 0;
+        while (!rest.empty()) {
+            size_t end = rest.find('\n');
+            std::string_view line = rest.substr(0, end);
+            rest = end == std::string_view::npos ? std::string_view() : rest.substr(end + 1);
+            ++lineNumber;
+            if (line.empty() || line[0] == '#' || line == "\r") {
+                continue;
+            }
+            FastBoard board;
+            int turn;
+            if (!PositionNotation::tryParse(line, board, turn)) {
+                // Parse again for the reason; only on the error path
+                try {
+                    PositionNotation::parse(line);
+                } catch (const std::invalid_argument& e) {
+                    throw std::invalid_argument(path + ":" + std::to_string(lineNumber) + ": " + e.what());
+                }
+            }
+            positions.push_back(board);
+        }
+        return positions;
+    }
+
+    std::string squareName(int square) {
+        return std::to_string(square / Board::SIZE) + std::to_string(square % Board::SIZE);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        Perft::Options options;
+        options.depth = 2;
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+        std::string positionText;
+        std::string loadName;
+        std::string suitePath;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--depth" || arg == "-d") {
+                options.depth = std::stoi(value());
+            } else if (arg == "--threads" || arg == "-j") {
+                options.threads = static_cast<unsigned>(std::stoul(value()));
+            } else if (arg == "--divide") {
+                options.divide = true;
+            } else if (arg == "--no-bulk") {
+                options.bulk = false;
+            } else if (arg == "--position") {
+                positionText = value();
+            } else if (arg == "--load") {
+                loadName = value();
+            } else if (arg == "--suite") {
+                suitePath = value();
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+
+        if (!suitePath.empty()) {
+            auto start = std::chrono::steady_clock::now();
+            std::vector<FastBoard> positions = readSuite(suitePath);
+            double loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            Perft::Options each = options;
+            each.divide = false;
+            uint64_t nodes = 0;
+            double seconds = 0.0;
+            for (const FastBoard& position : positions) {
+                Perft::Result result = Perft::run(position, each);
+                nodes += result.nodes;
+                seconds += result.elapsedSeconds;
+            }
+            std::cout << positions.size() << " positions loaded in " << std::fixed << std::setprecision(3)
+                      << loadSeconds << " s\n"
+                      << "Depth " << options.depth << ": " << nodes << " nodes in " << seconds << " s\n";
+            return 0;
+        }
+
+        FastBoard board = FastBoard::standardPosition();
+        bool standard = true;
+        if (!positionText.empty()) {
+            board = PositionNotation::parse(positionText);
+            standard = false;
+        } else if (!loadName.empty()) {
+            auto loaded = Serializer().loadGame(loadName);
+            if (!loaded) {
+                throw std::runtime_error("Could not load saved game " + loadName);
+            }
+            board = FastBoard::fromGameState(*loaded);
+            standard = false;
+        }
+
+        Perft::Result result = Perft::run(board, options);
+
+        if (options.divide) {
+            for (const auto& entry : result.divide) {
+                std::cout << squareName(entry.move.from) << "-" << squareName(entry.move.to) << "/"
+                          << squareName(entry.move.arrow) << ": " << entry.nodes << "\n";
+            }
+            std::cout << "\nMoves: " << result.divide.size() << "\n";
+        }
+        std::cout << "Depth " << options.depth << ": " << result.nodes << " nodes in "
+                  << std::fixed << std::setprecision(3) << result.elapsedSeconds << " s ("
+                  << std::setprecision(0) << result.nodesPerSecond << " nodes/s, "
+                  << (options.bulk ? "bulk" : "no bulk") << ", " << options.threads << " threads)\n";
+
+        uint64_t expected = standard ? Perft::referenceCount(options.depth) : 0;
+        if (expected != 0) {
+            if (result.nodes != expected) {
+                std::cout << "MISMATCH: expected " << expected << "\n";
+                return 2;
+            }
+            std::cout << "Matches reference count\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
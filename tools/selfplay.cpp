@@ -0,0 +1,108 @@
+#include "ai/SelfPlay.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace amazons;
+
+namespace {
+    void printUsage(const char* program) {
+        std::cout << "Usage: " << program << " --output FILE [options]\n"
+                  << "Lets an engine play itself and writes every searched position with its\n"
+                  << "search value and the final result as fixed-size binary training records.\n"
+                  << "Options:\n"
+                  << "  --engine SPEC       Engine spec as for amazons_match (default mcts:time=0,playouts=2000)\n"
+                  << "  --games N           Number of games (default 100)\n"
+                  << "  --threads N         Games played at once (default: all cores)\n"
+                  << "  --random-plies N    Random opening moves per game, not recorded (default 4)\n"
+                  << "  --seed N            Seed for the opening moves (default: from the clock)\n"
+                  << "  --archive FILE      Also keep the whole games in a compressed game archive\n"
+                  << "  --help, -h          Show this help message\n";
+    }
+
+    void printProgress(const SelfPlay::Stats& stats) {
+        std::cout << "Games " << stats.games << "  positions " << stats.positions
+                  << "  " << std::fixed << std::setprecision(1) << stats.elapsedSeconds << " s";
+        if (stats.elapsedSeconds > 0.0) {
+            std::cout << "  (" << std::setprecision(0) << stats.positions / stats.elapsedSeconds << " pos/s)";
+        }
+        std::cout << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        SelfPlay::Options options;
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+        std::string outputPath;
+        std::string archivePath;
+
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            auto value = [&]() -> std::string {
+                if (i + 1 >= argc) {
+                    throw std::invalid_argument(arg + " needs a value");
+                }
+                return argv[++i];
+            };
+            if (arg == "--output" || arg == "-o") {
+                outputPath = value();
+            } else if (arg == "--engine") {
+                options.engine = value();
+            } else if (arg == "--games") {
+                options.games = std::stoi(value());
+            } else if (arg == "--threads" || arg == "-j") {
+                options.threads = static_cast<unsigned>(std::stoul(value()));
+            } else if (arg == "--random-plies") {
+                options.randomPlies = std::stoi(value());
+            } else if (arg == "--seed") {
+                options.seed = std::stoull(value());
+            } else if (arg == "--archive") {
+                archivePath = value();
+            } else if (arg == "--help" || arg == "-h") {
+                printUsage(argv[0]);
+                return 0;
+            } else {
+                throw std::invalid_argument("Unknown option " + arg);
+            }
+        }
+        if (outputPath.empty()) {
+            printUsage(argv[0]);
+            return 1;
+        }
+
+        std::cout << options.engine << ", " << options.games << " games, "
+                  << options.threads << " threads -> " << outputPath << "\n";
+        TrainingDataWriter writer(outputPath);
+        std::unique_ptr<GameArchive::Writer> archive;
+        if (!archivePath.empty()) {
+            archive = std::make_unique<GameArchive::Writer>(archivePath);
+            options.archive = archive.get();
+        }
+        const int reportEvery = std::max(1, options.games / 20);
+        SelfPlay::Stats stats = SelfPlay::run(options, writer, [&](const SelfPlay::Stats& progress) {
+            if (progress.games % reportEvery == 0) {
+                printProgress(progress);
+            }
+        });
+        writer.close();
+        if (archive) {
+            archive->close();
+        }
+
+        std::cout << "\nFinal\n";
+        printProgress(stats);
+        std::cout << "Records written: " << writer.recordsWritten() << "\n";
+        if (archive) {
+            std::cout << "Games archived: " << archive->gameCount() << " in " << archive->bytesWritten() << " bytes\n";
+        }
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}